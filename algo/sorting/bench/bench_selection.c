@@ -0,0 +1,76 @@
+#include "sorting.h"
+
+#include <time.h>
+#include <string.h>
+
+/*
+  Compare selection (nth element, partial sort, streaming top k) against
+  fully sorting the array with intro sort, on random input.
+
+  usage :- bench_selection [size]     ; default size is 1e7
+*/
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+int main(int argc, char *argv[]) {
+  int size = argc > 1 ? atoi(argv[1]) : 10000000;
+
+  int *src = malloc(size * sizeof(int));
+  int *arr = malloc(size * sizeof(int));
+  if (!src || !arr) return 1;
+
+  srand(42);
+  for (int i = 0; i < size; i++) src[i] = rand();
+
+  printf("%-22s %10s %16s %12s\n", "operation", "k", "comparisons", "ms");
+
+  // full sort is the baseline
+  memcpy(arr, src, size * sizeof(int));
+  memset(&s_stats, 0, sizeof(s_stats));
+  double start = now_sec();
+  s_intro_sort(arr, size);
+  printf("%-22s %10s %16llu %12.2f\n", "full sort (intro)", "-",
+         s_stats.comparisons, (now_sec() - start) * 1e3);
+
+  memcpy(arr, src, size * sizeof(int));
+  memset(&s_stats, 0, sizeof(s_stats));
+  start = now_sec();
+  s_nth_element(arr, size, size / 2);
+  printf("%-22s %10d %16llu %12.2f\n", "nth element (median)", size / 2,
+         s_stats.comparisons, (now_sec() - start) * 1e3);
+
+  int ks[] = {10, 1000, 100000};
+  int *out = malloc(100000 * sizeof(int));
+  if (!out) return 1;
+
+  for (int t = 0; t < 3; t++) {
+    int k = ks[t] < size ? ks[t] : size;
+
+    memcpy(arr, src, size * sizeof(int));
+    memset(&s_stats, 0, sizeof(s_stats));
+    start = now_sec();
+    s_partial_sort(arr, size, k);
+    printf("%-22s %10d %16llu %12.2f\n", "partial sort", k,
+           s_stats.comparisons, (now_sec() - start) * 1e3);
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    start = now_sec();
+    s_topk_t *tk = s_topk_init(k);
+    for (int i = 0; i < size; i++) s_topk_push(tk, src[i]);
+    s_topk_result(tk, out);
+    s_topk_free(tk);
+    printf("%-22s %10d %16llu %12.2f\n", "streaming top k", k,
+           s_stats.comparisons, (now_sec() - start) * 1e3);
+  }
+
+  free(out);
+  free(src);
+  free(arr);
+  return 0;
+}
@@ -0,0 +1,62 @@
+#include "sorting.h"
+
+#include <time.h>
+#include <string.h>
+
+/*
+  Compare the shell sort gap sequences on random input.
+  usage :- bench_shell_gaps [max size]     ; default max size is 1e7
+*/
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+int main(int argc, char *argv[]) {
+  int max_size = argc > 1 ? atoi(argv[1]) : 10000000;
+
+  const char *names[] = {"ciura", "tokuda", "sedgewick", "pratt"};
+  shell_gap_t seqs[] = {
+    SHELL_GAP_CIURA, SHELL_GAP_TOKUDA, SHELL_GAP_SEDGEWICK, SHELL_GAP_PRATT
+  };
+
+  int *src = malloc(max_size * sizeof(int));
+  int *arr = malloc(max_size * sizeof(int));
+  if (!src || !arr) return 1;
+
+  srand(42);
+  for (int i = 0; i < max_size; i++) src[i] = rand();
+
+  printf("%-10s %10s %16s %14s %12s\n", "gaps", "size", "comparisons", "cmp/(N lg N)", "seconds");
+
+  for (int size = 10000; size <= max_size; size *= 10) {
+    for (int s = 0; s < 4; s++) {
+      memcpy(arr, src, size * sizeof(int));
+      memset(&s_stats, 0, sizeof(s_stats));
+
+      double start = now_sec();
+      s_shell_sort_gaps(arr, size, seqs[s]);
+      double elapsed = now_sec() - start;
+
+      // make sure the run actually sorted the array
+      for (int i = 1; i < size; i++) {
+        if (arr[i - 1] > arr[i]) {
+          printf("%s: not sorted at %d\n", names[s], i);
+          return 1;
+        }
+      }
+
+      double nlogn = size * (31 - __builtin_clz(size));
+      printf("%-10s %10d %16llu %14.2f %12.4f\n", names[s], size,
+             s_stats.comparisons, s_stats.comparisons / nlogn, elapsed);
+    }
+  }
+
+  free(src);
+  free(arr);
+  return 0;
+}
@@ -0,0 +1,281 @@
+#include "sorting.h"
+
+#include <time.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define READ_CYCLES() __rdtsc()
+#else
+  #define READ_CYCLES() 0ULL
+#endif
+
+/*
+  Run every sort over the standard input distributions and print the
+  results as CSV, so that runs from different commits can be diffed.
+
+  usage :- bench_sorting [max size]     ; default max size is 1e6
+
+  - comparisons and swaps are per run
+  - the parallel sort counts only the work done on the calling thread
+  - compare-exchanges inside the SIMD sorting network are not counted
+  - generic sorts (s_qsort and libc qsort) are run on 4, 8 and 16 byte
+    elements built from the same input
+*/
+
+#define QUADRATIC_MAX 10000    // O(N^2) sorts are not run beyond this size
+
+
+typedef struct {
+  const char *name;
+  void (*sort)(int *, int);
+  int max_size;
+} bench_sort_t;
+
+
+typedef enum {
+  RANDOM, SORTED, REVERSE, NEARLY_SORTED, FEW_UNIQUE, ORGAN_PIPE, INPUT_COUNT
+} input_t;
+
+static const char *INPUT_NAMES[] = {
+  "random", "sorted", "reverse", "nearly_sorted", "few_unique", "organ_pipe"
+};
+
+
+
+/* 16 byte record for the generic sorts */
+typedef struct { long key; long payload; } record_t;
+
+typedef struct {
+  const char *name;
+  size_t size;
+  int (*cmp)(const void *, const void *);
+} bench_elem_t;
+
+static int cmp_int(const void *a, const void *b) {
+  s_stats.comparisons++;
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_double(const void *a, const void *b) {
+  s_stats.comparisons++;
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_record(const void *a, const void *b) {
+  s_stats.comparisons++;
+  long x = ((const record_t *)a)->key, y = ((const record_t *)b)->key;
+  return (x > y) - (x < y);
+}
+
+
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+static void fill_input(int *arr, int size, input_t input) {
+  switch (input) {
+    case RANDOM:
+      for (int i = 0; i < size; i++) arr[i] = rand();
+      break;
+
+    case SORTED:
+      for (int i = 0; i < size; i++) arr[i] = i;
+      break;
+
+    case REVERSE:
+      for (int i = 0; i < size; i++) arr[i] = size - i;
+      break;
+
+    case NEARLY_SORTED:
+      // sorted, with 1% of the elements swapped at random
+      for (int i = 0; i < size; i++) arr[i] = i;
+      for (int i = 0; i < size / 100 + 1; i++) {
+        int a = rand() % size, b = rand() % size;
+        int tmp = arr[a];
+        arr[a] = arr[b];
+        arr[b] = tmp;
+      }
+      break;
+
+    case FEW_UNIQUE:
+      for (int i = 0; i < size; i++) arr[i] = rand() % 16;
+      break;
+
+    case ORGAN_PIPE:
+      // ascending till the middle, then descending
+      for (int i = 0; i < size; i++) arr[i] = i < size / 2 ? i : size - i;
+      break;
+
+    default:
+      break;
+  }
+}
+
+
+
+static bool is_sorted(const int *arr, int size) {
+  for (int i = 1; i < size; i++)
+    if (arr[i - 1] > arr[i]) return false;
+  return true;
+}
+
+
+
+/* widen the int input to the element type of the generic sort */
+static void fill_elems(void *dst, const int *src, int size, size_t elem_size) {
+  for (int i = 0; i < size; i++) {
+    switch (elem_size) {
+      case sizeof(int): ((int *)dst)[i] = src[i]; break;
+      case sizeof(double): ((double *)dst)[i] = src[i]; break;
+      default: ((record_t *)dst)[i] = (record_t){ src[i], i }; break;
+    }
+  }
+}
+
+
+
+/* sorted as per the comparator of the element */
+static bool is_sorted_elems(const bench_elem_t *elem, const void *arr, int size) {
+  const char *p = arr;
+
+  for (int i = 1; i < size; i++, p += elem->size)
+    if (elem->cmp(p, p + elem->size) > 0) return false;
+  return true;
+}
+
+
+
+static bool bench_generic(const char *name, void (*sort)(void *, size_t, size_t, s_cmp_t),
+                          const bench_elem_t *elem, const void *src, void *arr,
+                          int size, const char *input) {
+  int reps = size < 100000 ? 100000 / size : 1;
+  double elapsed = 0;
+  unsigned long long cycles = 0;
+
+  memset(&s_stats, 0, sizeof(s_stats));
+
+  for (int r = 0; r < reps; r++) {
+    memcpy(arr, src, size * elem->size);
+
+    double start = now_sec();
+    unsigned long long c0 = READ_CYCLES();
+    sort(arr, size, elem->size, elem->cmp);
+    cycles += READ_CYCLES() - c0;
+    elapsed += now_sec() - start;
+  }
+
+  // check goes through the counting comparator, so keep the counts first
+  sort_stats_t stats = s_stats;
+
+  if (!is_sorted_elems(elem, arr, size)) {
+    fprintf(stderr, "%s failed on %s %s input\n", name, elem->name, input);
+    return false;
+  }
+
+  printf("%s_%s,%s,%d,%.3f,%llu,%llu,%llu\n", name, elem->name, input, size,
+         elapsed * 1e9 / ((double)size * reps),
+         stats.comparisons / reps, stats.swaps / reps, cycles / reps);
+  return true;
+}
+
+
+
+
+int main(int argc, char *argv[]) {
+  int max_size = argc > 1 ? atoi(argv[1]) : 1000000;
+
+  bench_sort_t sorts[] = {
+    {"selection",      s_selection_sort,      QUADRATIC_MAX},
+    {"bubble",         s_bubble_sort,         QUADRATIC_MAX},
+    {"insertion",      s_insertion_sort,      QUADRATIC_MAX},
+    {"shell",          s_shell_sort,          max_size},
+    {"intro",          s_intro_sort,          max_size},
+    {"parallel_merge", s_parallel_merge_sort, max_size},
+    {"radix",          s_radix_sort,          max_size},
+    {"tim",            s_tim_sort,            max_size},
+  };
+  int sort_count = sizeof(sorts) / sizeof(sorts[0]);
+
+  int *src = malloc(max_size * sizeof(int));
+  int *arr = malloc(max_size * sizeof(int));
+  if (!src || !arr) return 1;
+
+  printf("sort,input,size,ns_per_elem,comparisons,swaps,cycles\n");
+
+  for (int size = 1000; size <= max_size; size *= 10) {
+    for (input_t input = 0; input < INPUT_COUNT; input++) {
+      srand(42);
+      fill_input(src, size, input);
+
+      for (int s = 0; s < sort_count; s++) {
+        if (size > sorts[s].max_size) continue;
+
+        // repeat the small sizes, so that the timer resolution doesn't matter
+        int reps = size < 100000 ? 100000 / size : 1;
+        double elapsed = 0;
+        unsigned long long cycles = 0;
+
+        memset(&s_stats, 0, sizeof(s_stats));
+
+        for (int r = 0; r < reps; r++) {
+          memcpy(arr, src, size * sizeof(int));
+
+          double start = now_sec();
+          unsigned long long c0 = READ_CYCLES();
+          sorts[s].sort(arr, size);
+          cycles += READ_CYCLES() - c0;
+          elapsed += now_sec() - start;
+        }
+
+        if (!is_sorted(arr, size)) {
+          fprintf(stderr, "%s failed on %s input\n", sorts[s].name, INPUT_NAMES[input]);
+          return 1;
+        }
+
+        printf("%s,%s,%d,%.3f,%llu,%llu,%llu\n", sorts[s].name, INPUT_NAMES[input],
+               size, elapsed * 1e9 / ((double)size * reps),
+               s_stats.comparisons / reps, s_stats.swaps / reps, cycles / reps);
+      }
+    }
+  }
+
+  // generic sorts against libc's qsort
+  bench_elem_t elems[] = {
+    {"int",    sizeof(int),      cmp_int},
+    {"double", sizeof(double),   cmp_double},
+    {"record", sizeof(record_t), cmp_record},
+  };
+
+  void *gsrc = malloc(max_size * sizeof(record_t));
+  void *garr = malloc(max_size * sizeof(record_t));
+  if (!gsrc || !garr) return 1;
+
+  for (int size = 1000; size <= max_size; size *= 10) {
+    for (input_t input = 0; input < INPUT_COUNT; input++) {
+      srand(42);
+      fill_input(src, size, input);
+
+      for (int e = 0; e < 3; e++) {
+        fill_elems(gsrc, src, size, elems[e].size);
+
+        if (!bench_generic("s_qsort", s_qsort, &elems[e], gsrc, garr, size, INPUT_NAMES[input]) ||
+            !bench_generic("qsort", qsort, &elems[e], gsrc, garr, size, INPUT_NAMES[input]))
+          return 1;
+      }
+    }
+  }
+
+  free(gsrc);
+  free(garr);
+  free(src);
+  free(arr);
+  return 0;
+}
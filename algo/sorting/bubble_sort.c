@@ -11,7 +11,8 @@ void s_bubble_sort(int *arr, int size) {
     // size - i     : for every outer loop we reduce the inner loop by one 
     // size - i - 1 : make sure no out of bound idexing happens
     for (int j = 0; j < size - i - 1; j++) {
-      if (arr[j] > arr[j + 1]) {
+      if (S_LESS(arr[j + 1], arr[j])) {
+        S_SWAP();
         tmp_swp = arr[j];
         arr[j] = arr[j + 1];
         arr[j + 1] = tmp_swp;
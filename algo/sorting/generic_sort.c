@@ -0,0 +1,364 @@
+#include "sorting.h"
+
+#include <string.h>
+#include <stdint.h>
+
+// partitions with fewer elements than this are handed to insertion sort
+#define GENERIC_THRESHOLD 12
+
+// partitions larger than this take the pivot from tukey's ninther
+#define GENERIC_NINTHER 128
+
+// partial insertion sort gives up, after moving these many elements
+#define GENERIC_PARTIAL_LIMIT 8
+
+// enough for the pending partitions, as the smaller side is always done first
+#define GENERIC_STACK 64
+
+#define ALWAYS_INLINE static inline __attribute__((always_inline))
+
+
+/* pending partition on the explicit stack */
+typedef struct {
+  char *base;
+  size_t count;
+  int depth;
+} partition_t;
+
+
+
+/* ---------- SIZE SPECIALIZED SWAPS ---------- */
+
+ALWAYS_INLINE void swap4(char *a, char *b) {
+  uint32_t tmp;
+  memcpy(&tmp, a, 4);
+  memcpy(a, b, 4);
+  memcpy(b, &tmp, 4);
+}
+
+ALWAYS_INLINE void swap8(char *a, char *b) {
+  uint64_t tmp;
+  memcpy(&tmp, a, 8);
+  memcpy(a, b, 8);
+  memcpy(b, &tmp, 8);
+}
+
+ALWAYS_INLINE void swap16(char *a, char *b) {
+  uint64_t tmp[2];
+  memcpy(tmp, a, 16);
+  memcpy(a, b, 16);
+  memcpy(b, tmp, 16);
+}
+
+static void swap_bytes(char *a, char *b, size_t size) {
+  uint64_t tmp;
+
+  // swap in 8 byte chunks, then the remaining bytes one at a time
+  for (; size >= 8; size -= 8, a += 8, b += 8) {
+    memcpy(&tmp, a, 8);
+    memcpy(a, b, 8);
+    memcpy(b, &tmp, 8);
+  }
+
+  for (; size > 0; size--, a++, b++) {
+    char c = *a;
+    *a = *b;
+    *b = c;
+  }
+}
+
+/* size is a constant wherever this gets inlined, so the switch folds away */
+ALWAYS_INLINE void swap_elem(char *a, char *b, size_t size) {
+  S_SWAP();
+
+  switch (size) {
+    case 4:  swap4(a, b); break;
+    case 8:  swap8(a, b); break;
+    case 16: swap16(a, b); break;
+    default: swap_bytes(a, b, size); break;
+  }
+}
+
+
+
+/* ---------- SORT KERNELS ---------- */
+
+/* either the qsort style comparator or the one with context is set */
+#define CMP(a, b) (cmp_r ? cmp_r((a), (b), ctx) : cmp((a), (b)))
+
+
+ALWAYS_INLINE void insertion_sort(char *base, size_t count, size_t size,
+                                  s_cmp_t cmp, s_cmp_r_t cmp_r, void *ctx) {
+  for (size_t i = 1; i < count; i++) {
+    // move the element left, till it's not smaller than its neighbour
+    for (char *p = base + i * size; p > base && CMP(p - size, p) > 0; p -= size)
+      swap_elem(p - size, p, size);
+  }
+}
+
+
+
+/* insertion sort that gives up once too many elements have to be moved,
+   returns true if the range got sorted */
+ALWAYS_INLINE bool partial_insertion_sort(char *base, size_t count, size_t size,
+                                          s_cmp_t cmp, s_cmp_r_t cmp_r, void *ctx) {
+  int moved = 0;
+
+  for (size_t i = 1; i < count; i++) {
+    char *p = base + i * size;
+    if (CMP(p - size, p) <= 0) continue;
+
+    if (++moved > GENERIC_PARTIAL_LIMIT) return false;
+
+    for (; p > base && CMP(p - size, p) > 0; p -= size)
+      swap_elem(p - size, p, size);
+  }
+  return true;
+}
+
+
+
+ALWAYS_INLINE void sift_down(char *base, size_t root, size_t count, size_t size,
+                             s_cmp_t cmp, s_cmp_r_t cmp_r, void *ctx) {
+  while (2 * root + 1 < count) {
+    size_t child = 2 * root + 1;
+    if (child + 1 < count && CMP(base + child * size, base + (child + 1) * size) < 0)
+      child++;
+
+    if (CMP(base + root * size, base + child * size) >= 0) break;
+
+    swap_elem(base + root * size, base + child * size, size);
+    root = child;
+  }
+}
+
+
+
+ALWAYS_INLINE void heap_sort(char *base, size_t count, size_t size,
+                             s_cmp_t cmp, s_cmp_r_t cmp_r, void *ctx) {
+  for (size_t i = count / 2; i-- > 0; )
+    sift_down(base, i, count, size, cmp, cmp_r, ctx);
+
+  for (size_t i = count - 1; i > 0; i--) {
+    swap_elem(base, base + i * size, size);
+    sift_down(base, 0, i, size, cmp, cmp_r, ctx);
+  }
+}
+
+
+
+/* order the three elements in place */
+ALWAYS_INLINE void sort3(char *a, char *b, char *c, size_t size,
+                         s_cmp_t cmp, s_cmp_r_t cmp_r, void *ctx) {
+  if (CMP(b, a) < 0) swap_elem(a, b, size);
+  if (CMP(c, b) < 0) swap_elem(b, c, size);
+  if (CMP(b, a) < 0) swap_elem(a, b, size);
+}
+
+
+
+/* pivot is moved to the first position, partition around it and return the
+   final position of the pivot. is_partitioned is set, when the range was
+   already partitioned and nothing had to be swapped */
+ALWAYS_INLINE size_t partition(char *base, size_t count, size_t size, bool *is_partitioned,
+                               s_cmp_t cmp, s_cmp_r_t cmp_r, void *ctx) {
+  char *first = base;
+  char *mid = base + (count / 2) * size;
+  char *last = base + (count - 1) * size;
+
+  // on large partitions take the median of three medians (tukey's ninther),
+  // this keeps patterns like organ pipe from producing skewed partitions.
+  // the samples are ordered in place, which also helps presorted inputs
+  if (count > GENERIC_NINTHER) {
+    size_t step = (count / 8) * size;
+
+    sort3(first, first + step, first + 2 * step, size, cmp, cmp_r, ctx);
+    sort3(mid - step, mid, mid + step, size, cmp, cmp_r, ctx);
+    sort3(last - 2 * step, last - step, last, size, cmp, cmp_r, ctx);
+    sort3(first + step, mid, last - step, size, cmp, cmp_r, ctx);
+    swap_elem(first, mid, size);
+  } else {
+    sort3(mid, first, last, size, cmp, cmp_r, ctx);    // median lands on first
+  }
+
+  // pivot stays at first all through the scan, so it stops the right to left
+  // scan. left to right scan has to check the bound
+  char *i = first;
+  char *j = last + size;
+  *is_partitioned = true;
+
+  while (true) {
+    do i += size; while (i <= last && CMP(i, first) < 0);
+    do j -= size; while (CMP(first, j) < 0);
+
+    if (i >= j) break;
+
+    swap_elem(i, j, size);
+    *is_partitioned = false;
+  }
+
+  swap_elem(first, j, size);
+  return (size_t)(j - base) / size;
+}
+
+
+
+/* reverse the order of the elements in place */
+ALWAYS_INLINE void reverse(char *base, size_t count, size_t size) {
+  for (char *i = base, *j = base + (count - 1) * size; i < j; i += size, j -= size)
+    swap_elem(i, j, size);
+}
+
+
+
+/* length of the monotone run at the start of the range, descending is set
+   when the run is strictly descending */
+ALWAYS_INLINE size_t run_length(char *base, size_t count, size_t size, bool *descending,
+                                s_cmp_t cmp, s_cmp_r_t cmp_r, void *ctx) {
+  *descending = count > 1 && CMP(base + size, base) < 0;
+
+  size_t run = 2;
+  if (*descending) {
+    while (run < count && CMP(base + run * size, base + (run - 1) * size) < 0) run++;
+  } else {
+    while (run < count && CMP(base + run * size, base + (run - 1) * size) >= 0) run++;
+  }
+  return run < count ? run : count;
+}
+
+
+
+/* finish the range, when it is made of atmost 2 monotone runs (sorted,
+   reversed, organ pipe, ...). descending runs are reversed and the 2 runs
+   merged through a scratch copy of the first. returns false when the range
+   is not such, or the scratch couldn't be allocated */
+ALWAYS_INLINE bool sort_runs(char *base, size_t count, size_t size,
+                             s_cmp_t cmp, s_cmp_r_t cmp_r, void *ctx) {
+  bool desc1, desc2;
+
+  size_t n1 = run_length(base, count, size, &desc1, cmp, cmp_r, ctx);
+  if (n1 == count) {
+    if (desc1) reverse(base, count, size);
+    return true;
+  }
+
+  char *mid = base + n1 * size;
+  size_t n2 = run_length(mid, count - n1, size, &desc2, cmp, cmp_r, ctx);
+  if (n1 + n2 < count) return false;
+
+  if (desc1) reverse(base, n1, size);
+  if (desc2) reverse(mid, n2, size);
+
+  // runs are already in order
+  if (CMP(mid - size, mid) <= 0) return true;
+
+  char *tmp = malloc(n1 * size);
+  if (!tmp) return false;
+  memcpy(tmp, base, n1 * size);
+
+  // second run is merged in place, only the first needs the scratch
+  char *a = tmp, *a_end = tmp + n1 * size;
+  char *b = mid, *b_end = base + count * size;
+  char *out = base;
+
+  while (a < a_end && b < b_end) {
+    S_SWAP();
+
+    if (CMP(b, a) < 0) {
+      memcpy(out, b, size);
+      b += size;
+    } else {
+      memcpy(out, a, size);
+      a += size;
+    }
+    out += size;
+  }
+  memcpy(out, a, a_end - a);
+
+  free(tmp);
+  return true;
+}
+
+
+
+ALWAYS_INLINE void intro_sort(char *base, size_t count, size_t size,
+                              s_cmp_t cmp, s_cmp_r_t cmp_r, void *ctx) {
+  partition_t stack[GENERIC_STACK];
+  int top = 0;
+
+  // inputs of 1 or 2 runs take a reverse and a merge, on random input the
+  // scans stop after a couple of comparisons
+  if (sort_runs(base, count, size, cmp, cmp_r, ctx)) return;
+  // allow 2 * log2(N) levels of partitioning before switching to heap sort
+  int depth = 0;
+  for (size_t n = count; n > 1; n >>= 1) depth += 2;
+
+  stack[top++] = (partition_t){ base, count, depth };
+
+  while (top > 0) {
+    partition_t p = stack[--top];
+
+    while (p.count > GENERIC_THRESHOLD) {
+      if (p.depth == 0) {
+        heap_sort(p.base, p.count, size, cmp, cmp_r, ctx);
+        p.count = 0;
+        break;
+      }
+      p.depth--;
+
+      bool is_partitioned;
+      size_t pivot = partition(p.base, p.count, size, &is_partitioned, cmp, cmp_r, ctx);
+
+      partition_t left = { p.base, pivot, p.depth };
+      partition_t right = { p.base + (pivot + 1) * size, p.count - pivot - 1, p.depth };
+
+      // nothing moved, the range is likely presorted. try to finish both the
+      // sides with a few insertions, before partitioning them further
+      if (is_partitioned &&
+          partial_insertion_sort(left.base, left.count, size, cmp, cmp_r, ctx) &&
+          partial_insertion_sort(right.base, right.count, size, cmp, cmp_r, ctx)) {
+        p.count = 0;
+        break;
+      }
+
+      // defer the larger side and continue with the smaller one
+      if (left.count < right.count) {
+        stack[top++] = right;
+        p = left;
+      } else {
+        stack[top++] = left;
+        p = right;
+      }
+    }
+
+    insertion_sort(p.base, p.count, size, cmp, cmp_r, ctx);
+  }
+}
+
+
+/* every element size gets its own copy of the kernels */
+#define DISPATCH(cmp, cmp_r)                                                   \
+  switch (size) {                                                              \
+    case 4:  intro_sort(base, count, 4, cmp, cmp_r, ctx); break;               \
+    case 8:  intro_sort(base, count, 8, cmp, cmp_r, ctx); break;               \
+    case 16: intro_sort(base, count, 16, cmp, cmp_r, ctx); break;              \
+    default: intro_sort(base, count, size, cmp, cmp_r, ctx); break;            \
+  }
+
+
+
+
+void s_sort(void *base, size_t count, size_t size, s_cmp_r_t cmp_r, void *ctx) {
+  if (!base || !cmp_r || count <= 1 || size == 0) return;
+
+  DISPATCH(NULL, cmp_r);
+}
+
+
+
+void s_qsort(void *base, size_t count, size_t size, s_cmp_t cmp) {
+  if (!base || !cmp || count <= 1 || size == 0) return;
+
+  void *ctx = NULL;
+  DISPATCH(cmp, NULL);
+}
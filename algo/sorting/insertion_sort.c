@@ -18,8 +18,9 @@ void s_insertion_sort(int arr[], int size) {
     // iteration let's shift the elements to right (using above array's position
     // as temp variable) as these are larger than curr.
     int j = i - 1;
-    while (j >= 0 && curr < arr[j]) {
+    while (j >= 0 && S_LESS(curr, arr[j])) {
       arr[j + 1] = arr[j];
+      S_SWAP();
       j--;
     }
 
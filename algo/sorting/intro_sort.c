@@ -0,0 +1,121 @@
+#include "sorting.h"
+
+// partitions with fewer elements than this are handed to the sorting network
+#define INTRO_THRESHOLD 48
+
+
+static void swap_int(int *a, int *b) {
+  S_SWAP();
+
+  int tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
+
+
+
+static int floor_log2(int n) {
+  int log = 0;
+  while (n >>= 1) log++;
+  return log;
+}
+
+
+
+static void sift_down(int arr[], int root, int size) {
+  int curr = arr[root];
+
+  // keep moving the larger child up, till curr finds its position
+  while (2 * root + 1 < size) {
+    int child = 2 * root + 1;
+    if (child + 1 < size && S_LESS(arr[child], arr[child + 1])) child++;
+
+    if (!S_LESS(curr, arr[child])) break;
+
+    arr[root] = arr[child];
+    S_SWAP();
+    root = child;
+  }
+
+  arr[root] = curr;
+}
+
+
+
+static void heap_sort(int arr[], int size) {
+  // build the max heap, starting from the last parent node
+  for (int i = size / 2 - 1; i >= 0; i--)
+    sift_down(arr, i, size);
+
+  // move the max to the end and restore the heap on the remaining elements
+  for (int i = size - 1; i > 0; i--) {
+    swap_int(&arr[0], &arr[i]);
+    sift_down(arr, 0, i);
+  }
+}
+
+
+
+static int partition(int arr[], int size) {
+  int mid = size / 2;
+  int last = size - 1;
+
+  // median of three :- order first, mid and last, so the median sits at mid
+  if (S_LESS(arr[mid], arr[0])) swap_int(&arr[0], &arr[mid]);
+  if (S_LESS(arr[last], arr[0])) swap_int(&arr[0], &arr[last]);
+  if (S_LESS(arr[last], arr[mid])) swap_int(&arr[mid], &arr[last]);
+
+  int pivot = arr[mid];
+
+  // hoare partition :- move from both ends and swap the misplaced pair
+  int i = -1;
+  int j = size;
+
+  while (true) {
+    do i++; while (S_LESS(arr[i], pivot));
+    do j--; while (S_LESS(pivot, arr[j]));
+
+    if (i >= j) return j + 1;   // no of elements in the left partition
+
+    swap_int(&arr[i], &arr[j]);
+  }
+}
+
+
+
+static void intro_sort(int arr[], int size, int depth) {
+  while (size > INTRO_THRESHOLD) {
+    // quick sort is degrading on this input, fallback to heap sort
+    if (depth == 0) {
+      heap_sort(arr, size);
+      return;
+    }
+    depth--;
+
+    int left = partition(arr, size);
+
+    // recurse into the smaller partition and loop on the larger one, so the
+    // stack depth stays within O(log N)
+    if (left < size - left) {
+      intro_sort(arr, left, depth);
+      arr += left;
+      size -= left;
+    } else {
+      intro_sort(arr + left, size - left, depth);
+      size = left;
+    }
+  }
+
+  // small partitions are faster with the sorting network
+  s_sort_network(arr, size);
+}
+
+
+
+
+void s_intro_sort(int arr[], int size) {
+  if (!arr || size <= 1) return;
+
+  // allow 2 * log2(N) levels of partitioning before switching to heap sort
+  intro_sort(arr, size, 2 * floor_log2(size));
+}
@@ -0,0 +1,208 @@
+#include "sorting.h"
+
+// ranges with fewer elements than this are insertion sorted
+#define SELECT_THRESHOLD 16
+
+
+static void swap_int(int *a, int *b) {
+  S_SWAP();
+
+  int tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
+
+
+
+/* index of the median among first, mid and last */
+static int median_of_three(int arr[], int size) {
+  int a = 0, b = size / 2, c = size - 1;
+
+  if (S_LESS(arr[a], arr[b])) {
+    if (S_LESS(arr[b], arr[c])) return b;
+    return S_LESS(arr[a], arr[c]) ? c : a;
+  }
+
+  if (S_LESS(arr[a], arr[c])) return a;
+  return S_LESS(arr[b], arr[c]) ? c : b;
+}
+
+
+
+static void select_kth(int arr[], int size, int k);
+
+/* index of the median of medians (groups of 5). The pivot it gives is
+   guaranteed to have atleast 30% of the elements on either side */
+static int median_of_medians(int arr[], int size) {
+  int groups = 0;
+
+  // sort each group of 5 and move its median to the front
+  for (int i = 0; i < size; i += 5) {
+    int n = (size - i) < 5 ? (size - i) : 5;
+
+    s_insertion_sort(arr + i, n);
+    swap_int(&arr[groups++], &arr[i + n / 2]);
+  }
+
+  // median of the medians, with the linear time selection itself
+  select_kth(arr, groups, groups / 2);
+  return groups / 2;
+}
+
+
+
+/* hoare partition around the pivot at first position.
+   returns the no of elements in the left partition, which is in [1, size) */
+static int partition_first(int arr[], int size) {
+  int pivot = arr[0];
+  int i = -1, j = size;
+
+  while (true) {
+    do i++; while (S_LESS(arr[i], pivot));
+    do j--; while (S_LESS(pivot, arr[j]));
+
+    if (i >= j) return j + 1;
+
+    swap_int(&arr[i], &arr[j]);
+  }
+}
+
+
+
+/* quick select with median of three pivots. the range has to atleast halve
+   every 2 rounds, once it doesn't the rest of the pivots are picked by median
+   of medians. so the sizes partitioned shrink geometrically either way, which
+   bounds the worst case to O(N) */
+static void select_kth(int arr[], int size, int k) {
+  bool fast = true;
+  int mark = size;      // size of the range 2 rounds back
+  int round = 0;
+
+  while (size > SELECT_THRESHOLD) {
+    int pivot = fast ? median_of_three(arr, size) : median_of_medians(arr, size);
+
+    swap_int(&arr[0], &arr[pivot]);
+    int left = partition_first(arr, size);
+
+    // continue only in the partition that holds k
+    if (k < left) {
+      size = left;
+    } else {
+      arr += left;
+      size -= left;
+      k -= left;
+    }
+
+    // median of three is being beaten, don't trust it for this range anymore
+    if (fast && ++round == 2) {
+      if (size > mark / 2) fast = false;
+      mark = size;
+      round = 0;
+    }
+  }
+
+  s_insertion_sort(arr, size);
+}
+
+
+
+
+void s_nth_element(int arr[], int size, int k) {
+  if (!arr || k < 0 || k >= size) return;
+
+  select_kth(arr, size, k);
+}
+
+
+
+void s_partial_sort(int arr[], int size, int k) {
+  if (!arr || k <= 0 || size <= 1) return;
+  if (k > size) k = size;
+
+  // bring the k smallest to the front, then sort only those
+  if (k < size) s_nth_element(arr, size, k - 1);
+  s_intro_sort(arr, k);
+}
+
+
+
+/* ---------- STREAMING TOP K ---------- */
+
+/* restore the max heap, from root downwards */
+static void topk_sift_down(int heap[], int size, int root) {
+  int curr = heap[root];
+
+  while (2 * root + 1 < size) {
+    int child = 2 * root + 1;
+    if (child + 1 < size && S_LESS(heap[child], heap[child + 1])) child++;
+
+    if (!S_LESS(curr, heap[child])) break;
+
+    heap[root] = heap[child];
+    root = child;
+  }
+  heap[root] = curr;
+}
+
+
+
+s_topk_t* s_topk_init(int k) {
+  if (k <= 0) return NULL;
+
+  s_topk_t *tk = malloc(sizeof(s_topk_t));
+  if (!tk) return NULL;
+
+  tk->heap = malloc(k * sizeof(int));
+  if (!tk->heap) {
+    free(tk);
+    return NULL;
+  }
+
+  tk->size = 0;
+  tk->k = k;
+  return tk;
+}
+
+
+
+void s_topk_push(s_topk_t *tk, int val) {
+  if (!tk) return;
+
+  // heap is not full yet, sift the new value up
+  if (tk->size < tk->k) {
+    int i = tk->size++;
+
+    while (i > 0 && S_LESS(tk->heap[(i - 1) / 2], val)) {
+      tk->heap[i] = tk->heap[(i - 1) / 2];
+      i = (i - 1) / 2;
+    }
+    tk->heap[i] = val;
+    return;
+  }
+
+  // heap is full, value has to beat the largest of the k smallest
+  if (S_LESS(val, tk->heap[0])) {
+    tk->heap[0] = val;
+    topk_sift_down(tk->heap, tk->size, 0);
+  }
+}
+
+
+
+int s_topk_result(s_topk_t *tk, int out[]) {
+  if (!tk || !out) return 0;
+
+  for (int i = 0; i < tk->size; i++) out[i] = tk->heap[i];
+  s_intro_sort(out, tk->size);
+
+  return tk->size;
+}
+
+
+
+void s_topk_free(s_topk_t *tk) {
+  if (!tk) return;
+
+  free(tk->heap);
+  free(tk);
+}
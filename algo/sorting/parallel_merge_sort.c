@@ -0,0 +1,186 @@
+#include "sorting.h"
+
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+
+/* work item for sorting a range, result lands either in arr or in tmp */
+typedef struct {
+  int *arr;
+  int *tmp;
+  int size;
+  int threads;      // no of threads this range is allowed to use
+  bool to_tmp;      // should the sorted result be placed in tmp?
+} sort_task_t;
+
+
+/* work item for merging two sorted runs into out */
+typedef struct {
+  const int *a;
+  int na;
+  const int *b;
+  int nb;
+  int *out;
+  int threads;
+} merge_task_t;
+
+
+
+/* run fn on a new thread, if thread can't be created then run it inline */
+static bool spawn(pthread_t *thread, void *(*fn)(void *), void *arg) {
+  if (pthread_create(thread, NULL, fn, arg) == 0) return true;
+
+  fn(arg);
+  return false;
+}
+
+
+
+/* index of the first element in arr that is not less than val */
+static int lower_bound(const int *arr, int size, int val) {
+  int lo = 0, hi = size;
+
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (arr[mid] < val) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+
+
+/* index of the first element in arr that is greater than val */
+static int upper_bound(const int *arr, int size, int val) {
+  int lo = 0, hi = size;
+
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (arr[mid] <= val) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+
+
+static void merge(const int *a, int na, const int *b, int nb, int *out) {
+  int i = 0, j = 0, k = 0;
+
+  // take from b only when it is strictly smaller, this keeps the merge stable
+  while (i < na && j < nb)
+    out[k++] = S_LESS(b[j], a[i]) ? b[j++] : a[i++];
+
+  while (i < na) out[k++] = a[i++];
+  while (j < nb) out[k++] = b[j++];
+}
+
+
+
+static void *parallel_merge(void *arg) {
+  merge_task_t *t = arg;
+
+  if (t->threads <= 1 || t->na + t->nb <= PARALLEL_SORT_CUTOVER) {
+    merge(t->a, t->na, t->b, t->nb, t->out);
+    return NULL;
+  }
+
+  // pick the median of the larger run, and find its position in the other
+  // run. Everything on the left of it goes to the left half of the output
+  // and the rest goes to the right half, so both halves can merge independently
+  merge_task_t left, right;
+
+  if (t->na >= t->nb) {
+    int ma = t->na / 2;
+    int mb = lower_bound(t->b, t->nb, t->a[ma]);
+
+    left  = (merge_task_t){ t->a, ma, t->b, mb, t->out, t->threads / 2 };
+    right = (merge_task_t){ t->a + ma, t->na - ma, t->b + mb, t->nb - mb,
+                            t->out + ma + mb, t->threads - t->threads / 2 };
+  } else {
+    // elements of a equal to the pivot must stay in front of it
+    int mb = t->nb / 2;
+    int ma = upper_bound(t->a, t->na, t->b[mb]);
+
+    left  = (merge_task_t){ t->a, ma, t->b, mb, t->out, t->threads / 2 };
+    right = (merge_task_t){ t->a + ma, t->na - ma, t->b + mb, t->nb - mb,
+                            t->out + ma + mb, t->threads - t->threads / 2 };
+  }
+
+  pthread_t thread;
+  bool spawned = spawn(&thread, parallel_merge, &left);
+  parallel_merge(&right);
+
+  if (spawned) pthread_join(thread, NULL);
+  return NULL;
+}
+
+
+
+static void *parallel_sort(void *arg) {
+  sort_task_t *t = arg;
+
+  // small range or no threads left, use the sequential kernel
+  if (t->threads <= 1 || t->size <= PARALLEL_SORT_CUTOVER) {
+    s_intro_sort(t->arr, t->size);
+    if (t->to_tmp) memcpy(t->tmp, t->arr, t->size * sizeof(int));
+    return NULL;
+  }
+
+  int half = t->size / 2;
+  int left_threads = t->threads / 2;
+
+  // both halves place their result in the other buffer, from where they are
+  // merged back into the buffer requested by this task
+  sort_task_t left  = { t->arr, t->tmp, half, left_threads, !t->to_tmp };
+  sort_task_t right = { t->arr + half, t->tmp + half, t->size - half,
+                        t->threads - left_threads, !t->to_tmp };
+
+  pthread_t thread;
+  bool spawned = spawn(&thread, parallel_sort, &left);
+  parallel_sort(&right);
+
+  if (spawned) pthread_join(thread, NULL);
+
+  const int *src = t->to_tmp ? t->arr : t->tmp;
+  int *dst = t->to_tmp ? t->tmp : t->arr;
+
+  merge_task_t m = { src, half, src + half, t->size - half, dst, t->threads };
+  parallel_merge(&m);
+  return NULL;
+}
+
+
+
+
+void s_parallel_merge_sort_threads(int arr[], int size, int threads) {
+  if (!arr || size <= 1) return;
+
+  if (threads <= 0) threads = 1;
+
+  // nothing to split, don't pay for the scratch buffer
+  if (threads == 1 || size <= PARALLEL_SORT_CUTOVER) {
+    s_intro_sort(arr, size);
+    return;
+  }
+
+  int *tmp = malloc(size * sizeof(int));
+  if (!tmp) {
+    s_intro_sort(arr, size);
+    return;
+  }
+
+  sort_task_t task = { arr, tmp, size, threads, false };
+  parallel_sort(&task);
+
+  free(tmp);
+}
+
+
+
+void s_parallel_merge_sort(int arr[], int size) {
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+  s_parallel_merge_sort_threads(arr, size, cores > 0 ? (int)cores : 1);
+}
@@ -0,0 +1,82 @@
+#include "sorting.h"
+
+#include <string.h>
+#include <stdint.h>
+
+#define RADIX_BITS    8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_MASK    (RADIX_BUCKETS - 1)
+#define RADIX_PASSES  ((int)(sizeof(int) * 8 / RADIX_BITS))
+
+
+/* flip the sign bit, so that negative values order before the positive ones
+   when the keys are compared as unsigned */
+static inline uint32_t radix_key(int val) {
+  return (uint32_t)val ^ 0x80000000u;
+}
+
+
+
+
+void s_radix_sort_buf(int arr[], int size, int scratch[]) {
+  if (!arr || !scratch || size <= 1) return;
+
+  // histogram of every digit is collected in a single pass over the array
+  int count[RADIX_PASSES][RADIX_BUCKETS] = {0};
+
+  for (int i = 0; i < size; i++) {
+    uint32_t key = radix_key(arr[i]);
+
+    for (int pass = 0; pass < RADIX_PASSES; pass++)
+      count[pass][(key >> (pass * RADIX_BITS)) & RADIX_MASK]++;
+  }
+
+  int *src = arr;
+  int *dst = scratch;
+
+  for (int pass = 0; pass < RADIX_PASSES; pass++) {
+    int shift = pass * RADIX_BITS;
+    int *bucket = count[pass];
+
+    // all the keys share this digit, the pass wouldn't move anything
+    if (bucket[(radix_key(src[0]) >> shift) & RADIX_MASK] == size) continue;
+
+    // turn the counts into starting offset of each bucket
+    int offset = 0;
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+      int freq = bucket[b];
+      bucket[b] = offset;
+      offset += freq;
+    }
+
+    // scatter the values in order, this keeps every pass stable
+    for (int i = 0; i < size; i++)
+      dst[bucket[(radix_key(src[i]) >> shift) & RADIX_MASK]++] = src[i];
+
+#ifdef SORT_STATS
+    s_stats.swaps += size;     // every value is moved once per pass
+#endif
+
+    int *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  // odd no of passes were done, the result is in the scratch buffer
+  if (src != arr) memcpy(arr, src, size * sizeof(int));
+}
+
+
+
+void s_radix_sort(int arr[], int size) {
+  if (!arr || size <= 1) return;
+
+  int *scratch = malloc(size * sizeof(int));
+  if (!scratch) {
+    s_intro_sort(arr, size);   // no memory for the scratch, sort in-place
+    return;
+  }
+
+  s_radix_sort_buf(arr, size, scratch);
+  free(scratch);
+}
@@ -11,12 +11,13 @@ void s_selection_sort(int *arr, int size) {
 
     // find the smallest value in range (i to size)
     for (int j = i; j < size; j++) {
-      if (arr[j] < arr[min_idx])
+      if (S_LESS(arr[j], arr[min_idx]))
         min_idx = j;
     }
 
     // let's swap the values b/w i and the min_idx position
     if (i != min_idx) {
+      S_SWAP();
       tmp = arr[i];
       arr[i] = arr[min_idx];
       arr[min_idx] = tmp;
@@ -1,20 +1,93 @@
 #include "sorting.h"
 
-int increment_factor(int size) {
-  // let's take the increment factor to be half the size of array + 1
-  // + 1 is to make the factor to be odd.
-  // And on each iteration, we decrement the factor by 2 until we reach 1
-  return (size % 2 == 0 ? (size / 2) + 1 : size / 2); 
+#define MAX_GAPS 512    // enough for the longest table (pratt) within int range
+
+/* ciura's experimentally found gaps, extended by a factor of 2.25 */
+static const int CIURA_GAPS[] = {1, 4, 10, 23, 57, 132, 301, 701, 1750};
+#define CIURA_COUNT ((int)(sizeof(CIURA_GAPS) / sizeof(CIURA_GAPS[0])))
+
+
+
+/* fill gaps[] in ascending order with the sequence values that are less than
+   the size of array and return the no of gaps. gaps are computed in long long,
+   as the first one past the size can overflow an int (and long on LLP64) */
+static int shell_gaps(shell_gap_t seq, int size, int gaps[]) {
+  int count = 0;
+
+  switch (seq) {
+    case SHELL_GAP_TOKUDA: {
+      // h(k) = ceil( (9 * (9/4)^k - 4) / 5 )
+      double factor = 1.0;
+      for (;;) {
+        double h = (9.0 * factor - 4.0) / 5.0;
+        long long gap = (long long)h + (h > (long long)h ? 1 : 0);
+        if (gap >= size) break;
+
+        gaps[count++] = (int)gap;
+        factor *= 2.25;
+      }
+      break;
+    }
+
+    case SHELL_GAP_SEDGEWICK: {
+      // 1, then 4^k + 3 * 2^(k-1) + 1
+      gaps[count++] = 1;
+      for (int k = 1; ; k++) {
+        long long gap = (1LL << (2 * k)) + 3 * (1LL << (k - 1)) + 1;
+        if (gap >= size) break;
+
+        gaps[count++] = (int)gap;
+      }
+      break;
+    }
+
+    case SHELL_GAP_PRATT: {
+      // every 2^p * 3^q that is less than size, then sort them
+      for (long long pow3 = 1; pow3 < size; pow3 *= 3) {
+        for (long long gap = pow3; gap < size; gap *= 2)
+          gaps[count++] = (int)gap;
+      }
+
+      // table is short, insertion sort is good enough
+      s_insertion_sort(gaps, count);
+      break;
+    }
+
+    case SHELL_GAP_CIURA:
+    default: {
+      for (int i = 0; i < CIURA_COUNT && CIURA_GAPS[i] < size; i++)
+        gaps[count++] = CIURA_GAPS[i];
+
+      // beyond the table, keep growing by 2.25
+      if (count == CIURA_COUNT) {
+        double gap = CIURA_GAPS[CIURA_COUNT - 1] * 2.25;
+        while (gap < size && count < MAX_GAPS) {
+          gaps[count++] = (int)gap;
+          gap *= 2.25;
+        }
+      }
+      break;
+    }
+  }
+
+  // size of 1 produces no gaps, the array is already sorted
+  return count;
 }
 
 
 
 
-void s_shell_sort(int arr[], int size) {
-  // increment - is the interval range, distance b/w elements that were compared
-  int increment = increment_factor(size);
+void s_shell_sort_gaps(int arr[], int size, shell_gap_t seq) {
+  if (!arr || size <= 1) return;
+
+  int gaps[MAX_GAPS];
+  int count = shell_gaps(seq, size, gaps);
+
+  // start from the largest gap and end with gap of 1 (plain insertion sort)
+  for (int g = count - 1; g >= 0; g--) {
+    // increment - is the interval range, distance b/w elements that were compared
+    int increment = gaps[g];
 
-  while (increment >= 1) {
     // starting from the increment, loop through till the end of the loop
     // do this for every new increment value
     for (int i = increment; i < size; i++) {
@@ -24,8 +97,9 @@ void s_shell_sort(int arr[], int size) {
       // 'increment' as intervel and continue it till :- either we reach 0 or
       // we find a proper position for the current element
       int j = i - increment;
-      while (j >= 0 && curr < arr[j]) {
+      while (j >= 0 && S_LESS(curr, arr[j])) {
         arr[j + increment] = arr[j];
+        S_SWAP();
 
         j -= increment;
       }
@@ -33,8 +107,11 @@ void s_shell_sort(int arr[], int size) {
        // insert curr at proper position
       arr[j + increment] = curr;
     }
-
-    // decrement the increment factor by 2 on every  iteration
-    increment -= 2;
   }
-}
\ No newline at end of file
+}
+
+
+
+void s_shell_sort(int arr[], int size) {
+  s_shell_sort_gaps(arr, size, SHELL_GAP_CIURA);
+}
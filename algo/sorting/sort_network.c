@@ -0,0 +1,243 @@
+#include "sorting.h"
+
+#include <limits.h>
+#include <string.h>
+#include <stdatomic.h>
+
+/*
+  Bitonic sorting network for blocks of upto SORT_NETWORK_MAX ints.
+
+  The block is padded with INT_MAX upto a power of 2 no of registers. Each
+  register is sorted on its own, and then the sorted registers are merged
+  pairwise (1 + 1, 2 + 2, 4 + 4 ...) with bitonic merges. Every merge starts
+  with a "flip" (first half against the reversed second half), after which
+  only half cleaners (min / max at a fixed distance) are needed.
+*/
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define SORT_NETWORK_X86
+  #include <immintrin.h>
+#endif
+
+
+
+/* ---------- SCALAR ---------- */
+
+static void network_scalar(int arr[], int size) {
+  s_insertion_sort(arr, size);
+}
+
+
+
+#ifdef SORT_NETWORK_X86
+
+/* ---------- AVX2 :- 8 ints per register ---------- */
+
+#define AVX2_FN static inline __attribute__((target("avx2"), always_inline))
+
+/* lanes set in mask take the max, the rest take the min */
+#define AVX2_CMP_SWAP(v, p, mask) \
+  _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), mask)
+
+AVX2_FN __m256i avx2_reverse(__m256i v) {
+  return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+/* sort a bitonic register :- half cleaners at distance 4, 2 and 1 */
+AVX2_FN __m256i avx2_merge_lanes(__m256i v) {
+  v = AVX2_CMP_SWAP(v, _mm256_permute2x128_si256(v, v, 1), 0xF0);
+  v = AVX2_CMP_SWAP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), 0xCC);
+  v = AVX2_CMP_SWAP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+  return v;
+}
+
+/* sort the 8 lanes of a register */
+AVX2_FN __m256i avx2_sort_lanes(__m256i v) {
+  // pairs
+  v = AVX2_CMP_SWAP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+
+  // groups of 4 :- flip, then distance 1
+  v = AVX2_CMP_SWAP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)), 0xCC);
+  v = AVX2_CMP_SWAP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+
+  // all 8 :- flip, then distance 2 and 1
+  v = AVX2_CMP_SWAP(v, avx2_reverse(v), 0xF0);
+  v = AVX2_CMP_SWAP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), 0xCC);
+  v = AVX2_CMP_SWAP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+  return v;
+}
+
+/* merge the sorted runs v[0, w) and v[w, 2w) of w registers each */
+AVX2_FN void avx2_merge_regs(__m256i *v, int w) {
+  // flip :- register i against the reversed register (2w - 1 - i)
+  for (int i = 0; i < w; i++) {
+    __m256i r = avx2_reverse(v[2 * w - 1 - i]);
+    v[2 * w - 1 - i] = avx2_reverse(_mm256_max_epi32(v[i], r));
+    v[i] = _mm256_min_epi32(v[i], r);
+  }
+
+  // half cleaners across the registers of each half
+  for (int d = w / 2; d >= 1; d /= 2) {
+    for (int i = 0; i < 2 * w; i++) {
+      if (i & d) continue;
+
+      __m256i lo = _mm256_min_epi32(v[i], v[i + d]);
+      v[i + d] = _mm256_max_epi32(v[i], v[i + d]);
+      v[i] = lo;
+    }
+  }
+
+  // and within each register
+  for (int i = 0; i < 2 * w; i++) v[i] = avx2_merge_lanes(v[i]);
+}
+
+__attribute__((target("avx2")))
+static void network_avx2(int arr[], int size) {
+  int buf[SORT_NETWORK_MAX];
+  __m256i v[SORT_NETWORK_MAX / 8];
+
+  // no of registers, rounded up to a power of 2
+  int regs = 1;
+  while (regs * 8 < size) regs *= 2;
+
+  memcpy(buf, arr, size * sizeof(int));
+  for (int i = size; i < regs * 8; i++) buf[i] = INT_MAX;
+
+  for (int i = 0; i < regs; i++) {
+    v[i] = _mm256_loadu_si256((const __m256i *)(buf + i * 8));
+    v[i] = avx2_sort_lanes(v[i]);
+  }
+
+  for (int w = 1; w < regs; w *= 2) {
+    for (int i = 0; i < regs; i += 2 * w) avx2_merge_regs(v + i, w);
+  }
+
+  for (int i = 0; i < regs; i++) _mm256_storeu_si256((__m256i *)(buf + i * 8), v[i]);
+  memcpy(arr, buf, size * sizeof(int));
+}
+
+
+
+/* ---------- SSE4.1 :- 4 ints per register ---------- */
+
+#define SSE41_FN static inline __attribute__((target("sse4.1"), always_inline))
+
+/* blend_epi16 works on 16-bit lanes, so every 32-bit lane takes 2 mask bits */
+#define SSE41_CMP_SWAP(v, p, mask) \
+  _mm_blend_epi16(_mm_min_epi32(v, p), _mm_max_epi32(v, p), mask)
+
+SSE41_FN __m128i sse41_reverse(__m128i v) {
+  return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+SSE41_FN __m128i sse41_merge_lanes(__m128i v) {
+  v = SSE41_CMP_SWAP(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), 0xF0);
+  v = SSE41_CMP_SWAP(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xCC);
+  return v;
+}
+
+SSE41_FN __m128i sse41_sort_lanes(__m128i v) {
+  v = SSE41_CMP_SWAP(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xCC);
+  v = SSE41_CMP_SWAP(v, sse41_reverse(v), 0xF0);
+  v = SSE41_CMP_SWAP(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xCC);
+  return v;
+}
+
+SSE41_FN void sse41_merge_regs(__m128i *v, int w) {
+  for (int i = 0; i < w; i++) {
+    __m128i r = sse41_reverse(v[2 * w - 1 - i]);
+    v[2 * w - 1 - i] = sse41_reverse(_mm_max_epi32(v[i], r));
+    v[i] = _mm_min_epi32(v[i], r);
+  }
+
+  for (int d = w / 2; d >= 1; d /= 2) {
+    for (int i = 0; i < 2 * w; i++) {
+      if (i & d) continue;
+
+      __m128i lo = _mm_min_epi32(v[i], v[i + d]);
+      v[i + d] = _mm_max_epi32(v[i], v[i + d]);
+      v[i] = lo;
+    }
+  }
+
+  for (int i = 0; i < 2 * w; i++) v[i] = sse41_merge_lanes(v[i]);
+}
+
+__attribute__((target("sse4.1")))
+static void network_sse41(int arr[], int size) {
+  int buf[SORT_NETWORK_MAX];
+  __m128i v[SORT_NETWORK_MAX / 4];
+
+  int regs = 1;
+  while (regs * 4 < size) regs *= 2;
+
+  memcpy(buf, arr, size * sizeof(int));
+  for (int i = size; i < regs * 4; i++) buf[i] = INT_MAX;
+
+  for (int i = 0; i < regs; i++) {
+    v[i] = _mm_loadu_si128((const __m128i *)(buf + i * 4));
+    v[i] = sse41_sort_lanes(v[i]);
+  }
+
+  for (int w = 1; w < regs; w *= 2) {
+    for (int i = 0; i < regs; i += 2 * w) sse41_merge_regs(v + i, w);
+  }
+
+  for (int i = 0; i < regs; i++) _mm_storeu_si128((__m128i *)(buf + i * 4), v[i]);
+  memcpy(arr, buf, size * sizeof(int));
+}
+
+#endif   // SORT_NETWORK_X86
+
+
+
+/* ---------- RUNTIME DISPATCH ---------- */
+
+static void (* const NETWORK_KERNELS[])(int *, int) = {
+#ifdef SORT_NETWORK_X86
+  [SORT_NET_SCALAR] = network_scalar,
+  [SORT_NET_SSE41]  = network_sse41,
+  [SORT_NET_AVX2]   = network_avx2,
+#else
+  [SORT_NET_SCALAR] = network_scalar,
+  [SORT_NET_SSE41]  = network_scalar,
+  [SORT_NET_AVX2]   = network_scalar,
+#endif
+};
+
+// resolved on the first call, -1 until then
+static atomic_int network_isa = -1;
+
+
+
+sort_net_isa_t s_sort_network_isa() {
+  int isa = atomic_load_explicit(&network_isa, memory_order_relaxed);
+  if (isa >= 0) return (sort_net_isa_t)isa;
+
+  isa = SORT_NET_SCALAR;
+#ifdef SORT_NETWORK_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) isa = SORT_NET_AVX2;
+  else if (__builtin_cpu_supports("sse4.1")) isa = SORT_NET_SSE41;
+#endif
+
+  atomic_store_explicit(&network_isa, isa, memory_order_relaxed);
+  return (sort_net_isa_t)isa;
+}
+
+
+
+void s_sort_network_with(int arr[], int size, sort_net_isa_t isa) {
+  if (!arr || size <= 1) return;
+
+  // larger blocks, or a kernel the cpu can't run, go to the scalar kernel
+  if (size > SORT_NETWORK_MAX || isa > s_sort_network_isa()) isa = SORT_NET_SCALAR;
+
+  NETWORK_KERNELS[isa](arr, size);
+}
+
+
+
+void s_sort_network(int arr[], int size) {
+  s_sort_network_with(arr, size, s_sort_network_isa());
+}
@@ -0,0 +1,8 @@
+#include "sorting.h"
+
+#ifdef SORT_STATS
+
+// counters are per thread, so parallel sorts don't race on them
+_Thread_local sort_stats_t s_stats;
+
+#endif
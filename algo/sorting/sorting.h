@@ -5,6 +5,61 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+// ranges smaller than this are sorted / merged sequentially by the parallel sort
+#define PARALLEL_SORT_CUTOVER  16384
+
+// largest block the sorting network kernels handle
+#define SORT_NETWORK_MAX       64
+
+
+/* gap sequences available for the shell sort */
+typedef enum {
+  SHELL_GAP_CIURA,        // 1, 4, 10, 23, 57, 132, 301, 701, 1750, * 2.25
+  SHELL_GAP_TOKUDA,       // ceil( (9 * (9/4)^k - 4) / 5 )
+  SHELL_GAP_SEDGEWICK,    // 1, 4^k + 3 * 2^(k-1) + 1
+  SHELL_GAP_PRATT         // 2^p * 3^q
+} shell_gap_t;
+
+
+/* instruction sets the sorting network kernels are built for */
+typedef enum {
+  SORT_NET_SCALAR,        // insertion sort
+  SORT_NET_SSE41,         // 4 ints per register
+  SORT_NET_AVX2           // 8 ints per register
+} sort_net_isa_t;
+
+
+/* bounded max heap, that keeps the k smallest values pushed so far */
+typedef struct {
+  int *heap;       // heap[0] is the largest of the k smallest
+  int size;        // no of values in the heap
+  int k;           // capacity of the heap
+} s_topk_t;
+
+
+/* comparator, same as the one taken by qsort */
+typedef int (*s_cmp_t)(const void *, const void *);
+
+/* comparator with an extra context pointer, passed as is from the caller */
+typedef int (*s_cmp_r_t)(const void *, const void *, void *);
+
+
+/* operation counters, updated by the sorts only when built with SORT_STATS */
+typedef struct {
+  unsigned long long comparisons;   // no of key comparisons
+  unsigned long long swaps;         // no of swaps / element shifts
+} sort_stats_t;
+
+#ifdef SORT_STATS
+  extern _Thread_local sort_stats_t s_stats;
+
+  #define S_LESS(a, b)   (s_stats.comparisons++, (a) < (b))
+  #define S_SWAP()       (s_stats.swaps++)
+#else
+  #define S_LESS(a, b)   ((a) < (b))
+  #define S_SWAP()       ((void)0)
+#endif
+
 
 
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
@@ -55,6 +110,7 @@ void s_insertion_sort(int *, int);
 
 /**
  * @brief SHELL SORT ALGORITHM (DIMINISHING INSERTION SORT)
+ *        uses ciura's gap sequence
  * 
  *        time complexity  - O( N(log N)^2 )
  *        space complexity - O(1)     ; in-place sort
@@ -67,5 +123,228 @@ void s_insertion_sort(int *, int);
  */
 void s_shell_sort(int *, int);
 
+/**
+ * @brief SHELL SORT ALGORITHM, with the given gap sequence
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ * @param shell_gap_t - gap sequence to use
+ */
+void s_shell_sort_gaps(int *, int, shell_gap_t);
+
+/**
+ * @brief INTRO SORT ALGORITHM
+ *        median of three quick sort, that falls back to heap sort once the
+ *        recursion depth crosses 2 * log2(N) and hands the small partitions
+ *        to insertion sort
+ * 
+ *        time complexity  - O(N log N)
+ *        space complexity - O(log N) ; in-place sort, recursion stack
+ *        not stable
+ *        not data sensisitve
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ */
+void s_intro_sort(int *, int);
+
+/**
+ * @brief PARALLEL MERGE SORT ALGORITHM
+ *        array is split b/w the threads (one per core), each part is sorted
+ *        with intro sort and the sorted runs are merged back in parallel.
+ *        Ranges smaller than PARALLEL_SORT_CUTOVER are handled sequentially
+ * 
+ *        time complexity  - O(N log N / P) ; P - no of threads
+ *        space complexity - O(N)     ; scratch buffer for merging
+ *        not stable
+ *        not data sensisitve
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ */
+void s_parallel_merge_sort(int *, int);
+
+/**
+ * @brief PARALLEL MERGE SORT ALGORITHM, with the given no of threads
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ * @param int - no of threads to use, 1 sorts on the calling thread
+ */
+void s_parallel_merge_sort_threads(int *, int, int);
+
+/**
+ * @brief LSD RADIX SORT ALGORITHM
+ *        sorts on 8-bit digits from the least significant one, sign bit is
+ *        flipped so negative values are ordered first. Digit passes where all
+ *        the keys fall in the same bucket are skipped
+ * 
+ *        time complexity  - O(N)     ; 4 passes for 32-bit int
+ *        space complexity - O(N)     ; scratch buffer allocated internally
+ *        stable
+ *        not data sensisitve
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ */
+void s_radix_sort(int *, int);
+
+/**
+ * @brief LSD RADIX SORT ALGORITHM, with caller provided scratch buffer
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ * @param int* - scratch buffer, must hold atleast size no of integers
+ */
+void s_radix_sort_buf(int *, int, int *);
+
+/**
+ * @brief TIM SORT ALGORITHM
+ *        natural merge sort :- ascending and strictly descending runs are
+ *        detected (short runs are extended with binary insertion) and merged
+ *        with galloping, so presorted input is sorted in O(N)
+ * 
+ *        time complexity  - O(N log N), O(N) on sorted input
+ *        space complexity - O(N)     ; atmost N / 2 scratch buffer
+ *        stable
+ *        data sensisitve
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ */
+void s_tim_sort(int *, int);
+
+/**
+ * @brief SORTING NETWORK
+ *        bitonic sorting network for small blocks (upto SORT_NETWORK_MAX),
+ *        run with AVX2 or SSE4.1 whichever the cpu supports (checked once
+ *        at runtime). Larger blocks fall back to insertion sort
+ * 
+ *        time complexity  - O(N (log N)^2) compare-exchanges, N / 8 per instruction
+ *        space complexity - O(1)     ; block is sorted in registers
+ *        not stable
+ *        not data sensisitve
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ */
+void s_sort_network(int *, int);
+
+/**
+ * @brief SORTING NETWORK, with the given kernel
+ *        kernels the cpu doesn't support fall back to the scalar one
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ * @param sort_net_isa_t - kernel to use
+ */
+void s_sort_network_with(int *, int, sort_net_isa_t);
+
+/**
+ * @brief Best sorting network kernel supported by this cpu
+ * 
+ * @return sort_net_isa_t 
+ */
+sort_net_isa_t s_sort_network_isa();
+
+/**
+ * @brief NTH ELEMENT (INTROSELECT)
+ *        rearrange the array so that the element at k is the one that would
+ *        be there in the sorted array, with no greater element before it and
+ *        no smaller element after it. quick select with median of three,
+ *        switching to median of medians pivots when it degrades
+ * 
+ *        time complexity  - O(N)
+ *        space complexity - O(1)     ; in-place
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ * @param int - index to select, in range [0, size)
+ */
+void s_nth_element(int *, int, int);
+
+/**
+ * @brief PARTIAL SORT
+ *        place the k smallest elements, in sorted order, at the front of
+ *        the array. order of the rest of the elements is unspecified
+ * 
+ *        time complexity  - O(N + k log k)
+ *        space complexity - O(log k)
+ * 
+ * @param int* - integer array
+ * @param int - size of the array
+ * @param int - no of smallest elements to sort
+ */
+void s_partial_sort(int *, int, int);
+
+/**
+ * @brief Allocate a streaming top k, that keeps the k smallest values
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(k)
+ * 
+ * @param int - no of values to keep
+ * @return s_topk_t* 
+ */
+s_topk_t* s_topk_init(int);
+
+/**
+ * @brief Offer a value to the top k
+ * 
+ *        time complexity  - O(log k)
+ *        space complexity - O(1)
+ * 
+ * @param s_topk_t* - ref to s_topk_t struct
+ * @param int - value
+ */
+void s_topk_push(s_topk_t *, int);
+
+/**
+ * @brief Copy the k smallest values seen so far, in sorted order
+ * 
+ *        time complexity  - O(k log k)
+ *        space complexity - O(1)
+ * 
+ * @param s_topk_t* - ref to s_topk_t struct
+ * @param int* - output array, must hold atleast k values
+ * @return int - no of values copied (less than k, if fewer were pushed)
+ */
+int s_topk_result(s_topk_t *, int *);
+
+/**
+ * @brief Release the memory of the top k
+ * 
+ * @param s_topk_t* - ref to s_topk_t struct
+ */
+void s_topk_free(s_topk_t *);
+
+/**
+ * @brief GENERIC SORT
+ *        intro sort on elements of any size, ordered by the comparator.
+ *        4, 8 and 16 byte elements get their own swap routines. input that
+ *        is 1 or 2 monotone runs is reversed and merged instead
+ * 
+ *        time complexity  - O(N log N) ; O(N) for 1 or 2 runs
+ *        space complexity - O(log N)   ; O(N) scratch for 2 runs
+ *        not stable
+ * 
+ * @param void* - base of the array
+ * @param size_t - no of elements in the array
+ * @param size_t - size of each element in bytes
+ * @param s_cmp_r_t - comparator; negative, 0, positive for less, equal, greater
+ * @param void* - context, passed as the third argument to the comparator
+ */
+void s_sort(void *, size_t, size_t, s_cmp_r_t, void *);
+
+/**
+ * @brief GENERIC SORT, drop in replacement for qsort
+ * 
+ * @param void* - base of the array
+ * @param size_t - no of elements in the array
+ * @param size_t - size of each element in bytes
+ * @param s_cmp_t - comparator; negative, 0, positive for less, equal, greater
+ */
+void s_qsort(void *, size_t, size_t, s_cmp_t);
+
 
 #endif   // __ALGO_SORTING_HEADER__
\ No newline at end of file
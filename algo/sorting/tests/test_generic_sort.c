@@ -0,0 +1,111 @@
+#include "sorting.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define N 5000
+
+
+typedef struct { long key; long tag; } pair_t;           // 16 bytes
+typedef struct { char name[7]; } name_t;                 // odd size
+
+static int cmp_int(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_pair(const void *a, const void *b) {
+  long x = ((const pair_t *)a)->key, y = ((const pair_t *)b)->key;
+  return (x > y) - (x < y);
+}
+
+static int cmp_name(const void *a, const void *b) {
+  return memcmp(a, b, sizeof(name_t));
+}
+
+// context flips the order
+static int cmp_int_r(const void *a, const void *b, void *ctx) {
+  return *(int *)ctx * cmp_int(a, b);
+}
+
+
+
+
+int main() {
+  int a[] = {11, 7, 3, 2, 5, 66, 1, 4, 9, 8};
+  s_qsort(a, 10, sizeof(int), cmp_int);
+
+  for (int i = 0; i < 10; i++) {
+    printf("%d, ", a[i]);
+  }
+  printf("\n\n");
+
+  // every element size is compared with libc's qsort
+  static int ints[N], ints_exp[N];
+  static double dbls[N], dbls_exp[N];
+  static pair_t pairs[N];
+  static name_t names[N], names_exp[N];
+
+  for (int i = 0; i < N; i++) {
+    ints[i] = rand() % 1000 - 500;
+    dbls[i] = rand() / (double)RAND_MAX;
+    pairs[i] = (pair_t){ rand() % 100, i };
+    for (int c = 0; c < 7; c++) names[i].name[c] = 'a' + rand() % 3;
+  }
+
+  memcpy(ints_exp, ints, sizeof(ints));
+  memcpy(dbls_exp, dbls, sizeof(dbls));
+  memcpy(names_exp, names, sizeof(names));
+
+  s_qsort(ints, N, sizeof(int), cmp_int);
+  qsort(ints_exp, N, sizeof(int), cmp_int);
+  assert(memcmp(ints, ints_exp, sizeof(ints)) == 0);
+
+  s_qsort(dbls, N, sizeof(double), cmp_double);
+  qsort(dbls_exp, N, sizeof(double), cmp_double);
+  assert(memcmp(dbls, dbls_exp, sizeof(dbls)) == 0);
+
+  // not stable, so check the order of keys and that no tag got lost
+  s_qsort(pairs, N, sizeof(pair_t), cmp_pair);
+  static bool seen[N];
+  for (int i = 0; i < N; i++) {
+    if (i > 0) assert(pairs[i - 1].key <= pairs[i].key);
+    assert(!seen[pairs[i].tag]);
+    seen[pairs[i].tag] = true;
+  }
+
+  s_qsort(names, N, sizeof(name_t), cmp_name);
+  qsort(names_exp, N, sizeof(name_t), cmp_name);
+  assert(memcmp(names, names_exp, sizeof(names)) == 0);
+
+  // descending order through the context
+  int order = -1;
+  s_sort(ints, N, sizeof(int), cmp_int_r, &order);
+  for (int i = 1; i < N; i++) assert(ints[i - 1] >= ints[i]);
+
+  // inputs of 1 or 2 runs :- organ pipe, 2 ascending, descending + ascending,
+  // ascending + descending with equal values, one descending
+  for (int round = 0; round < 5; round++) {
+    for (int i = 0; i < N; i++) {
+      switch (round) {
+        case 0: ints[i] = i < N / 2 ? i : N - i; break;
+        case 1: ints[i] = i < N / 3 ? 2 * i : i - N / 3; break;
+        case 2: ints[i] = i < N / 4 ? N - i : i; break;
+        case 3: ints[i] = i < N / 2 ? i / 3 : (N - i) / 3; break;
+        case 4: ints[i] = N - i; break;
+      }
+    }
+
+    memcpy(ints_exp, ints, sizeof(ints));
+    s_qsort(ints, N, sizeof(int), cmp_int);
+    qsort(ints_exp, N, sizeof(int), cmp_int);
+    assert(memcmp(ints, ints_exp, sizeof(ints)) == 0);
+  }
+
+  printf("*** generic sort tests passed ***\n");
+}
@@ -0,0 +1,38 @@
+#include "sorting.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define N 5000
+
+int main() {
+  int a[] = {11, 7, 3, 2, 5, 66, 1, 4, 9, 8};
+  s_intro_sort(a, 10);
+
+  for (int i = 0; i < 10; i++) {
+    printf("%d, ", a[i]);
+  }
+  printf("\n\n");
+
+  // compare against insertion sort on random, sorted, reverse and few unique
+  static int arr[N], expected[N];
+
+  for (int round = 0; round < 4; round++) {
+    for (int i = 0; i < N; i++) {
+      switch (round) {
+        case 0: arr[i] = rand() - RAND_MAX / 2; break;
+        case 1: arr[i] = i; break;
+        case 2: arr[i] = N - i; break;
+        case 3: arr[i] = rand() % 4; break;
+      }
+    }
+
+    memcpy(expected, arr, sizeof(arr));
+    s_insertion_sort(expected, N);
+    s_intro_sort(arr, N);
+
+    assert(memcmp(arr, expected, sizeof(arr)) == 0);
+  }
+
+  printf("*** intro sort tests passed ***\n");
+}
@@ -0,0 +1,134 @@
+#include "sorting.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <string.h>
+
+#define N 5000
+#define KILLER_N (1 << 15)
+
+
+/* median of 3 killer :- replays the pivot choice and the partition of the
+   selection on positions, fixing a value only when a pivot is picked. the
+   3 sampled values are always the smallest left, so each round drops just a
+   few elements from the range. rest of the values are given at the end */
+static void m3_killer(int arr[], int n) {
+  int *lab = malloc(n * sizeof(int));    // original index at each position
+  for (int i = 0; i < n; i++) {
+    lab[i] = i;
+    arr[i] = 0;
+  }
+
+  int next = 1, base = 0, size = n;
+  #define KEY(p) (arr[lab[base + (p)]] ? arr[lab[base + (p)]] : INT_MAX)
+
+  while (size > 16) {
+    int s[] = {0, size / 2, size - 1};
+    for (int t = 0; t < 3; t++)
+      if (!arr[lab[base + s[t]]]) arr[lab[base + s[t]]] = next++;
+
+    // same median of three, then the pivot goes to the front
+    int a = KEY(s[0]), b = KEY(s[1]), c = KEY(s[2]), m;
+    if (a < b) m = b < c ? s[1] : (a < c ? s[2] : s[0]);
+    else       m = a < c ? s[0] : (b < c ? s[2] : s[1]);
+
+    int tmp = lab[base]; lab[base] = lab[base + m]; lab[base + m] = tmp;
+
+    // same hoare partition, the unset values are greater than any pivot
+    int pivot = KEY(0), i = -1, j = size;
+    while (true) {
+      do i++; while (KEY(i) < pivot);
+      do j--; while (pivot < KEY(j));
+      if (i >= j) break;
+
+      tmp = lab[base + i]; lab[base + i] = lab[base + j]; lab[base + j] = tmp;
+    }
+
+    // the last index is selected, so the right side is always kept
+    base += j + 1;
+    size -= j + 1;
+  }
+  #undef KEY
+
+  for (int i = 0; i < n; i++)
+    if (!arr[i]) arr[i] = next++;
+
+  free(lab);
+}
+
+int main() {
+  int a[] = {11, 7, 3, 2, 5, 66, 1, 4, 9, 8};
+  s_nth_element(a, 10, 4);
+  printf("5th smallest: %d\n", a[4]);
+
+  s_partial_sort(a, 10, 3);
+  for (int i = 0; i < 3; i++) {
+    printf("%d, ", a[i]);
+  }
+  printf("\n\n");
+
+  static int arr[N], sorted[N], out[N];
+
+  for (int round = 0; round < 5; round++) {
+    for (int i = 0; i < N; i++) {
+      switch (round) {
+        case 0: arr[i] = rand() - RAND_MAX / 2; break;
+        case 1: arr[i] = i; break;
+        case 2: arr[i] = N - i; break;
+        case 3: arr[i] = rand() % 3; break;
+        case 4: arr[i] = i < N / 2 ? i : N - i; break;
+      }
+    }
+
+    memcpy(sorted, arr, sizeof(arr));
+    s_insertion_sort(sorted, N);
+
+    // nth element :- value at k matches, and the array is split around it
+    int ks[] = {0, 1, N / 2, N - 2, N - 1, rand() % N};
+    for (int t = 0; t < 6; t++) {
+      int k = ks[t];
+      memcpy(out, arr, sizeof(arr));
+      s_nth_element(out, N, k);
+
+      assert(out[k] == sorted[k]);
+      for (int i = 0; i < k; i++) assert(out[i] <= out[k]);
+      for (int i = k + 1; i < N; i++) assert(out[i] >= out[k]);
+    }
+
+    // partial sort :- the first k match the sorted array
+    int k = 1 + rand() % 200;
+    memcpy(out, arr, sizeof(arr));
+    s_partial_sort(out, N, k);
+    assert(memcmp(out, sorted, k * sizeof(int)) == 0);
+
+    // streaming top k
+    s_topk_t *tk = s_topk_init(k);
+    for (int i = 0; i < N; i++) s_topk_push(tk, arr[i]);
+
+    assert(s_topk_result(tk, out) == k);
+    assert(memcmp(out, sorted, k * sizeof(int)) == 0);
+    s_topk_free(tk);
+  }
+
+  // top k with fewer values pushed than k
+  s_topk_t *tk = s_topk_init(10);
+  s_topk_push(tk, 3);
+  s_topk_push(tk, 1);
+  assert(s_topk_result(tk, out) == 2 && out[0] == 1 && out[1] == 3);
+  s_topk_free(tk);
+
+  // median of 3 killer :- comparisons stay linear in the size
+  static int killer[KILLER_N];
+  for (int n = KILLER_N / 16; n <= KILLER_N; n *= 4) {
+    m3_killer(killer, n);
+
+    s_stats.comparisons = 0;
+    s_nth_element(killer, n, n - 1);
+    printf("killer %d :- %llu comparisons\n", n, s_stats.comparisons);
+
+    assert(killer[n - 1] == n);
+    assert(s_stats.comparisons < 16ULL * n);
+  }
+
+  printf("*** nth element tests passed ***\n");
+}
@@ -0,0 +1,37 @@
+#include "sorting.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define N 50000
+
+int main() {
+  int a[] = {11, 7, 3, 2, 5, 66, 1, 4, 9, 8};
+  s_parallel_merge_sort(a, 10);
+
+  for (int i = 0; i < 10; i++) {
+    printf("%d, ", a[i]);
+  }
+  printf("\n\n");
+
+  // compare against insertion sort on random inputs with varying thread count,
+  // N is large enough to go past the sequential cutover
+  static int arr[N], expected[N];
+  int threads[] = {1, 2, 3, 4, 8};
+
+  for (int t = 0; t < 5; t++) {
+    int size = N - t * 1001;    // uneven sizes, so the splits are uneven too
+
+    for (int i = 0; i < size; i++)
+      arr[i] = (t % 2) ? rand() % 100 : rand() - RAND_MAX / 2;
+
+    memcpy(expected, arr, size * sizeof(int));
+    s_insertion_sort(expected, size);
+    s_parallel_merge_sort_threads(arr, size, threads[t]);
+
+    assert(memcmp(arr, expected, size * sizeof(int)) == 0);
+    printf("threads: %d, size: %d passed\n", threads[t], size);
+  }
+
+  printf("*** parallel merge sort tests passed ***\n");
+}
@@ -0,0 +1,42 @@
+#include "sorting.h"
+
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+
+#define N 5000
+
+int main() {
+  int a[] = {11, -7, 3, INT_MIN, 5, 66, -1, INT_MAX, 9, 0};
+  s_radix_sort(a, 10);
+
+  for (int i = 0; i < 10; i++) {
+    printf("%d, ", a[i]);
+  }
+  printf("\n\n");
+
+  // compare against insertion sort, including inputs where some of the
+  // digit passes are skipped (small values, all equal)
+  static int arr[N], expected[N], scratch[N];
+
+  for (int round = 0; round < 4; round++) {
+    for (int i = 0; i < N; i++) {
+      switch (round) {
+        case 0: arr[i] = rand() - RAND_MAX / 2; break;
+        case 1: arr[i] = rand() % 200 - 100; break;
+        case 2: arr[i] = (rand() % 256) << 16; break;
+        case 3: arr[i] = 42; break;
+      }
+    }
+
+    memcpy(expected, arr, sizeof(arr));
+    s_insertion_sort(expected, N);
+
+    if (round % 2) s_radix_sort(arr, N);
+    else s_radix_sort_buf(arr, N, scratch);
+
+    assert(memcmp(arr, expected, sizeof(arr)) == 0);
+  }
+
+  printf("*** radix sort tests passed ***\n");
+}
@@ -1,5 +1,10 @@
 #include "sorting.h"
 
+#include <assert.h>
+#include <string.h>
+
+#define N 5000
+
 int main() {
   int a[] = {11, 7, 3, 2, 5, 66, 1, 4, 9, 8};
   s_shell_sort(a, 10);
@@ -8,4 +13,22 @@ int main() {
     printf("%d, ", a[i]);
   }
   printf("\n\n");
-}
\ No newline at end of file
+
+  // every gap sequence must agree with insertion sort
+  static int arr[N], expected[N];
+  shell_gap_t seqs[] = {
+    SHELL_GAP_CIURA, SHELL_GAP_TOKUDA, SHELL_GAP_SEDGEWICK, SHELL_GAP_PRATT
+  };
+
+  for (int s = 0; s < 4; s++) {
+    for (int i = 0; i < N; i++) arr[i] = rand() - RAND_MAX / 2;
+
+    memcpy(expected, arr, sizeof(arr));
+    s_insertion_sort(expected, N);
+    s_shell_sort_gaps(arr, N, seqs[s]);
+
+    assert(memcmp(arr, expected, sizeof(arr)) == 0);
+  }
+
+  printf("*** shell sort tests passed ***\n");
+}
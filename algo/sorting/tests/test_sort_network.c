@@ -0,0 +1,47 @@
+#include "sorting.h"
+
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+
+#define ROUNDS 2000
+
+int main() {
+  int a[] = {11, 7, 3, 2, 5, 66, 1, 4, 9, 8};
+  s_sort_network(a, 10);
+
+  for (int i = 0; i < 10; i++) {
+    printf("%d, ", a[i]);
+  }
+  printf("\n\n");
+
+  const char *names[] = {"scalar", "sse4.1", "avx2"};
+  sort_net_isa_t best = s_sort_network_isa();
+
+  // every supported kernel, on every block size, against insertion sort
+  int arr[SORT_NETWORK_MAX], expected[SORT_NETWORK_MAX];
+
+  for (sort_net_isa_t isa = SORT_NET_SCALAR; isa <= best; isa++) {
+    for (int round = 0; round < ROUNDS; round++) {
+      int size = 1 + rand() % SORT_NETWORK_MAX;
+
+      for (int i = 0; i < size; i++) {
+        switch (round % 4) {
+          case 0: arr[i] = rand() - RAND_MAX / 2; break;
+          case 1: arr[i] = rand() % 4; break;
+          case 2: arr[i] = (rand() % 2) ? INT_MAX : INT_MIN;  break;   // padding value
+          case 3: arr[i] = size - i; break;
+        }
+      }
+
+      memcpy(expected, arr, size * sizeof(int));
+      s_insertion_sort(expected, size);
+      s_sort_network_with(arr, size, isa);
+
+      assert(memcmp(arr, expected, size * sizeof(int)) == 0);
+    }
+    printf("%s kernel passed\n", names[isa]);
+  }
+
+  printf("*** sort network tests passed ***\n");
+}
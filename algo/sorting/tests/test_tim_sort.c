@@ -0,0 +1,42 @@
+#include "sorting.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define N 20000
+
+int main() {
+  int a[] = {11, 7, 3, 2, 5, 66, 1, 4, 9, 8};
+  s_tim_sort(a, 10);
+
+  for (int i = 0; i < 10; i++) {
+    printf("%d, ", a[i]);
+  }
+  printf("\n\n");
+
+  // compare against insertion sort on inputs with different run structures
+  static int arr[N], expected[N];
+
+  for (int round = 0; round < 7; round++) {
+    for (int i = 0; i < N; i++) {
+      switch (round) {
+        case 0: arr[i] = rand(); break;                          // random
+        case 1: arr[i] = i; break;                               // ascending
+        case 2: arr[i] = N - i; break;                           // descending
+        case 3: arr[i] = i < N / 2 ? i : N - i; break;           // organ pipe
+        case 4: arr[i] = rand() % 3; break;                      // few unique
+        case 5: arr[i] = (i % 1000) + (rand() % 5 == 0); break;  // sawtooth runs
+        case 6: arr[i] = i % 2 ? i : rand() % N; break;          // gallop heavy
+      }
+    }
+
+    int size = N - round * 7;    // sizes that are not a power of 2
+    memcpy(expected, arr, size * sizeof(int));
+    s_insertion_sort(expected, size);
+    s_tim_sort(arr, size);
+
+    assert(memcmp(arr, expected, size * sizeof(int)) == 0);
+  }
+
+  printf("*** tim sort tests passed ***\n");
+}
@@ -0,0 +1,443 @@
+#include "sorting.h"
+
+#include <string.h>
+
+#define MIN_MERGE   64     // arrays smaller than this are binary insertion sorted
+#define MIN_GALLOP  7      // initial no of consecutive wins to enter galloping
+#define MAX_RUNS    85     // enough pending runs for any array within int range
+
+
+/* a sorted run, waiting to be merged */
+typedef struct {
+  int base;
+  int len;
+} run_t;
+
+
+/* state shared by the merges of one sort */
+typedef struct {
+  int *arr;
+  int *tmp;            // scratch for the shorter run, atmost half the array
+  int min_gallop;      // adapts to how well galloping has been paying off
+  int run_count;
+  run_t runs[MAX_RUNS];
+} tim_state_t;
+
+
+
+/* smallest run length, such that N / minrun is a power of 2 or close to it */
+static int min_run_length(int size) {
+  int r = 0;
+
+  while (size >= MIN_MERGE) {
+    r |= size & 1;
+    size >>= 1;
+  }
+  return size + r;
+}
+
+
+
+static void reverse_range(int *arr, int lo, int hi) {
+  for (hi--; lo < hi; lo++, hi--) {
+    int tmp = arr[lo];
+    arr[lo] = arr[hi];
+    arr[hi] = tmp;
+  }
+}
+
+
+
+/* length of the run starting at lo, strictly descending runs are reversed
+   in-place. strictly, so that equal elements never swap their order */
+static int count_run(int *arr, int lo, int hi) {
+  int run = lo + 1;
+  if (run == hi) return 1;
+
+  if (S_LESS(arr[run], arr[lo])) {
+    run++;
+    while (run < hi && S_LESS(arr[run], arr[run - 1])) run++;
+    reverse_range(arr, lo, run);
+  } else {
+    run++;
+    while (run < hi && !S_LESS(arr[run], arr[run - 1])) run++;
+  }
+
+  return run - lo;
+}
+
+
+
+/* sort [lo, hi) where [lo, start) is already sorted, each new element is
+   placed after the equal ones to stay stable */
+static void binary_insertion_sort(int *arr, int lo, int hi, int start) {
+  for (int i = start; i < hi; i++) {
+    int curr = arr[i];
+    int left = lo, right = i;
+
+    while (left < right) {
+      int mid = left + (right - left) / 2;
+      if (S_LESS(curr, arr[mid])) right = mid;
+      else left = mid + 1;
+    }
+
+    memmove(&arr[left + 1], &arr[left], (i - left) * sizeof(int));
+    arr[left] = curr;
+    S_SWAP();
+  }
+}
+
+
+
+/* position to insert key in sorted arr, before any equal elements.
+   search starts at hint and gallops (1, 3, 7, 15 ...) before binary search */
+static int gallop_left(int key, const int *arr, int size, int hint) {
+  int last_ofs = 0, ofs = 1;
+
+  if (S_LESS(arr[hint], key)) {
+    // gallop right, till arr[hint + last_ofs] < key <= arr[hint + ofs]
+    int max_ofs = size - hint;
+    while (ofs < max_ofs && S_LESS(arr[hint + ofs], key)) {
+      last_ofs = ofs;
+      ofs = (ofs << 1) + 1;
+      if (ofs <= 0) ofs = max_ofs;    // int overflow
+    }
+    if (ofs > max_ofs) ofs = max_ofs;
+
+    last_ofs += hint;
+    ofs += hint;
+  } else {
+    // gallop left, till arr[hint - ofs] < key <= arr[hint - last_ofs]
+    int max_ofs = hint + 1;
+    while (ofs < max_ofs && !S_LESS(arr[hint - ofs], key)) {
+      last_ofs = ofs;
+      ofs = (ofs << 1) + 1;
+      if (ofs <= 0) ofs = max_ofs;
+    }
+    if (ofs > max_ofs) ofs = max_ofs;
+
+    int tmp = last_ofs;
+    last_ofs = hint - ofs;
+    ofs = hint - tmp;
+  }
+
+  // arr[last_ofs] < key <= arr[ofs], binary search what's left in b/w
+  last_ofs++;
+  while (last_ofs < ofs) {
+    int mid = last_ofs + ((ofs - last_ofs) >> 1);
+    if (S_LESS(arr[mid], key)) last_ofs = mid + 1;
+    else ofs = mid;
+  }
+  return ofs;
+}
+
+
+
+/* position to insert key in sorted arr, after any equal elements */
+static int gallop_right(int key, const int *arr, int size, int hint) {
+  int last_ofs = 0, ofs = 1;
+
+  if (S_LESS(key, arr[hint])) {
+    // gallop left, till arr[hint - ofs] <= key < arr[hint - last_ofs]
+    int max_ofs = hint + 1;
+    while (ofs < max_ofs && S_LESS(key, arr[hint - ofs])) {
+      last_ofs = ofs;
+      ofs = (ofs << 1) + 1;
+      if (ofs <= 0) ofs = max_ofs;
+    }
+    if (ofs > max_ofs) ofs = max_ofs;
+
+    int tmp = last_ofs;
+    last_ofs = hint - ofs;
+    ofs = hint - tmp;
+  } else {
+    // gallop right, till arr[hint + last_ofs] <= key < arr[hint + ofs]
+    int max_ofs = size - hint;
+    while (ofs < max_ofs && !S_LESS(key, arr[hint + ofs])) {
+      last_ofs = ofs;
+      ofs = (ofs << 1) + 1;
+      if (ofs <= 0) ofs = max_ofs;
+    }
+    if (ofs > max_ofs) ofs = max_ofs;
+
+    last_ofs += hint;
+    ofs += hint;
+  }
+
+  // arr[last_ofs] <= key < arr[ofs], binary search what's left in b/w
+  last_ofs++;
+  while (last_ofs < ofs) {
+    int mid = last_ofs + ((ofs - last_ofs) >> 1);
+    if (S_LESS(key, arr[mid])) ofs = mid;
+    else last_ofs = mid + 1;
+  }
+  return ofs;
+}
+
+
+
+/* merge the adjacent runs a (len1) and b (len2), where len1 <= len2.
+   a is copied to tmp and the merge fills the array from the left.
+   first element of b is smaller than all of a, last of a is larger than all of b */
+static void merge_lo(tim_state_t *ts, int *a, int len1, int *b, int len2) {
+  memcpy(ts->tmp, a, len1 * sizeof(int));
+
+  int *dest = a;
+  int *c1 = ts->tmp;
+  int *c2 = b;
+  int min_gallop = ts->min_gallop;
+
+  *dest++ = *c2++;
+  if (--len2 == 0) goto succeed;
+  if (len1 == 1) goto copy_b;
+
+  for (;;) {
+    int count1 = 0, count2 = 0;    // no of times in a row each run won
+
+    // one element at a time, till one of the runs keeps winning
+    do {
+      if (S_LESS(*c2, *c1)) {
+        *dest++ = *c2++;
+        count2++;
+        count1 = 0;
+        if (--len2 == 0) goto succeed;
+      } else {
+        *dest++ = *c1++;
+        count1++;
+        count2 = 0;
+        if (--len1 == 1) goto copy_b;
+      }
+    } while ((count1 | count2) < min_gallop);
+
+    // galloping :- find how many elements can be moved in one go
+    min_gallop++;
+    do {
+      min_gallop -= min_gallop > 1;
+
+      count1 = gallop_right(*c2, c1, len1, 0);
+      if (count1) {
+        memcpy(dest, c1, count1 * sizeof(int));
+        dest += count1;
+        c1 += count1;
+        len1 -= count1;
+        if (len1 == 1) goto copy_b;
+        if (len1 == 0) goto succeed;    // only on inconsistent comparison
+      }
+      *dest++ = *c2++;
+      if (--len2 == 0) goto succeed;
+
+      count2 = gallop_left(*c1, c2, len2, 0);
+      if (count2) {
+        memmove(dest, c2, count2 * sizeof(int));
+        dest += count2;
+        c2 += count2;
+        len2 -= count2;
+        if (len2 == 0) goto succeed;
+      }
+      *dest++ = *c1++;
+      if (--len1 == 1) goto copy_b;
+    } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+    min_gallop++;    // galloping stopped paying off, make it harder to enter
+  }
+
+succeed:
+  if (len1) memcpy(dest, c1, len1 * sizeof(int));
+  ts->min_gallop = min_gallop;
+  return;
+
+copy_b:
+  // last element of a goes after the rest of b
+  memmove(dest, c2, len2 * sizeof(int));
+  dest[len2] = *c1;
+  ts->min_gallop = min_gallop;
+}
+
+
+
+/* merge the adjacent runs a (len1) and b (len2), where len1 > len2.
+   b is copied to tmp and the merge fills the array from the right */
+static void merge_hi(tim_state_t *ts, int *a, int len1, int *b, int len2) {
+  memcpy(ts->tmp, b, len2 * sizeof(int));
+
+  int *dest = b + len2 - 1;
+  int *c1 = a + len1 - 1;
+  int *c2 = ts->tmp + len2 - 1;
+  int min_gallop = ts->min_gallop;
+
+  *dest-- = *c1--;
+  if (--len1 == 0) goto succeed;
+  if (len2 == 1) goto copy_a;
+
+  for (;;) {
+    int count1 = 0, count2 = 0;
+
+    do {
+      if (S_LESS(*c2, *c1)) {
+        *dest-- = *c1--;
+        count1++;
+        count2 = 0;
+        if (--len1 == 0) goto succeed;
+      } else {
+        *dest-- = *c2--;
+        count2++;
+        count1 = 0;
+        if (--len2 == 1) goto copy_a;
+      }
+    } while ((count1 | count2) < min_gallop);
+
+    min_gallop++;
+    do {
+      min_gallop -= min_gallop > 1;
+
+      // elements of a greater than the current b, go to the end in one go
+      count1 = len1 - gallop_right(*c2, a, len1, len1 - 1);
+      if (count1) {
+        dest -= count1;
+        c1 -= count1;
+        memmove(dest + 1, c1 + 1, count1 * sizeof(int));
+        len1 -= count1;
+        if (len1 == 0) goto succeed;
+      }
+      *dest-- = *c2--;
+      if (--len2 == 1) goto copy_a;
+
+      // elements of b not less than the current a
+      count2 = len2 - gallop_left(*c1, ts->tmp, len2, len2 - 1);
+      if (count2) {
+        dest -= count2;
+        c2 -= count2;
+        memcpy(dest + 1, c2 + 1, count2 * sizeof(int));
+        len2 -= count2;
+        if (len2 == 1) goto copy_a;
+        if (len2 == 0) goto succeed;    // only on inconsistent comparison
+      }
+      *dest-- = *c1--;
+      if (--len1 == 0) goto succeed;
+    } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+    min_gallop++;
+  }
+
+succeed:
+  if (len2) memcpy(dest - (len2 - 1), ts->tmp, len2 * sizeof(int));
+  ts->min_gallop = min_gallop;
+  return;
+
+copy_a:
+  // first element of b goes before the rest of a
+  dest -= len1;
+  c1 -= len1;
+  memmove(dest + 1, c1 + 1, len1 * sizeof(int));
+  *dest = *c2;
+  ts->min_gallop = min_gallop;
+}
+
+
+
+/* merge the runs at i and i + 1 on the stack */
+static void merge_at(tim_state_t *ts, int i) {
+  int *a = ts->arr + ts->runs[i].base;
+  int len1 = ts->runs[i].len;
+  int *b = ts->arr + ts->runs[i + 1].base;
+  int len2 = ts->runs[i + 1].len;
+
+  ts->runs[i].len = len1 + len2;
+  if (i == ts->run_count - 3) ts->runs[i + 1] = ts->runs[i + 2];
+  ts->run_count--;
+
+  // elements of a that are not greater than b's first are already in place
+  int k = gallop_right(b[0], a, len1, 0);
+  a += k;
+  len1 -= k;
+  if (len1 == 0) return;
+
+  // same for the elements of b that are not less than a's last
+  len2 = gallop_left(a[len1 - 1], b, len2, len2 - 1);
+  if (len2 == 0) return;
+
+  if (len1 <= len2) merge_lo(ts, a, len1, b, len2);
+  else merge_hi(ts, a, len1, b, len2);
+}
+
+
+
+/* keep the run lengths decreasing faster than fibonacci, so the merges stay
+   balanced and the stack stays short */
+static void merge_collapse(tim_state_t *ts) {
+  run_t *r = ts->runs;
+
+  while (ts->run_count > 1) {
+    int n = ts->run_count - 2;
+
+    if ((n > 0 && r[n - 1].len <= r[n].len + r[n + 1].len) ||
+        (n > 1 && r[n - 2].len <= r[n - 1].len + r[n].len)) {
+      if (r[n - 1].len < r[n + 1].len) n--;
+    } else if (r[n].len > r[n + 1].len) {
+      break;    // invariants hold
+    }
+
+    merge_at(ts, n);
+  }
+}
+
+
+
+static void merge_force_collapse(tim_state_t *ts) {
+  run_t *r = ts->runs;
+
+  while (ts->run_count > 1) {
+    int n = ts->run_count - 2;
+    if (n > 0 && r[n - 1].len < r[n + 1].len) n--;
+
+    merge_at(ts, n);
+  }
+}
+
+
+
+
+void s_tim_sort(int arr[], int size) {
+  if (!arr || size <= 1) return;
+
+  // small arrays, a single run extended with binary insertion
+  if (size < MIN_MERGE) {
+    int run = count_run(arr, 0, size);
+    binary_insertion_sort(arr, 0, size, run);
+    return;
+  }
+
+  tim_state_t ts;
+  ts.arr = arr;
+  ts.min_gallop = MIN_GALLOP;
+  ts.run_count = 0;
+
+  // a merge never needs more than the shorter of the two runs
+  ts.tmp = malloc((size / 2 + 1) * sizeof(int));
+  if (!ts.tmp) {
+    s_intro_sort(arr, size);    // equal ints are indistinguishable anyway
+    return;
+  }
+
+  int min_run = min_run_length(size);
+  int lo = 0;
+
+  while (lo < size) {
+    int run = count_run(arr, lo, size);
+
+    // short run, extend it to min_run (or the end of array)
+    if (run < min_run) {
+      int force = size - lo < min_run ? size - lo : min_run;
+      binary_insertion_sort(arr, lo, lo + force, lo + run);
+      run = force;
+    }
+
+    ts.runs[ts.run_count++] = (run_t){ lo, run };
+    merge_collapse(&ts);
+
+    lo += run;
+  }
+
+  merge_force_collapse(&ts);
+  free(ts.tmp);
+}
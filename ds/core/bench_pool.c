@@ -0,0 +1,142 @@
+#include "pool.h"
+
+#include <time.h>
+
+/*
+  Node churn with malloc / free versus the pool.
+  usage :- bench_pool [no of operations]     ; default is 1e7
+
+  fifo   :- a queue of L live nodes, every step frees the oldest node and
+            allocates a new one (enqueue / dequeue)
+  burst  :- allocate L nodes, then free them all (push / pop of a stack)
+  mt     :- fifo in 4 threads at once, pool_shared is a shared pool without
+            caches (a lock per call), pool_cache adds a cache per thread
+*/
+
+#define NODE_SIZE 32       // node_t of the linked lists :- element_t + next
+#define THREADS 4
+
+typedef enum { USE_MALLOC, USE_POOL, USE_CACHE } alloc_t;
+
+static const char *ALLOC_NAMES[] = {"malloc", "pool", "pool_cache"};
+
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+typedef struct {
+  alloc_t alloc;
+  pool_t *pool;
+  long ops;
+  int live;
+} job_t;
+
+
+static inline void* job_alloc(job_t *job, pool_cache_t *cache) {
+  switch (job->alloc) {
+    case USE_MALLOC: return malloc(NODE_SIZE);
+    case USE_POOL:   return pool_alloc(job->pool);
+    default:         return pool_cache_alloc(cache);
+  }
+}
+
+static inline void job_free(job_t *job, pool_cache_t *cache, void *p) {
+  switch (job->alloc) {
+    case USE_MALLOC: free(p); break;
+    case USE_POOL:   pool_free(job->pool, p); break;
+    default:         pool_cache_free(cache, p); break;
+  }
+}
+
+
+
+/* fifo churn over a ring of live nodes */
+static void* fifo(void *arg) {
+  job_t *job = arg;
+  pool_cache_t *cache = job->alloc == USE_CACHE ? pool_cache_init(job->pool) : NULL;
+
+  void **ring = malloc(job->live * sizeof(void *));
+  for (int i = 0; i < job->live; i++) ring[i] = job_alloc(job, cache);
+
+  for (long i = 0; i < job->ops; i++) {
+    int slot = (int)(i % job->live);
+    job_free(job, cache, ring[slot]);
+
+    ring[slot] = job_alloc(job, cache);
+    *(long *)ring[slot] = i;            // touch the node, like an enqueue would
+  }
+
+  for (int i = 0; i < job->live; i++) job_free(job, cache, ring[i]);
+  free(ring);
+  pool_cache_destroy(cache);
+  return NULL;
+}
+
+
+
+/* bursts of allocations, then frees */
+static void burst(job_t *job) {
+  void **nodes = malloc(job->live * sizeof(void *));
+
+  for (long done = 0; done < job->ops; done += job->live) {
+    for (int i = 0; i < job->live; i++) {
+      nodes[i] = job_alloc(job, NULL);
+      *(long *)nodes[i] = i;
+    }
+    for (int i = job->live - 1; i >= 0; i--) job_free(job, NULL, nodes[i]);
+  }
+
+  free(nodes);
+}
+
+
+
+int main(int argc, char *argv[]) {
+  long ops = argc > 1 ? atol(argv[1]) : 10000000;
+  if (ops <= 0) return 1;
+
+  int lives[] = {1000, 100000};
+
+  printf("%-8s %-12s %8s %14s\n", "pattern", "alloc", "live", "ns/(alloc+free)");
+
+  for (int l = 0; l < 2; l++) {
+    for (int a = USE_MALLOC; a <= USE_POOL; a++) {
+      job_t job = { a, a == USE_POOL ? pool_init(NODE_SIZE, 0) : NULL, ops, lives[l] };
+
+      double start = now_sec();
+      fifo(&job);
+      printf("%-8s %-12s %8d %14.2f\n", "fifo", ALLOC_NAMES[a], lives[l], (now_sec() - start) * 1e9 / ops);
+
+      start = now_sec();
+      burst(&job);
+      printf("%-8s %-12s %8d %14.2f\n", "burst", ALLOC_NAMES[a], lives[l], (now_sec() - start) * 1e9 / ops);
+
+      pool_destroy(job.pool);
+    }
+  }
+
+  // every thread does its share of the operations
+  for (int a = USE_MALLOC; a <= USE_CACHE; a++) {
+    pool_t *pool = a == USE_MALLOC ? NULL : pool_init_shared(NODE_SIZE, 0);
+    job_t jobs[THREADS];
+    pthread_t threads[THREADS];
+
+    double start = now_sec();
+    for (int t = 0; t < THREADS; t++) {
+      jobs[t] = (job_t){ a, pool, ops / THREADS, 1000 };
+      pthread_create(&threads[t], NULL, fifo, &jobs[t]);
+    }
+    for (int t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+
+    const char *name = a == USE_POOL ? "pool_shared" : ALLOC_NAMES[a];
+    printf("%-8s %-12s %8d %14.2f\n", "mt", name, 1000, (now_sec() - start) * 1e9 / ops);
+    pool_destroy(pool);
+  }
+
+  return 0;
+}
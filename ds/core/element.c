@@ -0,0 +1,346 @@
+#include "element.h"
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+
+bool el_set(element_t *ele, etype_t etype, const void *val, intern_t *intern) {
+  if (!ele || !val) return false;
+
+  switch (etype) {
+    case INT:
+      ele->value.ival = *(const int *)val;
+      break;
+
+    case FLO:
+      ele->value.fval = *(const float *)val;
+      break;
+
+    case STR: {
+      // build it aside, so a failure leaves the element untouched
+      sstr_t str;
+      if (!sstr_set_in(&str, intern, (const char *)val)) return false;
+
+      ele->value.sval = str;
+      break;
+    }
+
+    default:
+      return false;            // invalid element type
+  }
+
+  ele->etype = etype;          // update the element type
+  return true;
+}
+
+
+
+void el_clear(element_t *ele, intern_t *intern) {
+  if (!ele) return;
+
+  // free allocated memeory for string element
+  if (ele->etype == STR) sstr_free_in(&ele->value.sval, intern);
+}
+
+
+
+bool el_own(element_t *ele, intern_t *intern) {
+  if (!ele) return false;
+
+  sstr_t *str = &ele->value.sval;
+  if (!intern || ele->etype != STR || sstr_is_inline(str)) return true;
+
+  // the chars are shared through the table, copy them out
+  const char *chars = str->heap.ptr;
+  sstr_t own;
+  if (!sstr_set(&own, chars)) return false;
+
+  intern_release(intern, chars);
+  *str = own;
+  return true;
+}
+
+
+
+element_t* el_new(etype_t etype, const void *val) {
+  if (!val) return NULL;
+
+  // allocate memeory for new element
+  element_t *new_element = malloc(sizeof(element_t));
+  if (!new_element) return NULL;
+
+  if (!el_set(new_element, etype, val, NULL)) {
+    free(new_element);
+    return NULL;
+  }
+
+  return new_element;
+}
+
+
+
+void el_free(element_t *ele) {
+  if (!ele) return;
+
+  el_clear(ele, NULL);
+  free(ele);
+}
+
+
+
+bool el_key(element_t *key, etype_t etype, const void *val, intern_t *intern) {
+  if (!key || !val) return false;
+
+  switch (etype) {
+    case INT: key->value.ival = *(const int *)val; break;
+    case FLO: key->value.fval = *(const float *)val; break;
+
+    case STR:
+      if (!sstr_view_in(&key->value.sval, intern, (const char *)val)) return false;
+      break;
+
+    default:
+      return false;            // invalid element type
+  }
+
+  key->etype = etype;
+  return true;
+}
+
+
+
+/* murmur3 finalizer, spreads the bits over the whole word */
+static uint32_t el_mix(uint32_t h) {
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+
+
+uint32_t el_hash(const element_t *ele) {
+  if (!ele) return 0;
+
+  uint32_t h = 0;
+
+  switch (ele->etype) {
+    case INT:
+      h = (uint32_t)ele->value.ival;
+      break;
+
+    case FLO: {
+      // 0.0 == -0.0, so they need the same hash
+      float f = ele->value.fval == 0.0f ? 0.0f : ele->value.fval;
+      memcpy(&h, &f, sizeof(h));
+      break;
+    }
+
+    case STR: {
+      // FNV-1a over the chars, the same for an inline / heap / interned string
+      const char *c = sstr_cstr(&ele->value.sval);
+      size_t len = sstr_len(&ele->value.sval);
+
+      h = 2166136261u;
+      for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)c[i];
+        h *= 16777619u;
+      }
+      break;
+    }
+  }
+
+  return el_mix(h ^ (uint32_t)ele->etype * 0x9e3779b9u);
+}
+
+
+
+bool el_print(const element_t *ele) {
+  if (!ele) return false;
+
+  switch (ele->etype) {
+    case INT: printf("%d", ele->value.ival); break;
+    case FLO: printf("%f", ele->value.fval); break;
+    case STR: printf("\"%s\"", sstr_cstr(&ele->value.sval)); break;
+    default: return false;     // invalid element type
+  }
+
+  return true;
+}
+
+
+
+/* ---------- SIMD SCANS ---------- */
+
+/*
+  element_t is 24 bytes :- the etype in the first 4 bytes, the value 8 bytes
+  in (an int / float in its first 4 bytes). So 3 AVX2 registers hold 4
+  elements, as 24 int lanes
+
+    | etype | pad | value | . | . | . | etype | pad | value | . | . | . | ...
+        0            2                    6            8
+
+  every register is compared to a key with the etype / value at those lanes,
+  and the 3 movemasks are joined into a 24 bit mask. An element k matches
+  when both its etype bit (6k) and its value bit (6k + 2) are set
+*/
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define ELEMENT_X86
+  #include <immintrin.h>
+#endif
+
+// the simd scans depend on this layout, else the plain loops are used
+#define EL_SIMD_LAYOUT (sizeof(element_t) == 24 && sizeof(etype_t) == 4 && \
+                        offsetof(element_t, value) == 8)
+
+#define EL_TAG_LANES 0x041041u    // lanes 0, 6, 12, 18
+#define EL_VAL_LANES 0x104104u    // lanes 2, 8, 14, 20
+
+
+#ifdef ELEMENT_X86
+
+/* equal lanes of the 4 elements at p, as a 24 bit mask. ints compare
+   bitwise, floats with the ordered == (NaN never matches) */
+#define EL_LANES_AVX2(cmp, p, k0, k1, k2)                                                     \
+  ((unsigned)_mm256_movemask_ps(cmp(_mm256_loadu_si256((const __m256i *)(p)), k0))            \
+   | (unsigned)_mm256_movemask_ps(cmp(_mm256_loadu_si256((const __m256i *)(p) + 1), k1)) << 8 \
+   | (unsigned)_mm256_movemask_ps(cmp(_mm256_loadu_si256((const __m256i *)(p) + 2), k2)) << 16)
+
+__attribute__((target("avx2")))
+static inline __m256 el_cmp_i32(__m256i v, __m256i key) {
+  return _mm256_castsi256_ps(_mm256_cmpeq_epi32(v, key));
+}
+
+__attribute__((target("avx2")))
+static inline __m256 el_cmp_f32(__m256i v, __m256i key) {
+  return _mm256_cmp_ps(_mm256_castsi256_ps(v), _mm256_castsi256_ps(key), _CMP_EQ_OQ);
+}
+
+/* match bits (bit 6k for the element k) of the 4 elements at p */
+__attribute__((target("avx2")))
+static inline unsigned el_match_avx2(const element_t *p, etype_t etype, const __m256i key[3]) {
+  unsigned tag = EL_LANES_AVX2(el_cmp_i32, p, key[0], key[1], key[2]);
+  unsigned val = etype == FLO ? EL_LANES_AVX2(el_cmp_f32, p, key[0], key[1], key[2]) : tag;
+
+  return tag & EL_TAG_LANES & ((val & EL_VAL_LANES) >> 2);
+}
+
+/* key registers, the etype / value at the lanes of 4 elements */
+__attribute__((target("avx2")))
+static inline void el_key_avx2(__m256i key[3], etype_t etype, int bits) {
+  key[0] = _mm256_setr_epi32(etype, 0, bits, 0, 0, 0, etype, 0);
+  key[1] = _mm256_setr_epi32(bits, 0, 0, 0, etype, 0, bits, 0);
+  key[2] = _mm256_setr_epi32(0, 0, etype, 0, bits, 0, 0, 0);
+}
+
+/* matches among the first (size & ~3) elements */
+__attribute__((target("avx2")))
+static int el_count_avx2(const element_t *data, int size, etype_t etype, int bits) {
+  __m256i key[3];
+  el_key_avx2(key, etype, bits);
+
+  int freq0 = 0, freq1 = 0;
+  int i = 0;
+
+  for (; i + 8 <= size; i += 8) {
+    freq0 += __builtin_popcount(el_match_avx2(data + i, etype, key));
+    freq1 += __builtin_popcount(el_match_avx2(data + i + 4, etype, key));
+  }
+  for (; i + 4 <= size; i += 4) freq0 += __builtin_popcount(el_match_avx2(data + i, etype, key));
+
+  return freq0 + freq1;
+}
+
+/* index of the first match among the first (size & ~3) elements,
+   (size & ~3) if there is none */
+__attribute__((target("avx2")))
+static int el_index_avx2(const element_t *data, int size, etype_t etype, int bits) {
+  __m256i key[3];
+  el_key_avx2(key, etype, bits);
+
+  int i = 0;
+
+  for (; i + 4 <= size; i += 4) {
+    unsigned mask = el_match_avx2(data + i, etype, key);
+    if (mask) return i + __builtin_ctz(mask) / 6;
+  }
+
+  return i;
+}
+
+#endif   // ELEMENT_X86
+
+
+// resolved on the first call, -1 until then
+static atomic_int scan_avx2 = -1;
+
+/* can this scan run on the simd kernels? */
+static bool el_use_simd(etype_t etype) {
+#ifdef ELEMENT_X86
+  if (!EL_SIMD_LAYOUT || (etype != INT && etype != FLO)) return false;
+
+  int avx2 = atomic_load_explicit(&scan_avx2, memory_order_relaxed);
+  if (avx2 < 0) {
+    __builtin_cpu_init();
+    avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    atomic_store_explicit(&scan_avx2, avx2, memory_order_relaxed);
+  }
+
+  return avx2;
+#else
+  (void)etype;
+  return false;
+#endif
+}
+
+
+
+int el_count(const element_t *data, int size, const element_t *key, const intern_t *intern) {
+  if (!data || !key || size <= 0) return 0;
+
+  int freq = 0;
+  int i = 0;
+
+#ifdef ELEMENT_X86
+  // simd scan takes 4 elements at a time, the last (size % 4) are left to the loop
+  if (el_use_simd(key->etype)) {
+    int bits;
+    memcpy(&bits, &key->value, sizeof(int));
+
+    freq = el_count_avx2(data, size, key->etype, bits);
+    i = size & ~3;
+  }
+#endif
+
+  for (; i < size; i++) freq += el_match(&data[i], key, intern) ? 1 : 0;
+
+  return freq;
+}
+
+
+
+int el_index(const element_t *data, int size, const element_t *key, const intern_t *intern) {
+  if (!data || !key || size <= 0) return -1;
+
+  int i = 0;
+
+#ifdef ELEMENT_X86
+  // simd scan stops at the first match, or the last (size % 4) elements
+  if (el_use_simd(key->etype)) {
+    int bits;
+    memcpy(&bits, &key->value, sizeof(int));
+
+    i = el_index_avx2(data, size, key->etype, bits);
+  }
+#endif
+
+  for (; i < size; i++) {
+    if (el_match(&data[i], key, intern)) return i;
+  }
+
+  // if we reach here, then there is no match
+  return -1;
+}
@@ -0,0 +1,217 @@
+#ifndef __ELEMENT_HEADER__
+#define __ELEMENT_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sstr.h"
+
+/*
+Some Design Notes:
+- the tagged value, stored by every structure under ds/. the element type,
+  its lifetime (set / clear), the compares, the hash and the print are all
+  here, so a change to the value (like the inline strings) is done once
+
+- element_t is 24 bytes :- the etype, then the value 8 bytes in. a string
+  upto SSTR_INLINE chars is inside the element (see sstr.h)
+
+- the intern_t * parameters take the table of the structure (NULL, if it
+  doesn't intern). an element set with a table has to be cleared with the
+  same table
+
+- a lookup builds a key once (el_key) and compares it to every element
+  with el_match. el_count / el_index scan a whole array of elements, the
+  INT / FLO scans run on AVX2 when the cpu has it (runtime dispatch)
+
+- floats compare with the ordered == (NaN never matches, 0.0 == -0.0)
+
+usage :-
+  element_t e, key;
+  el_set(&e, STR, "hello", NULL);
+
+  if (el_key(&key, STR, "hello", NULL) && el_match(&e, &key, NULL)) ...
+
+  el_clear(&e, NULL);
+*/
+
+
+/* enum type to define the value type in union */
+typedef enum { INT, FLO, STR } etype_t;
+
+
+/* struct of an element */
+typedef struct {
+  etype_t etype;
+
+  union {
+    int ival;
+    float fval;
+    sstr_t sval;     // read the chars with sstr_cstr
+  } value;
+} element_t;
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Update the element with the value, a string is copied (or
+ *        interned, if there is a table)
+ *
+ *        time complexity  - O(1); O(N) for a string of N chars
+ *        space complexity - O(1); O(N) for a long string
+ *
+ * @param element_t - ref to element_t struct
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param const void * - pointer to the value, read based on the etype
+ * @param intern_t - intern table of the structure, can be NULL
+ * @return true
+ * @return false - invalid type or string allocation failed, the element
+ *                 is left untouched
+ */
+bool el_set(element_t *, etype_t, const void *, intern_t *);
+
+/**
+ * @brief Release the memory owned by the element (string value), the
+ *        element_t struct itself is not freed
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param element_t - ref to element_t struct
+ * @param intern_t - the table it was set with, can be NULL
+ */
+void el_clear(element_t *, intern_t *);
+
+/**
+ * @brief Give an element set with a table its own copy of the string, so
+ *        it can leave the structure (eg a pop). el_clear it with NULL after
+ *
+ *        time complexity  - O(N); N - length of the string
+ *        space complexity - O(N)
+ *
+ * @param element_t - ref to element_t struct
+ * @param intern_t - the table it was set with, can be NULL
+ * @return true
+ * @return false - out of memory, the element is left as it was
+ */
+bool el_own(element_t *, intern_t *);
+
+/**
+ * @brief Allocate an element_t and update it with the value
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param const void * - pointer to the value, read based on the etype
+ * @return element_t* - NULL, if invalid type or out of memory
+ */
+element_t* el_new(etype_t, const void *);
+
+/**
+ * @brief Release an element from el_new (or a popped copy)
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param element_t - ref to element_t struct
+ */
+void el_free(element_t *);
+
+/**
+ * @brief Make a key to look the value up with, a string is not copied.
+ *        a lookup makes the key once and compares it to every element
+ *        with el_match (or a whole array with el_count / el_index). a
+ *        string key compares its length & prefix first, and only the
+ *        pointer if the structure interns its strings. a long string not
+ *        in the table gives false, no element of the structure can match
+ *
+ *        time complexity  - O(1); O(N) for a string of N chars
+ *        space complexity - O(1)
+ *
+ * @param element_t - ref to element_t struct, for the key
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param const void * - pointer to the value, has to outlive the key
+ * @param intern_t - intern table of the structure, can be NULL
+ * @return true
+ * @return false - invalid type, or a long string not in the table, so no
+ *                 element of the structure can match
+ */
+bool el_key(element_t *, etype_t, const void *, intern_t *);
+
+/**
+ * @brief Hash of the element, equal elements have equal hashes
+ *
+ *        time complexity  - O(1); O(N) for a string of N chars
+ *        space complexity - O(1)
+ *
+ * @param element_t - ref to element_t struct
+ * @return uint32_t
+ */
+uint32_t el_hash(const element_t *);
+
+/**
+ * @brief Print the value :- 10, 2.500000 or "str"
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param element_t - ref to element_t struct
+ * @return true
+ * @return false - invalid element type, nothing printed
+ */
+bool el_print(const element_t *);
+
+/**
+ * @brief No of elements in the array matching the key
+ *
+ *        time complexity  - O(N); N - no of elements
+ *        space complexity - O(1)
+ *
+ * @param const element_t * - array of elements
+ * @param int - no of elements
+ * @param const element_t * - key from el_key
+ * @param intern_t - intern table of the structure, can be NULL
+ * @return int
+ */
+int el_count(const element_t *, int, const element_t *, const intern_t *);
+
+/**
+ * @brief Index of the first element in the array matching the key
+ *
+ *        time complexity  - O(N); N - no of elements
+ *        space complexity - O(1)
+ *
+ * @param const element_t * - array of elements
+ * @param int - no of elements
+ * @param const element_t * - key from el_key
+ * @param intern_t - intern table of the structure, can be NULL
+ * @return int - -1, if there is no match
+ */
+int el_index(const element_t *, int, const element_t *, const intern_t *);
+
+
+/* ---------- INLINE COMPARE ---------- */
+
+/* does the element match the key from el_key? same type and value, a
+   string compared with sstr_eq_in. inline, it's the inner loop of every
+   lookup */
+static inline bool el_match(const element_t *e, const element_t *key, const intern_t *tab) {
+  if (e->etype != key->etype) return false;
+
+  switch (key->etype) {
+    case INT: return e->value.ival == key->value.ival;
+    case FLO: return e->value.fval == key->value.fval;
+    case STR: return sstr_eq_in(&e->value.sval, &key->value.sval, tab);
+  }
+
+  return false;
+}
+
+
+#endif   // __ELEMENT_HEADER__
@@ -0,0 +1,177 @@
+#include "intern.h"
+
+#include <stddef.h>
+
+
+/* entry of an interned pointer */
+#define INTERN_ENTRY(s) ((intern_entry_t *)((char *)(s) - offsetof(intern_entry_t, str)))
+
+
+/* FNV-1a over the chars, the length is returned through len */
+static uint32_t intern_hash(const char *str, uint32_t *len) {
+  uint32_t hash = 2166136261u;
+  const char *c = str;
+
+  for (; *c; c++) {
+    hash ^= (unsigned char)*c;
+    hash *= 16777619u;
+  }
+
+  *len = (uint32_t)(c - str);
+  return hash;
+}
+
+
+
+intern_t* intern_init(int nbuckets) {
+  int n = INTERN_INIT_BUCKETS;
+  if (nbuckets > 0) {
+    for (n = 1; n < nbuckets; n *= 2);
+  }
+
+  intern_t *tab = malloc(sizeof(intern_t));
+  if (!tab) return NULL;
+
+  tab->buckets = calloc(n, sizeof(intern_entry_t *));
+  if (!tab->buckets) {
+    free(tab);
+    return NULL;
+  }
+
+  tab->nbuckets = n;
+  tab->count = 0;
+  return tab;
+}
+
+
+
+/* double the buckets, the entries keep their hash so nothing is rehashed */
+static void intern_grow(intern_t *tab) {
+  int n = tab->nbuckets * 2;
+
+  intern_entry_t **buckets = calloc(n, sizeof(intern_entry_t *));
+  if (!buckets) return;            // stay at the higher load
+
+  for (int b = 0; b < tab->nbuckets; b++) {
+    intern_entry_t *entry = tab->buckets[b];
+
+    while (entry) {
+      intern_entry_t *next = entry->next;
+      intern_entry_t **slot = &buckets[entry->hash & (n - 1)];
+
+      entry->next = *slot;
+      *slot = entry;
+      entry = next;
+    }
+  }
+
+  free(tab->buckets);
+  tab->buckets = buckets;
+  tab->nbuckets = n;
+}
+
+
+
+/* entry of the string, NULL if it's not interned */
+static intern_entry_t* intern_lookup(intern_t *tab, const char *str, uint32_t hash, uint32_t len) {
+  intern_entry_t *entry = tab->buckets[hash & (tab->nbuckets - 1)];
+
+  for (; entry; entry = entry->next) {
+    if (entry->hash == hash && entry->len == len && memcmp(entry->str, str, len) == 0)
+      return entry;
+  }
+
+  return NULL;
+}
+
+
+
+const char* intern_get(intern_t *tab, const char *str) {
+  if (!tab || !str) return NULL;
+
+  uint32_t len;
+  uint32_t hash = intern_hash(str, &len);
+
+  intern_entry_t *entry = intern_lookup(tab, str, hash, len);
+  if (entry) {
+    entry->refs++;
+    return entry->str;
+  }
+
+  // new string, header and the chars in one block
+  entry = malloc(sizeof(intern_entry_t) + len + 1);
+  if (!entry) return NULL;
+
+  entry->hash = hash;
+  entry->len = len;
+  entry->refs = 1;
+  memcpy(entry->str, str, len + 1);
+
+  intern_entry_t **slot = &tab->buckets[hash & (tab->nbuckets - 1)];
+  entry->next = *slot;
+  *slot = entry;
+
+  if (++tab->count > tab->nbuckets * INTERN_MAX_LOAD) intern_grow(tab);
+
+  return entry->str;
+}
+
+
+
+const char* intern_find(intern_t *tab, const char *str) {
+  if (!tab || !str) return NULL;
+
+  uint32_t len;
+  uint32_t hash = intern_hash(str, &len);
+
+  intern_entry_t *entry = intern_lookup(tab, str, hash, len);
+  return entry ? entry->str : NULL;
+}
+
+
+
+void intern_release(intern_t *tab, const char *str) {
+  if (!tab || !str) return;
+
+  intern_entry_t *entry = INTERN_ENTRY(str);
+  if (--entry->refs > 0) return;
+
+  // last reference, unlink it from its bucket
+  intern_entry_t **slot = &tab->buckets[entry->hash & (tab->nbuckets - 1)];
+  while (*slot != entry) slot = &(*slot)->next;
+
+  *slot = entry->next;
+  tab->count--;
+  free(entry);
+}
+
+
+
+int intern_refs(const char *str) {
+  return str ? INTERN_ENTRY(str)->refs : 0;
+}
+
+
+
+int intern_count(intern_t *tab) {
+  return tab ? tab->count : 0;
+}
+
+
+
+void intern_destroy(intern_t *tab) {
+  if (!tab) return;
+
+  for (int b = 0; b < tab->nbuckets; b++) {
+    intern_entry_t *entry = tab->buckets[b];
+
+    while (entry) {
+      intern_entry_t *todel = entry;
+      entry = entry->next;
+      free(todel);
+    }
+  }
+
+  free(tab->buckets);
+  free(tab);
+}
@@ -0,0 +1,151 @@
+#ifndef __INTERN_HEADER__
+#define __INTERN_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define INTERN_INIT_BUCKETS  64     // buckets of a new table, a power of 2
+#define INTERN_MAX_LOAD      1      // grow once strings > buckets * this
+
+/*
+Some Design Notes:
+- table of unique strings, every string is stored once with a refcount.
+  intern_get gives the same pointer for equal strings, so two interned
+  strings are equal iff the pointers are equal (no strcmp)
+
+- chained hash table (FNV-1a), the chars are in the entry itself, right
+  after the header, so a string is one allocation. the table doubles once
+  the no of strings goes past the no of buckets
+
+- intern_get adds a reference, every intern_get has to be paired with an
+  intern_release. the string is removed once its last reference is gone
+
+- intern_find doesn't add a reference. it's for the lookups :- if a string
+  is not in the table, no structure using the table can hold it
+
+- not thread safe, like the structures using it
+
+usage :-
+  intern_t *tab = intern_init(0);
+
+  darray_t *a = da_init();
+  da_use_intern(a, tab);            // both the arrays share the strings
+  darray_t *b = da_init();
+  da_use_intern(b, tab);
+  ...
+  da_free(a);
+  da_free(b);
+  intern_destroy(tab);              // after the structures using it
+*/
+
+
+/* entry of a string, the chars follow the header */
+typedef struct intern_entry {
+  struct intern_entry *next;  // next entry in the bucket
+  uint32_t hash;
+  uint32_t len;
+  int refs;                   // no of intern_get's not yet released
+  char str[];
+} intern_entry_t;
+
+
+/* struct to define the intern table */
+typedef struct {
+  intern_entry_t **buckets;
+  int nbuckets;               // power of 2
+  int count;                  // no of unique strings
+} intern_t;
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Create an empty intern table
+ *
+ *        time complexity  - O(B); B - no of buckets
+ *        space complexity - O(B)
+ *
+ * @param int - no of buckets to start with, rounded upto a power of 2
+ *              (INTERN_INIT_BUCKETS, if <= 0)
+ * @return intern_t*
+ */
+intern_t* intern_init(int);
+
+/**
+ * @brief Get the interned copy of the string, added if it's not there.
+ *        adds a reference
+ *
+ *        time complexity  - O(N); N - length of the string, amortized
+ *        space complexity - O(N), for a new string
+ *
+ * @param intern_t - ref to intern_t struct
+ * @param const char * - NUL terminated string
+ * @return const char* - NULL, if out of memory
+ */
+const char* intern_get(intern_t *, const char *);
+
+/**
+ * @brief Find the interned copy of the string, without adding it or
+ *        a reference
+ *
+ *        time complexity  - O(N); N - length of the string
+ *        space complexity - O(1)
+ *
+ * @param intern_t - ref to intern_t struct
+ * @param const char * - NUL terminated string
+ * @return const char* - NULL, if the string is not interned
+ */
+const char* intern_find(intern_t *, const char *);
+
+/**
+ * @brief Drop a reference of an interned string, the string is removed
+ *        with its last reference
+ *
+ *        time complexity  - O(1); average
+ *        space complexity - O(1)
+ *
+ * @param intern_t - ref to intern_t struct
+ * @param const char * - pointer from intern_get, NULL is ignored
+ */
+void intern_release(intern_t *, const char *);
+
+/**
+ * @brief No of references of an interned string
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param const char * - pointer from intern_get
+ * @return int
+ */
+int intern_refs(const char *);
+
+/**
+ * @brief No of unique strings in the table
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param intern_t - ref to intern_t struct
+ * @return int
+ */
+int intern_count(intern_t *);
+
+/**
+ * @brief Release the table and all the strings, every interned pointer is
+ *        invalid after
+ *
+ *        time complexity  - O(B + S); B - no of buckets, S - no of strings
+ *        space complexity - O(1)
+ *
+ * @param intern_t - ref to intern_t struct
+ */
+void intern_destroy(intern_t *);
+
+
+#endif   // __INTERN_HEADER__
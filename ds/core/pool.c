@@ -0,0 +1,248 @@
+#include "pool.h"
+
+
+static pool_t* pool_create(size_t obj_size, int chunk_objs, bool shared) {
+  if (obj_size == 0) return NULL;
+
+  pool_t *pool = malloc(sizeof(pool_t));
+  if (!pool) return NULL;
+
+  // a free slot has to hold the free list link
+  if (obj_size < sizeof(void *)) obj_size = sizeof(void *);
+
+  // round upto the pointer alignment
+  pool->obj_size = (obj_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  pool->chunk_objs = chunk_objs > 0 ? chunk_objs : POOL_CHUNK_OBJS;
+  pool->capacity = 0;
+  pool->in_use = 0;
+
+  pool->free_list = NULL;
+  pool->bump = NULL;
+  pool->bump_end = NULL;
+  pool->chunks = NULL;
+
+  pool->shared = shared;
+  if (shared && pthread_mutex_init(&pool->lock, NULL) != 0) {
+    free(pool);
+    return NULL;
+  }
+
+  return pool;
+}
+
+
+
+pool_t* pool_init(size_t obj_size, int chunk_objs) {
+  return pool_create(obj_size, chunk_objs, false);
+}
+
+
+
+pool_t* pool_init_shared(size_t obj_size, int chunk_objs) {
+  return pool_create(obj_size, chunk_objs, true);
+}
+
+
+
+/* ---------- UNLOCKED INTERNALS ---------- */
+
+/* add a chunk, its slots are handed out through the bump pointer */
+static bool pool_grow(pool_t *pool) {
+  int objs = pool->chunk_objs;
+
+  pool_chunk_t *chunk = malloc(sizeof(pool_chunk_t) + objs * pool->obj_size);
+  if (!chunk) return false;
+
+  chunk->next = pool->chunks;
+  pool->chunks = chunk;
+
+  pool->bump = (char *)(chunk + 1);
+  pool->bump_end = pool->bump + objs * pool->obj_size;
+  pool->capacity += objs;
+
+  // next chunk is twice the size
+  if (objs < POOL_MAX_CHUNK_OBJS) pool->chunk_objs = objs * 2;
+  return true;
+}
+
+
+
+static void* pool_take(pool_t *pool) {
+  void *slot = pool->free_list;
+
+  // reuse a freed slot first, it's likely still in the cache
+  if (slot) {
+    pool->free_list = *(void **)slot;
+  } else {
+    if (pool->bump == pool->bump_end && !pool_grow(pool)) return NULL;
+
+    slot = pool->bump;
+    pool->bump += pool->obj_size;
+  }
+
+  pool->in_use++;
+  return slot;
+}
+
+
+
+static void pool_give(pool_t *pool, void *slot) {
+  *(void **)slot = pool->free_list;
+  pool->free_list = slot;
+  pool->in_use--;
+}
+
+
+
+/* ---------- POOL ---------- */
+
+void* pool_alloc(pool_t *pool) {
+  if (!pool) return NULL;
+
+  if (!pool->shared) return pool_take(pool);
+
+  pthread_mutex_lock(&pool->lock);
+  void *slot = pool_take(pool);
+  pthread_mutex_unlock(&pool->lock);
+
+  return slot;
+}
+
+
+
+void pool_free(pool_t *pool, void *slot) {
+  if (!pool || !slot) return;
+
+  if (!pool->shared) {
+    pool_give(pool, slot);
+    return;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  pool_give(pool, slot);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+
+
+void* pool_get(pool_t *pool, size_t size) {
+  if (!pool) return malloc(size);
+
+  // object doesn't fit in a slot
+  if (size > pool->obj_size) return NULL;
+
+  return pool_alloc(pool);
+}
+
+
+
+void pool_put(pool_t *pool, void *obj) {
+  if (!pool) free(obj);
+  else pool_free(pool, obj);
+}
+
+
+
+int pool_in_use(pool_t *pool) {
+  return pool ? pool->in_use : 0;
+}
+
+
+
+void pool_destroy(pool_t *pool) {
+  if (!pool) return;
+
+  pool_chunk_t *chunk = pool->chunks;
+  while (chunk) {
+    pool_chunk_t *todel = chunk;
+    chunk = chunk->next;
+    free(todel);
+  }
+
+  if (pool->shared) pthread_mutex_destroy(&pool->lock);
+  free(pool);
+}
+
+
+
+/* ---------- PER THREAD CACHE ---------- */
+
+pool_cache_t* pool_cache_init(pool_t *pool) {
+  if (!pool) return NULL;
+
+  pool_cache_t *cache = malloc(sizeof(pool_cache_t));
+  if (!cache) return NULL;
+
+  cache->pool = pool;
+  cache->list = NULL;
+  cache->count = 0;
+  return cache;
+}
+
+
+
+void* pool_cache_alloc(pool_cache_t *cache) {
+  if (!cache) return NULL;
+
+  // empty, take a batch from the pool under a single lock
+  if (!cache->list) {
+    pool_t *pool = cache->pool;
+
+    if (pool->shared) pthread_mutex_lock(&pool->lock);
+    for (int i = 0; i < POOL_CACHE_BATCH; i++) {
+      void *slot = pool_take(pool);
+      if (!slot) break;
+
+      *(void **)slot = cache->list;
+      cache->list = slot;
+      cache->count++;
+    }
+    if (pool->shared) pthread_mutex_unlock(&pool->lock);
+
+    if (!cache->list) return NULL;
+  }
+
+  void *slot = cache->list;
+  cache->list = *(void **)slot;
+  cache->count--;
+  return slot;
+}
+
+
+
+/* give n slots from the front of the cache back to the pool */
+static void pool_cache_flush(pool_cache_t *cache, int n) {
+  pool_t *pool = cache->pool;
+
+  if (pool->shared) pthread_mutex_lock(&pool->lock);
+  for (int i = 0; i < n && cache->list; i++) {
+    void *slot = cache->list;
+    cache->list = *(void **)slot;
+    cache->count--;
+
+    pool_give(pool, slot);
+  }
+  if (pool->shared) pthread_mutex_unlock(&pool->lock);
+}
+
+
+
+void pool_cache_free(pool_cache_t *cache, void *slot) {
+  if (!cache || !slot) return;
+
+  *(void **)slot = cache->list;
+  cache->list = slot;
+  cache->count++;
+
+  // keep one batch, so alternating alloc / free doesn't hit the pool
+  if (cache->count >= 2 * POOL_CACHE_BATCH) pool_cache_flush(cache, POOL_CACHE_BATCH);
+}
+
+
+
+void pool_cache_destroy(pool_cache_t *cache) {
+  if (!cache) return;
+
+  pool_cache_flush(cache, cache->count);
+  free(cache);
+}
@@ -0,0 +1,225 @@
+#ifndef __POOL_HEADER__
+#define __POOL_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#define POOL_CHUNK_OBJS      64       // slots in the first chunk
+#define POOL_MAX_CHUNK_OBJS  65536    // chunks double in size upto this
+#define POOL_CACHE_BATCH     32       // slots moved between a cache and its pool
+
+/*
+Some Design Notes:
+- fixed size object allocator, for the nodes of the linked structures. the
+  memory comes in chunks (one malloc for many slots) and a freed slot goes
+  onto a free list, so the next alloc is a pointer pop instead of a malloc
+
+- a new chunk is twice the size of the last one (upto POOL_MAX_CHUNK_OBJS),
+  its slots are handed out from the front as needed, so the pages of a big
+  chunk are not touched till they are used
+
+- chunks are only released by pool_destroy, a pool keeps its peak footprint
+
+- slots are only aligned to the pointer size (the slot size is rounded
+  upto it, not to max_align_t, so small nodes don't grow), and are atleast
+  a pointer in size (a free slot holds the link to the next free slot). an
+  object needing a wider alignment can't come from a pool
+
+- a pool from pool_init is not thread safe, like the structures using it.
+  pool_init_shared gives a pool guarded by a mutex, and every thread can put
+  a pool_cache_t in front of it, which takes / gives back the slots in
+  batches of POOL_CACHE_BATCH, so the lock is taken once per batch
+
+- pool_get / pool_put take a NULL pool and fall back to malloc / free, so a
+  structure can use a pool optionally
+
+usage :-
+  pool_t *pool = pool_init(sizeof(node_t), POOL_CHUNK_OBJS);
+
+  linkedlist_t *a = ll_init_pool(pool);     // both the lists share the pool
+  linkedlist_t *b = ll_init_pool(pool);
+  ...
+  ll_free(a);
+  ll_free(b);
+  pool_destroy(pool);                       // after the structures using it
+*/
+
+
+/* chunk of slots, the slots follow the header */
+typedef struct pool_chunk {
+  struct pool_chunk *next;
+  size_t pad;              // header of 16 bytes, the first slot is aligned like malloc
+} pool_chunk_t;
+
+
+/* struct to define the pool */
+typedef struct {
+  size_t obj_size;         // slot size, rounded upto the pointer alignment
+  int chunk_objs;          // no of slots in the next chunk
+  int capacity;            // no of slots in all the chunks
+  int in_use;              // no of slots handed out (caches count as in use)
+
+  void *free_list;         // freed slots, linked through their first word
+  char *bump;              // next never used slot of the newest chunk
+  char *bump_end;          // end of the newest chunk
+  pool_chunk_t *chunks;    // all the chunks, newest first
+
+  bool shared;             // guarded by the lock?
+  pthread_mutex_t lock;
+} pool_t;
+
+
+/* per thread cache in front of a shared pool */
+typedef struct {
+  pool_t *pool;
+  void *list;              // cached free slots
+  int count;               // no of cached slots
+} pool_cache_t;
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Create a pool of fixed size slots, no memory is taken for the
+ *        slots till the first alloc
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param size_t - size of an object
+ * @param int - no of slots in the first chunk (POOL_CHUNK_OBJS, if <= 0)
+ * @return pool_t*
+ */
+pool_t* pool_init(size_t, int);
+
+/**
+ * @brief Same as pool_init, but the pool can be used from many threads
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param size_t - size of an object
+ * @param int - no of slots in the first chunk (POOL_CHUNK_OBJS, if <= 0)
+ * @return pool_t*
+ */
+pool_t* pool_init_shared(size_t, int);
+
+/**
+ * @brief Take a slot from the pool
+ *
+ *        time complexity  - O(1); amortized, a new chunk is a malloc
+ *        space complexity - O(1)
+ *
+ * @param pool_t - ref to pool_t struct
+ * @return void* - NULL, if out of memory
+ */
+void* pool_alloc(pool_t *);
+
+/**
+ * @brief Give the slot back to the pool, it must have come from this pool
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param pool_t - ref to pool_t struct
+ * @param void * - slot to release, NULL is ignored
+ */
+void pool_free(pool_t *, void *);
+
+/**
+ * @brief Allocate from the pool, or with malloc if there is no pool
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param pool_t - ref to pool_t struct, can be NULL
+ * @param size_t - size of the object, has to fit in a slot of the pool
+ * @return void*
+ */
+void* pool_get(pool_t *, size_t);
+
+/**
+ * @brief Release an object from pool_get, to the pool or with free
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param pool_t - ref to pool_t struct, can be NULL
+ * @param void * - object to release
+ */
+void pool_put(pool_t *, void *);
+
+/**
+ * @brief No of slots handed out and not yet given back
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param pool_t - ref to pool_t struct
+ * @return int
+ */
+int pool_in_use(pool_t *);
+
+/**
+ * @brief Release all the chunks, every slot from the pool is invalid after
+ *
+ *        time complexity  - O(C); C - no of chunks
+ *        space complexity - O(1)
+ *
+ * @param pool_t - ref to pool_t struct
+ */
+void pool_destroy(pool_t *);
+
+
+/* ---------- PER THREAD CACHE ---------- */
+
+/**
+ * @brief Create a cache for the calling thread, in front of a shared pool
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param pool_t - ref to a pool from pool_init_shared
+ * @return pool_cache_t*
+ */
+pool_cache_t* pool_cache_init(pool_t *);
+
+/**
+ * @brief Take a slot from the cache, refilled from the pool when empty
+ *
+ *        time complexity  - O(1); amortized
+ *        space complexity - O(1)
+ *
+ * @param pool_cache_t - ref to pool_cache_t struct
+ * @return void*
+ */
+void* pool_cache_alloc(pool_cache_t *);
+
+/**
+ * @brief Give a slot to the cache, the extra slots go back to the pool.
+ *        slot can be from any cache of the same pool
+ *
+ *        time complexity  - O(1); amortized
+ *        space complexity - O(1)
+ *
+ * @param pool_cache_t - ref to pool_cache_t struct
+ * @param void * - slot to release, NULL is ignored
+ */
+void pool_cache_free(pool_cache_t *, void *);
+
+/**
+ * @brief Give all the cached slots back to the pool and release the cache
+ *
+ *        time complexity  - O(N); N - no of cached slots
+ *        space complexity - O(1)
+ *
+ * @param pool_cache_t - ref to pool_cache_t struct
+ */
+void pool_cache_destroy(pool_cache_t *);
+
+
+#endif   // __POOL_HEADER__
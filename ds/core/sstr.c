@@ -0,0 +1,123 @@
+#include "sstr.h"
+
+
+/* fill s with the n chars at str, the chars are copied only if they fit
+   inline. a heap string points at str */
+static void sstr_make(sstr_t *s, const char *str, size_t n) {
+  // zero the unused bytes, the compares depend on it
+  s->words[0] = 0;
+  s->words[1] = 0;
+
+  if (n <= SSTR_INLINE) {
+    if (n) memcpy(s->small, str, n);
+    s->small[SSTR_INLINE] = (char)(SSTR_INLINE - n);
+    return;
+  }
+
+  s->heap.ptr = (char *)str;
+  s->heap.len = (uint32_t)n;
+  memcpy(s->heap.prefix, str, sizeof(s->heap.prefix));
+  s->heap.tag = SSTR_HEAP;
+}
+
+
+
+bool sstr_set(sstr_t *s, const char *str) {
+  if (!s) return false;
+
+  size_t n = str ? strlen(str) : 0;
+  if (n > UINT32_MAX) {
+    sstr_make(s, NULL, 0);
+    return false;
+  }
+
+  sstr_make(s, str, n);
+  if (sstr_is_inline(s)) return true;
+
+  // long string, the chars go on the heap
+  char *chars = malloc(n + 1);
+  if (!chars) {
+    sstr_make(s, NULL, 0);
+    return false;
+  }
+
+  memcpy(chars, str, n + 1);
+  s->heap.ptr = chars;
+  return true;
+}
+
+
+
+void sstr_view(sstr_t *s, const char *str) {
+  if (!s) return;
+
+  size_t n = str ? strlen(str) : 0;
+  sstr_make(s, str, n > UINT32_MAX ? 0 : n);
+}
+
+
+
+void sstr_free(sstr_t *s) {
+  if (!s) return;
+
+  if (!sstr_is_inline(s)) free(s->heap.ptr);
+  sstr_make(s, NULL, 0);
+}
+
+
+
+bool sstr_set_in(sstr_t *s, intern_t *tab, const char *str) {
+  if (!tab) return sstr_set(s, str);
+  if (!s) return false;
+
+  sstr_view(s, str);
+  if (sstr_is_inline(s)) return true;
+
+  // long string, the chars are shared through the table
+  const char *chars = intern_get(tab, str);
+  if (!chars) {
+    sstr_make(s, NULL, 0);
+    return false;
+  }
+
+  s->heap.ptr = (char *)chars;
+  return true;
+}
+
+
+
+bool sstr_view_in(sstr_t *s, intern_t *tab, const char *str) {
+  sstr_view(s, str);
+  if (!tab || !s || sstr_is_inline(s)) return true;
+
+  const char *chars = intern_find(tab, str);
+  if (!chars) return false;
+
+  s->heap.ptr = (char *)chars;
+  return true;
+}
+
+
+
+void sstr_free_in(sstr_t *s, intern_t *tab) {
+  if (!tab) {
+    sstr_free(s);
+    return;
+  }
+  if (!s) return;
+
+  if (!sstr_is_inline(s)) intern_release(tab, s->heap.ptr);
+  sstr_make(s, NULL, 0);
+}
+
+
+
+int sstr_cmp(const sstr_t *a, const sstr_t *b) {
+  size_t alen = sstr_len(a), blen = sstr_len(b);
+
+  int order = memcmp(sstr_cstr(a), sstr_cstr(b), alen < blen ? alen : blen);
+  if (order != 0) return order;
+
+  // one is a prefix of the other, shorter comes first
+  return (alen > blen) - (alen < blen);
+}
@@ -0,0 +1,217 @@
+#ifndef __SSTR_HEADER__
+#define __SSTR_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "intern.h"
+
+#define SSTR_INLINE  15       // longest string stored inside the struct
+#define SSTR_HEAP    0xFF     // tag of a string on the heap
+
+/*
+Some Design Notes:
+- string of the element_t's, 16 bytes. a string upto SSTR_INLINE chars is
+  stored in the struct itself (no malloc), a longer one on the heap
+
+- the last byte is the tag :-
+    inline :- SSTR_INLINE - len, so a 15 char string has a tag of 0 which
+              is also its NUL terminator
+    heap   :- SSTR_HEAP
+
+      inline | c c c c c c c c | c c c c c c c tag |
+      heap   |      ptr        |  len  | pfx | tag |
+
+  the pointer takes all the first 8 bytes on a 32 bit target too, so the
+  tag stays at small[15]
+
+- the second 8 bytes of the struct are a "fingerprint" of the string. for an
+  inline string it's the chars 8..14 and the length, for a heap string the
+  length and the first 3 chars. two strings with different fingerprints
+  are not equal, so most of the mismatches are rejected on one compare,
+  without reading the chars on the heap
+
+- the unused bytes of an inline string are always 0, so two inline strings
+  are equal iff both the 8 byte halves are equal
+
+- sstr_view makes a key to compare against, without copying the chars.
+  it borrows the string, and must not be passed to sstr_free
+
+- the _in functions take an intern table (see intern.h), the chars of a
+  heap string come from the table instead of a malloc. every long string in
+  a structure using a table is interned, so two of them are equal iff the
+  pointers are equal, and sstr_eq_in is two word compares for any length.
+  a NULL table falls back to the plain functions
+
+usage :-
+  sstr_t s;
+  sstr_set(&s, "hello");            // inline, no allocation
+  printf("%s\n", sstr_cstr(&s));
+
+  sstr_t key;
+  sstr_view(&key, "hello");
+  sstr_eq(&s, &key);                // true
+
+  sstr_free(&s);
+*/
+
+
+/* struct to define the string */
+typedef union {
+  char small[SSTR_INLINE + 1];   // inline chars, small[15] is the tag
+
+  struct {
+    union {
+      char *ptr;                 // NUL terminated chars
+      uint64_t ptr_bits;         // 8 bytes wide, whatever the pointer size
+    };
+    uint32_t len;
+    char prefix[3];              // first 3 chars
+    uint8_t tag;                 // SSTR_HEAP
+  } heap;
+
+  uint64_t words[2];             // for the compares
+} sstr_t;
+
+_Static_assert(offsetof(sstr_t, heap.tag) == SSTR_INLINE && sizeof(sstr_t) == 16,
+               "sstr_t layout :- the tag has to be the last of 16 bytes");
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Copy the string into s, inline if it fits. s is overwritten, it
+ *        doesn't release what s held before
+ *
+ *        time complexity  - O(N); N - length of the string
+ *        space complexity - O(N), if it doesn't fit inline else O(1)
+ *
+ * @param sstr_t - ref to sstr_t struct
+ * @param const char * - NUL terminated string
+ * @return true
+ * @return false - out of memory, s is left empty
+ */
+bool sstr_set(sstr_t *, const char *);
+
+/**
+ * @brief Make a key of the string, for sstr_eq. a long string is borrowed,
+ *        not copied. don't sstr_free the key
+ *
+ *        time complexity  - O(N); N - length of the string
+ *        space complexity - O(1)
+ *
+ * @param sstr_t - ref to sstr_t struct
+ * @param const char * - NUL terminated string, has to outlive the key
+ */
+void sstr_view(sstr_t *, const char *);
+
+/**
+ * @brief Release the heap chars (if any), s is an empty string after
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param sstr_t - ref to sstr_t struct
+ */
+void sstr_free(sstr_t *);
+
+/**
+ * @brief Same as sstr_set, but a long string is interned in the table
+ *
+ *        time complexity  - O(N); N - length of the string
+ *        space complexity - O(N), for a long string not in the table yet
+ *
+ * @param sstr_t - ref to sstr_t struct
+ * @param intern_t - ref to intern_t struct, NULL for a plain sstr_set
+ * @param const char * - NUL terminated string
+ * @return true
+ * @return false - out of memory, s is left empty
+ */
+bool sstr_set_in(sstr_t *, intern_t *, const char *);
+
+/**
+ * @brief Make a key of the string, for sstr_eq_in. a long string is
+ *        looked up in the table, not added
+ *
+ *        time complexity  - O(N); N - length of the string
+ *        space complexity - O(1)
+ *
+ * @param sstr_t - ref to sstr_t struct
+ * @param intern_t - ref to intern_t struct, NULL for a plain sstr_view
+ * @param const char * - NUL terminated string
+ * @return true
+ * @return false - long string not in the table, so it can't match any
+ *                 string set with this table
+ */
+bool sstr_view_in(sstr_t *, intern_t *, const char *);
+
+/**
+ * @brief Release a string from sstr_set_in, s is an empty string after
+ *
+ *        time complexity  - O(1); average
+ *        space complexity - O(1)
+ *
+ * @param sstr_t - ref to sstr_t struct
+ * @param intern_t - the table it was set with, NULL for a plain sstr_free
+ */
+void sstr_free_in(sstr_t *, intern_t *);
+
+/**
+ * @brief Order of the strings, like strcmp
+ *
+ *        time complexity  - O(N); N - length of the string
+ *        space complexity - O(1)
+ *
+ * @param sstr_t - ref to sstr_t struct
+ * @param sstr_t - ref to sstr_t struct
+ * @return int - < 0, 0 or > 0
+ */
+int sstr_cmp(const sstr_t *, const sstr_t *);
+
+
+/* ---------- INLINE ACCESSORS ---------- */
+
+/* is the string stored in the struct? */
+static inline bool sstr_is_inline(const sstr_t *s) {
+  return (uint8_t)s->small[SSTR_INLINE] != SSTR_HEAP;
+}
+
+/* length of the string, O(1) */
+static inline size_t sstr_len(const sstr_t *s) {
+  return sstr_is_inline(s) ? SSTR_INLINE - (size_t)s->small[SSTR_INLINE] : s->heap.len;
+}
+
+/* NUL terminated chars, valid till the string is freed or set again */
+static inline const char* sstr_cstr(const sstr_t *s) {
+  return sstr_is_inline(s) ? s->small : s->heap.ptr;
+}
+
+/* are both the strings equal? mismatched lengths and prefixes are rejected
+   on the fingerprint, without touching the heap. inline, it's the inner
+   loop of the STR lookups */
+static inline bool sstr_eq(const sstr_t *a, const sstr_t *b) {
+  // length, prefix and the storage, in one compare
+  if (a->words[1] != b->words[1]) return false;
+
+  if (sstr_is_inline(a)) return a->words[0] == b->words[0];
+
+  // same length and prefix, the rest is on the heap
+  return a->heap.ptr == b->heap.ptr || memcmp(a->heap.ptr, b->heap.ptr, a->heap.len) == 0;
+}
+
+/* sstr_eq for the strings of a table, an interned string is equal only
+   to itself. with a NULL table it's sstr_eq */
+static inline bool sstr_eq_in(const sstr_t *a, const sstr_t *b, const intern_t *tab) {
+  if (!tab) return sstr_eq(a, b);
+
+  return a->words[0] == b->words[0] && a->words[1] == b->words[1];
+}
+
+
+#endif   // __SSTR_HEADER__
@@ -0,0 +1,166 @@
+#ifndef __STRESS_HEADER__
+#define __STRESS_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+
+/*
+Some Design Notes:
+- multi threaded stress run for the tests of the concurrent structures,
+  header only, included by the test_*.c files (not a library)
+
+- P producer threads put the values 0 .. P * per_thread - 1, producer id
+  owns the values from id * per_thread, in increasing order. C consumer
+  threads take values till all of them are taken. a full / empty
+  structure is retried after a sched_yield
+
+- stress_run asserts that every value is taken exactly once and the sum
+  adds up. for a fifo structure, it also asserts that a consumer sees the
+  values of one producer in the order they were put
+
+- the structure is reached through callbacks on an int value. attach /
+  detach give a thread its own context (a handle), NULL to use the shared
+  structure in every thread
+
+usage :-
+  static bool put(void *q, int v) { return mpmc_enqueue(q, INT, &v); }
+  static bool take(void *q, int *v) { ... }
+
+  stress_t st = { .shared = q, .put = put, .take = take,
+                  .producers = 4, .consumers = 4, .per_thread = 50000, .fifo = true };
+  stress_run(&st);
+*/
+
+
+/* the structure under test, and the shape of the run */
+typedef struct {
+  void *shared;                      // structure, passed to attach / put / take
+  void* (*attach)(void *);           // context of a thread, NULL to use shared
+  void (*detach)(void *);            // release the context, can be NULL
+  bool (*put)(void *, int);          // false, if full
+  bool (*take)(void *, int *);       // false, if empty
+
+  int producers;
+  int consumers;
+  int per_thread;                    // values put by every producer
+  bool fifo;                         // check the per producer order
+} stress_t;
+
+
+/* state of one thread */
+typedef struct {
+  const stress_t *st;
+  int id;
+  atomic_int *taken;                 // no of values taken by all the consumers
+  unsigned char *seen;               // how many times each value was taken
+  long long sum;
+} stress_arg_t;
+
+
+
+static void* stress_context(const stress_t *st) {
+  return st->attach ? st->attach(st->shared) : st->shared;
+}
+
+
+
+static void stress_release(const stress_t *st, void *ctx) {
+  if (st->attach && st->detach) st->detach(ctx);
+}
+
+
+
+static void* stress_producer(void *p) {
+  stress_arg_t *arg = p;
+  const stress_t *st = arg->st;
+  void *ctx = stress_context(st);
+  assert(ctx);
+
+  for (int i = 0; i < st->per_thread; i++) {
+    while (!st->put(ctx, arg->id * st->per_thread + i)) sched_yield();
+  }
+
+  stress_release(st, ctx);
+  return NULL;
+}
+
+
+
+static void* stress_consumer(void *p) {
+  stress_arg_t *arg = p;
+  const stress_t *st = arg->st;
+  int total = st->producers * st->per_thread;
+  void *ctx = stress_context(st);
+  assert(ctx);
+
+  int *last = malloc(st->producers * sizeof(int));
+  assert(last);
+  for (int i = 0; i < st->producers; i++) last[i] = -1;
+
+  int v;
+  while (atomic_load(arg->taken) < total) {
+    if (!st->take(ctx, &v)) {
+      sched_yield();
+      continue;
+    }
+    atomic_fetch_add(arg->taken, 1);
+    assert(v >= 0 && v < total);
+
+    // a consumer sees the values of one producer in the order they were put
+    int producer = v / st->per_thread;
+    if (st->fifo) assert(v > last[producer]);
+    last[producer] = v;
+
+    arg->seen[v]++;
+    arg->sum += v;
+  }
+
+  free(last);
+  stress_release(st, ctx);
+  return NULL;
+}
+
+
+
+/* run the producers & consumers till every value is taken, and check them */
+static void stress_run(const stress_t *st) {
+  int threads = st->producers + st->consumers;
+  int total = st->producers * st->per_thread;
+
+  unsigned char *seen = calloc(total, 1);
+  pthread_t *tids = malloc(threads * sizeof(pthread_t));
+  stress_arg_t *args = malloc(threads * sizeof(stress_arg_t));
+  atomic_int taken = 0;
+  assert(seen && tids && args);
+
+  // consumers first, so they wait on an empty structure too
+  for (int i = 0; i < threads; i++) {
+    bool consumer = i < st->consumers;
+    args[i] = (stress_arg_t){ st, consumer ? i : i - st->consumers, &taken, seen, 0 };
+    int rc = pthread_create(&tids[i], NULL, consumer ? stress_consumer : stress_producer,
+                            &args[i]);
+    assert(rc == 0);
+    (void)rc;
+  }
+
+  long long sum = 0;
+  for (int i = 0; i < threads; i++) {
+    pthread_join(tids[i], NULL);
+    sum += args[i].sum;
+  }
+
+  // every value was taken exactly once, and the checksum adds up
+  for (int v = 0; v < total; v++) assert(seen[v] == 1);
+  assert(sum == (long long)total * (total - 1) / 2);
+
+  free(seen);
+  free(tids);
+  free(args);
+}
+
+#endif   // __STRESS_HEADER__
@@ -0,0 +1,158 @@
+#include "element.h"
+
+// Helper function to print test results
+void print_test_result(const char *test_name, bool result)
+{
+  printf("%s: %s\n", test_name, result ? "PASS" : "FAIL");
+}
+
+// set / clear of every type, a failed set leaves the element untouched
+void test_el_set()
+{
+  element_t e;
+  int ival = 42;
+  float fval = 2.5f;
+
+  bool result = el_set(&e, INT, &ival, NULL) && e.etype == INT && e.value.ival == 42;
+  result = result && el_set(&e, FLO, &fval, NULL) && e.etype == FLO && e.value.fval == 2.5f;
+  result = result && !el_set(&e, (etype_t)7, &ival, NULL) && e.etype == FLO;
+  result = result && !el_set(&e, INT, NULL, NULL);
+
+  result = result && el_set(&e, STR, "a long string, not inline", NULL) &&
+           e.etype == STR && strcmp(sstr_cstr(&e.value.sval), "a long string, not inline") == 0;
+  el_clear(&e, NULL);
+
+  print_test_result("test_el_set", result);
+}
+
+// keys match the equal elements only, across the types too
+void test_el_match()
+{
+  element_t i, f, s, key;
+  int ival = 7;
+  float fval = 7.0f, nzero = -0.0f, zero = 0.0f;
+
+  el_set(&i, INT, &ival, NULL);
+  el_set(&f, FLO, &fval, NULL);
+  el_set(&s, STR, "seven", NULL);
+
+  bool result = el_key(&key, INT, &ival, NULL) && el_match(&i, &key, NULL) && !el_match(&f, &key, NULL);
+  result = result && el_key(&key, FLO, &fval, NULL) && el_match(&f, &key, NULL) && !el_match(&i, &key, NULL);
+  result = result && el_key(&key, STR, "seven", NULL) && el_match(&s, &key, NULL);
+  result = result && el_key(&key, STR, "eight", NULL) && !el_match(&s, &key, NULL);
+
+  // 0.0 == -0.0
+  el_set(&f, FLO, &nzero, NULL);
+  result = result && el_key(&key, FLO, &zero, NULL) && el_match(&f, &key, NULL);
+
+  el_clear(&s, NULL);
+  print_test_result("test_el_match", result);
+}
+
+// equal elements hash equal, however the string is stored
+void test_el_hash()
+{
+  intern_t *tab = intern_init(0);
+  element_t a, b, c, d, key;
+  float zero = 0.0f, nzero = -0.0f;
+  const char *lng = "a long string, stored on the heap";
+
+  el_set(&a, FLO, &zero, NULL);
+  el_set(&b, FLO, &nzero, NULL);
+  bool result = el_hash(&a) == el_hash(&b);
+
+  el_set(&a, STR, lng, NULL);
+  el_set(&b, STR, lng, tab);
+  el_key(&key, STR, lng, NULL);
+  result = result && el_hash(&a) == el_hash(&b) && el_hash(&a) == el_hash(&key);
+
+  el_set(&c, STR, "short", NULL);
+  el_set(&d, STR, "shorT", NULL);
+  result = result && el_hash(&c) != el_hash(&d);
+
+  el_clear(&a, NULL);
+  el_clear(&b, tab);
+  el_clear(&c, NULL);
+  el_clear(&d, NULL);
+  result = result && intern_count(tab) == 0;
+
+  print_test_result("test_el_hash", result);
+  intern_destroy(tab);
+}
+
+// count / index over mixed types, sizes not a multiple of 4 (simd + tail)
+void test_el_count_index()
+{
+  element_t data[23];
+  bool result = true;
+
+  for (int n = 0; n <= 23; n++)
+  {
+    // INT i % 3, a FLO in every 5th slot, the same bits as the INT 1
+    for (int i = 0; i < n; i++)
+    {
+      int ival = i % 3;
+      float fval = 1.0f;
+      if (i % 5 == 4) el_set(&data[i], FLO, &fval, NULL);
+      else el_set(&data[i], INT, &ival, NULL);
+    }
+
+    int one = 1, freq = 0, first = -1;
+    for (int i = 0; i < n; i++)
+    {
+      if (data[i].etype == INT && data[i].value.ival == 1)
+      {
+        freq++;
+        if (first < 0) first = i;
+      }
+    }
+
+    element_t key;
+    el_key(&key, INT, &one, NULL);
+    result = result && el_count(data, n, &key, NULL) == freq && el_index(data, n, &key, NULL) == first;
+
+    int nflo = 0;
+    float fone = 1.0f;
+    for (int i = 0; i < n; i++) nflo += i % 5 == 4;
+    el_key(&key, FLO, &fone, NULL);
+    result = result && el_count(data, n, &key, NULL) == nflo &&
+             el_index(data, n, &key, NULL) == (n > 4 ? 4 : -1);
+  }
+
+  print_test_result("test_el_count_index", result);
+}
+
+// an interned element gets its own copy, the table reference is dropped
+void test_el_own()
+{
+  intern_t *tab = intern_init(0);
+  element_t e;
+  const char *lng = "customer-000123-record";
+
+  el_set(&e, STR, lng, tab);
+  const char *shared = e.value.sval.heap.ptr;
+
+  bool result = el_own(&e, tab) && e.value.sval.heap.ptr != shared &&
+                intern_count(tab) == 0 && strcmp(sstr_cstr(&e.value.sval), lng) == 0;
+  el_clear(&e, NULL);
+
+  element_t *n = el_new(STR, "heap element");
+  result = result && n && strcmp(sstr_cstr(&n->value.sval), "heap element") == 0;
+  el_free(n);
+
+  print_test_result("test_el_own", result);
+  intern_destroy(tab);
+}
+
+// Main function to run all tests
+int main()
+{
+  test_el_set();
+  test_el_match();
+  test_el_hash();
+  test_el_count_index();
+  test_el_own();
+
+  printf("*** All tests completed ***\n");
+  return 0;
+}
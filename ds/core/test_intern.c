@@ -0,0 +1,131 @@
+#include "sstr.h"
+
+// Helper function to print test results
+void print_test_result(const char *test_name, bool result)
+{
+  printf("%s: %s\n", test_name, result ? "PASS" : "FAIL");
+}
+
+// equal strings give the same pointer, with a reference each
+void test_intern_get()
+{
+  intern_t *tab = intern_init(0);
+  char buf[32] = "shared";
+
+  const char *a = intern_get(tab, "shared");
+  const char *b = intern_get(tab, buf);
+  const char *c = intern_get(tab, "other");
+
+  bool result = a && a == b && a != buf && a != c && strcmp(a, "shared") == 0 &&
+                intern_refs(a) == 2 && intern_refs(c) == 1 && intern_count(tab) == 2;
+
+  print_test_result("test_intern_get", result);
+  intern_destroy(tab);
+}
+
+// find doesn't add the string, nor a reference
+void test_intern_find()
+{
+  intern_t *tab = intern_init(0);
+  const char *a = intern_get(tab, "present");
+
+  bool result = intern_find(tab, "present") == a && intern_refs(a) == 1 &&
+                intern_find(tab, "absent") == NULL && intern_count(tab) == 1;
+
+  print_test_result("test_intern_find", result);
+  intern_destroy(tab);
+}
+
+// the string goes away with its last reference
+void test_intern_release()
+{
+  intern_t *tab = intern_init(0);
+  const char *a = intern_get(tab, "gone");
+  intern_get(tab, "gone");
+
+  intern_release(tab, a);
+  bool result = intern_find(tab, "gone") == a && intern_count(tab) == 1;
+
+  intern_release(tab, a);
+  result = result && intern_find(tab, "gone") == NULL && intern_count(tab) == 0;
+
+  print_test_result("test_intern_release", result);
+  intern_destroy(tab);
+}
+
+// the table grows, every string is still found
+void test_intern_grow()
+{
+  intern_t *tab = intern_init(2);
+  const char *ptrs[1000];
+  char buf[32];
+  bool result = true;
+
+  for (int i = 0; i < 1000; i++)
+  {
+    snprintf(buf, sizeof(buf), "string-%d", i);
+    ptrs[i] = intern_get(tab, buf);
+  }
+
+  for (int i = 0; i < 1000; i++)
+  {
+    snprintf(buf, sizeof(buf), "string-%d", i);
+    result = result && intern_find(tab, buf) == ptrs[i];
+  }
+
+  result = result && intern_count(tab) == 1000 && tab->nbuckets >= 1000;
+
+  // remove every other one
+  for (int i = 0; i < 1000; i += 2) intern_release(tab, ptrs[i]);
+  for (int i = 0; i < 1000; i++)
+  {
+    snprintf(buf, sizeof(buf), "string-%d", i);
+    result = result && (intern_find(tab, buf) != NULL) == (i % 2 == 1);
+  }
+
+  print_test_result("test_intern_grow", result && intern_count(tab) == 500);
+  intern_destroy(tab);
+}
+
+// long sstr's of a table share the chars, and compare on the pointer
+void test_sstr_in()
+{
+  intern_t *tab = intern_init(0);
+  sstr_t a, b, c, small, key;
+
+  sstr_set_in(&a, tab, "customer-000123-record");
+  sstr_set_in(&b, tab, "customer-000123-record");
+  sstr_set_in(&c, tab, "customer-000124-record");
+  sstr_set_in(&small, tab, "short");
+
+  bool result = a.heap.ptr == b.heap.ptr && intern_count(tab) == 2 &&
+                sstr_is_inline(&small) &&
+                sstr_eq_in(&a, &b, tab) && !sstr_eq_in(&a, &c, tab);
+
+  // a key of a string not in the table can't match
+  result = result && sstr_view_in(&key, tab, "customer-000123-record") && sstr_eq_in(&key, &a, tab) &&
+           !sstr_view_in(&key, tab, "customer-999999-record") &&
+           sstr_view_in(&key, tab, "short") && sstr_eq_in(&key, &small, tab);
+
+  sstr_free_in(&a, tab);
+  sstr_free_in(&b, tab);
+  sstr_free_in(&c, tab);
+  sstr_free_in(&small, tab);
+  result = result && intern_count(tab) == 0;
+
+  print_test_result("test_sstr_in", result);
+  intern_destroy(tab);
+}
+
+// Main function to run all tests
+int main()
+{
+  test_intern_get();
+  test_intern_find();
+  test_intern_release();
+  test_intern_grow();
+  test_sstr_in();
+
+  printf("*** All tests completed ***\n");
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include "pool.h"
+
+#include <string.h>
+#include <stdint.h>
+
+// Helper function to print test results
+void print_test_result(const char *test_name, bool result)
+{
+  printf("%s: %s\n", test_name, result ? "PASS" : "FAIL");
+}
+
+// Test for pool_init, slots are rounded up for the free list link
+void test_pool_init()
+{
+  pool_t *pool = pool_init(3, 0);
+  bool result = pool && pool->obj_size == sizeof(void *) && pool->chunk_objs == POOL_CHUNK_OBJS &&
+                pool->capacity == 0 && pool_init(0, 4) == NULL;
+
+  pool_t *odd = pool_init(13, 4);
+  result = result && odd->obj_size % sizeof(void *) == 0 && odd->obj_size >= 13;
+
+  print_test_result("test_pool_init", result);
+  pool_destroy(pool);
+  pool_destroy(odd);
+}
+
+// slots are distinct, aligned and writable over the chunk boundaries
+void test_pool_alloc()
+{
+  pool_t *pool = pool_init(24, 4);
+  char *slots[100];
+  bool result = true;
+
+  for (int i = 0; i < 100; i++)
+  {
+    slots[i] = pool_alloc(pool);
+    result = result && slots[i] && (uintptr_t)slots[i] % sizeof(void *) == 0;
+    memset(slots[i], i, 24);
+  }
+
+  for (int i = 0; i < 100; i++)
+    for (int b = 0; b < 24; b++) result = result && slots[i][b] == (char)i;
+
+  // chunks of 4, 8, 16, 32, 64 slots
+  result = result && pool_in_use(pool) == 100 && pool->capacity == 124;
+
+  print_test_result("test_pool_alloc", result);
+  pool_destroy(pool);
+}
+
+// freed slots are reused, before the pool grows
+void test_pool_reuse()
+{
+  pool_t *pool = pool_init(32, 8);
+  void *a = pool_alloc(pool);
+  void *b = pool_alloc(pool);
+  pool_free(pool, a);
+  pool_free(pool, b);
+
+  // last freed is the first reused
+  bool result = pool_alloc(pool) == b && pool_alloc(pool) == a && pool_in_use(pool) == 2;
+
+  for (int r = 0; r < 1000; r++) pool_free(pool, pool_alloc(pool));
+  result = result && pool->capacity == 8;
+
+  print_test_result("test_pool_reuse", result);
+  pool_destroy(pool);
+}
+
+// pool_get / pool_put fall back to malloc / free
+void test_pool_get_put()
+{
+  void *m = pool_get(NULL, 100);
+  pool_put(NULL, m);
+
+  pool_t *pool = pool_init(16, 0);
+  void *p = pool_get(pool, 16);
+  bool result = m && p && pool_get(pool, 17) == NULL && pool_in_use(pool) == 1;
+  pool_put(pool, p);
+
+  print_test_result("test_pool_get_put", result && pool_in_use(pool) == 0);
+  pool_destroy(pool);
+}
+
+
+/* ---------- SHARED POOL ---------- */
+
+#define THREADS 4
+#define ROUNDS 20000
+
+static void* churn(void *arg)
+{
+  pool_cache_t *cache = pool_cache_init((pool_t *)arg);
+  long *live[64];
+  long bad = 0;
+
+  for (int r = 0; r < ROUNDS; r++)
+  {
+    int n = r % 64 + 1;
+    for (int i = 0; i < n; i++)
+    {
+      live[i] = pool_cache_alloc(cache);
+      *live[i] = (long)r * 64 + i;
+    }
+
+    // another thread writing the same slot would show up here
+    for (int i = 0; i < n; i++)
+    {
+      bad += *live[i] != (long)r * 64 + i;
+      pool_cache_free(cache, live[i]);
+    }
+  }
+
+  pool_cache_destroy(cache);
+  return (void *)bad;
+}
+
+// threads with their own cache, over one shared pool
+void test_pool_shared()
+{
+  pool_t *pool = pool_init_shared(sizeof(long), 0);
+  pthread_t threads[THREADS];
+
+  for (int t = 0; t < THREADS; t++) pthread_create(&threads[t], NULL, churn, pool);
+
+  long bad = 0;
+  for (int t = 0; t < THREADS; t++)
+  {
+    void *ret;
+    pthread_join(threads[t], &ret);
+    bad += (long)ret;
+  }
+
+  // every cache gave its slots back
+  print_test_result("test_pool_shared", bad == 0 && pool_in_use(pool) == 0);
+  pool_destroy(pool);
+}
+
+// Main function to run all tests
+int main()
+{
+  test_pool_init();
+  test_pool_alloc();
+  test_pool_reuse();
+  test_pool_get_put();
+  test_pool_shared();
+
+  printf("*** All tests completed ***\n");
+  return 0;
+}
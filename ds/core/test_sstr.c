@@ -0,0 +1,121 @@
+#include "sstr.h"
+
+// Helper function to print test results
+void print_test_result(const char *test_name, bool result)
+{
+  printf("%s: %s\n", test_name, result ? "PASS" : "FAIL");
+}
+
+// struct stays 16 bytes, the tag overlaps the last inline char
+void test_sstr_layout()
+{
+  print_test_result("test_sstr_layout", sizeof(sstr_t) == 16);
+}
+
+// upto SSTR_INLINE chars are stored inline, with the length cached
+void test_sstr_inline()
+{
+  sstr_t empty, s, full;
+  bool result = sstr_set(&empty, "") && sstr_set(&s, "hello") &&
+                sstr_set(&full, "0123456789abcde");
+
+  result = result && sstr_is_inline(&empty) && sstr_len(&empty) == 0 &&
+           strcmp(sstr_cstr(&empty), "") == 0;
+
+  result = result && sstr_is_inline(&s) && sstr_len(&s) == 5 &&
+           strcmp(sstr_cstr(&s), "hello") == 0;
+
+  // 15 chars, the tag is the NUL
+  result = result && sstr_is_inline(&full) && sstr_len(&full) == SSTR_INLINE &&
+           strcmp(sstr_cstr(&full), "0123456789abcde") == 0;
+
+  print_test_result("test_sstr_inline", result);
+  sstr_free(&empty);
+  sstr_free(&s);
+  sstr_free(&full);
+}
+
+// longer strings go on the heap, and are copied
+void test_sstr_heap()
+{
+  char buf[64] = "0123456789abcdef and more";
+  sstr_t s;
+
+  bool result = sstr_set(&s, buf) && !sstr_is_inline(&s) &&
+                sstr_len(&s) == strlen(buf) && sstr_cstr(&s) != buf;
+
+  buf[0] = 'X';
+  result = result && strcmp(sstr_cstr(&s), "0123456789abcdef and more") == 0;
+
+  // freed string is an empty one
+  sstr_free(&s);
+  result = result && sstr_is_inline(&s) && sstr_len(&s) == 0;
+
+  print_test_result("test_sstr_heap", result);
+}
+
+// equality on the mix of inline / heap, lengths and prefixes
+void test_sstr_eq()
+{
+  sstr_t a, b, c, long_a, long_b, long_c, key;
+  sstr_set(&a, "apple");
+  sstr_set(&b, "apple");
+  sstr_set(&c, "apply");
+  sstr_set(&long_a, "a string longer than fifteen");
+  sstr_set(&long_b, "a string longer than fifteen");
+  sstr_set(&long_c, "a string longer than fifteeN");
+
+  bool result = sstr_eq(&a, &b) && !sstr_eq(&a, &c) &&
+                sstr_eq(&long_a, &long_b) && !sstr_eq(&long_a, &long_c) &&
+                !sstr_eq(&a, &long_a);
+
+  // a view borrows the chars, and compares like a copy
+  sstr_view(&key, "a string longer than fifteen");
+  result = result && sstr_eq(&key, &long_a) && !sstr_eq(&key, &long_c);
+
+  sstr_view(&key, "apple");
+  result = result && sstr_eq(&key, &a) && !sstr_eq(&key, &c);
+
+  print_test_result("test_sstr_eq", result);
+  sstr_free(&a);
+  sstr_free(&b);
+  sstr_free(&c);
+  sstr_free(&long_a);
+  sstr_free(&long_b);
+  sstr_free(&long_c);
+}
+
+// ordering matches strcmp
+void test_sstr_cmp()
+{
+  const char *strs[] = {"", "a", "ab", "b", "abcdefghijklmnop", "abcdefghijklmnoq", "abc"};
+  int n = sizeof(strs) / sizeof(strs[0]);
+  bool result = true;
+
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+    {
+      sstr_t a, b;
+      sstr_view(&a, strs[i]);
+      sstr_view(&b, strs[j]);
+
+      int want = strcmp(strs[i], strs[j]);
+      int got = sstr_cmp(&a, &b);
+      result = result && (want > 0) == (got > 0) && (want < 0) == (got < 0);
+    }
+
+  print_test_result("test_sstr_cmp", result);
+}
+
+// Main function to run all tests
+int main()
+{
+  test_sstr_layout();
+  test_sstr_inline();
+  test_sstr_heap();
+  test_sstr_eq();
+  test_sstr_cmp();
+
+  printf("*** All tests completed ***\n");
+  return 0;
+}
@@ -1,11 +1,21 @@
 #include "clinked_list.h"
 
 
+static node_t* cll_make_node(pool_t *, etype_t, void *);
+
+
 clinkedlist_t* cll_init() {
+  return cll_init_pool(NULL);
+}
+
+
+
+clinkedlist_t* cll_init_pool(pool_t *pool) {
   clinkedlist_t *cll = malloc(sizeof(clinkedlist_t));
   if (!cll) return NULL;
 
   cll->head = NULL;
+  cll->pool = pool;
   return cll;
 }
 
@@ -15,7 +25,7 @@ bool cll_append(clinkedlist_t *cll, etype_t etype, void *val) {
   if (!cll || !val) return false;
 
   // create a node and update it with the value
-  node_t *new_node = cll_new_node(etype, val);
+  node_t *new_node = cll_make_node(cll->pool, etype, val);
   if (!new_node) return false;
 
   // does the circlar linked list is empty?
@@ -67,7 +77,7 @@ bool cll_insert(clinkedlist_t *cll, int idx, etype_t etype, void *val) {
   }
 
   // creat a new node and update with value
-  node_t *new_node = cll_new_node(etype, val);
+  node_t *new_node = cll_make_node(cll->pool, etype, val);
   if (!new_node) return false;
 
   // linked list not empty: insertion at the beginning 
@@ -80,7 +90,7 @@ bool cll_insert(clinkedlist_t *cll, int idx, etype_t etype, void *val) {
   // get the node; one before the idx positon
   node_t *prev_node = cll_get(cll, idx - 1);
   if (!prev_node) {
-    cll_free_node(new_node);
+    cll_recycle_node(cll, new_node);
     return false;
   }
 
@@ -103,26 +113,14 @@ bool cll_insert(clinkedlist_t *cll, int idx, etype_t etype, void *val) {
 int cll_count(clinkedlist_t *cll, etype_t etype, void *val) {
   if (!cll || !cll->head || !val) return 0;
 
+  element_t key;
+  if (!el_key(&key, etype, val, NULL)) return 0;
+
   node_t *curr = cll->head->next;
   int freq = 0;
 
   do {
-    switch (etype) {
-      case INT:
-        freq += curr->data.value.ival == *(int *)val ? 1 : 0;
-        break;
-
-      case FLO:
-        freq += curr->data.value.fval == *(float *)val ? 1 : 0;
-        break;
-
-      case STR:
-        freq += strcmp(curr->data.value.sval, (char *)val) == 0 ? 1 : 0;
-        break;
-
-      default:
-        return 0;
-    }
+    freq += el_match(&curr->data, &key, NULL) ? 1 : 0;
 
     curr = curr->next;
   } while (curr != cll->head->next);
@@ -134,29 +132,14 @@ int cll_count(clinkedlist_t *cll, etype_t etype, void *val) {
 int cll_index(clinkedlist_t *cll, etype_t etype, void *val) {
   if (!cll || !cll->head || !val) return -1;
 
+  element_t key;
+  if (!el_key(&key, etype, val, NULL)) return -1;
+
   node_t *curr = cll->head->next;
   int idx = 0;
 
   do {
-    switch (etype) {
-      case INT: {
-        if (curr->data.value.ival == *(int *)val) return idx;
-        break;
-      }
-
-      case FLO: {
-        if (curr->data.value.fval == *(float *)val) return idx;
-        break;
-      }
-
-      case STR: {
-        if (strcmp(curr->data.value.sval, (char *)val) == 0) return idx;
-        break;
-      }
-
-      default:   // invalid element type found
-        return -1;
-    }
+    if (el_match(&curr->data, &key, NULL)) return idx;
 
     idx++;
     curr = curr->next;
@@ -193,27 +176,16 @@ node_t* cll_pop(clinkedlist_t *cll) {
 bool cll_remove(clinkedlist_t *cll, etype_t etype, void *val) {
   if (!cll || !val || !cll->head) return false;
 
+  element_t key;
+  if (!el_key(&key, etype, val, NULL)) return false;
+
   node_t *curr = cll->head->next;
   node_t *prev = NULL;
 
   do {
     bool is_match = false;
 
-    switch (etype) {
-      case INT:
-        is_match = ( curr->data.value.ival == *(int *)val );
-        break;
-
-      case FLO:
-        is_match = ( curr->data.value.fval == *(float *)val );
-        break;
-
-      case STR:
-        is_match =  ( strcmp(curr->data.value.sval, (char *)val) == 0 );
-        break;
-
-      default: return false;    // invalid element type
-    }
+    is_match = el_match(&curr->data, &key, NULL);
 
     if (is_match) {
       if (!prev) {
@@ -235,7 +207,7 @@ bool cll_remove(clinkedlist_t *cll, etype_t etype, void *val) {
       }
 
       // free the node to be removed
-      cll_free_node(curr);
+      cll_recycle_node(cll, curr);
       return true;
     }
 
@@ -275,7 +247,7 @@ void cll_free(clinkedlist_t *cll) {
   do {
     node_t *todel = curr;
     curr = curr->next;
-    cll_free_node(todel);
+    cll_recycle_node(cll, todel);
   } while (curr != start);
 
   // finally free the linkedlist_t struct
@@ -292,12 +264,7 @@ void cll_print(clinkedlist_t *cll) {
   printf("[");
 
   do {
-    switch (curr->data.etype) {
-      case INT: printf("%d", curr->data.value.ival); break;
-      case FLO: printf("%f", curr->data.value.fval); break;
-      case STR: printf("\"%s\"", curr->data.value.sval); break;
-      default: return;    // invalid element type
-    }
+    if (!el_print(&curr->data)) return;    // invalid element type
     curr = curr->next;
 
     if (curr != cll->head->next) printf(", ");
@@ -307,53 +274,51 @@ void cll_print(clinkedlist_t *cll) {
 
 
 
-node_t* cll_new_node(etype_t etype, void *val) {
+/* allocate the node from the pool (malloc, if there is no pool) */
+static node_t* cll_make_node(pool_t *pool, etype_t etype, void *val) {
   if (!val) return NULL;
 
-  node_t *new_node = malloc(sizeof(node_t));
+  node_t *new_node = pool_get(pool, sizeof(node_t));
   if (!new_node) return NULL;
 
   // update the node with the value
   new_node->next = NULL;
 
-  switch (etype) {
-    case INT:
-      // typecast void pointer to int pointer (int *) and then de-reference *
-      new_node->data.value.ival = *(int *)val;
-      break;
-
-    case FLO: 
-      new_node->data.value.fval = *(float *)val; 
-      break;
-
-    case STR: {
-      new_node->data.value.sval = strdup( (char *)val );
-      if (!new_node->data.value.sval) {
-        cll_free_node(new_node);
-        return NULL;
-      }
-      break;
-    }
-
-    default:
-      // if we reach here, then invalid etype is passed in
-      // release the memory of new node and return
-      cll_free_node(new_node);
-      return NULL;
+  if (!el_set(&new_node->data, etype, val, NULL)) {
+    // invalid etype or out of memory
+    pool_put(pool, new_node);
+    return NULL;
   }
-  new_node->data.etype = etype;  // update the value type
 
   return new_node;
 }
 
 
 
+node_t* cll_new_node(etype_t etype, void *val) {
+  return cll_make_node(NULL, etype, val);
+}
+
+
+
 void cll_free_node(node_t *n) {
   if (!n) return;
 
-  // if node's value is string, then free it
-  if (n->data.etype == STR) free(n->data.value.sval);
+  // release the value (a string is freed)
+  el_clear(&n->data, NULL);
 
   // free the node
   free(n);
-}
\ No newline at end of file
+}
+
+
+
+void cll_recycle_node(clinkedlist_t *cll, node_t *n) {
+  if (!n) return;
+
+  // release the value (a string is freed)
+  el_clear(&n->data, NULL);
+
+  // give the node back to the allocator it came from
+  pool_put(cll ? cll->pool : NULL, n);
+}
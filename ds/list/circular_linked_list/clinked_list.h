@@ -19,21 +19,8 @@
 #include <stdbool.h>
 #include <string.h>
 
-
-/* struct represent the permitted element types */
-typedef enum { INT, FLO, STR } etype_t;
-
-
-/* struct used as info part in the node */
-typedef struct {
-  int etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
+#include "pool.h"
+#include "element.h"
 
 
 /* struct defines a single node */
@@ -47,6 +34,7 @@ typedef struct node {
 /* struct to define a cirtular linked list */
 typedef struct {
   node_t *head;         // refer to the tail position of the lined list
+  pool_t *pool;         // allocator for the nodes, NULL to use malloc
 } clinkedlist_t;
 
 
@@ -66,6 +54,18 @@ typedef struct {
  */
 clinkedlist_t* cll_init();
 
+/**
+ * @brief Same as cll_init, but the nodes are allocated from the pool.
+ *        pool can be shared by many lists, and must outlive them
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param pool_t* - pool of sizeof(node_t) slots, NULL to use malloc
+ * @return clinkedlist_t* 
+ */
+clinkedlist_t* cll_init_pool(pool_t *);
+
 /**
  * @brief Loop though the linked list and retun the node at the index posiiton
  * 
@@ -146,7 +146,8 @@ int cll_index(clinkedlist_t *, etype_t, void *);
  * 
  * @param linkedlist_t* - reference to linkedlist_t struct 
  * @return node_t* - returns the last node, NULL if not present
- *                   user has to take care of freeing the memory of popped node
+ *                   release it with cll_recycle_node, cll_free_node is an
+ *                   invalid free for a node from a pool
  */
 node_t* cll_pop(clinkedlist_t *);
 
@@ -215,9 +216,21 @@ node_t* cll_new_node(etype_t, void *);
 
 /**
  * @brief Free the node. if the node's value is string, then free the string too
+ *        only for the nodes from cll_new_node, or a list without a pool
  * 
  * @param node_t* - pointer to node_t struct
  */
 void cll_free_node(node_t *);
 
+/**
+ * @brief Free a node of the list, back to the allocator it came from
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param clinkedlist_t* - ref to clinkedlist_t struct the node came from
+ * @param node_t* - pointer to node_t struct
+ */
+void cll_recycle_node(clinkedlist_t *, node_t *);
+
 #endif   // __CIRCULAR_LINKED_LIST__
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "dlinked_list.h"
+
+#include <time.h>
+
+/*
+  Regression bench for the tail / size kept in dlinkedlist_t :- building a
+  list with dll_append is linear, so the ns per append stays flat as the
+  list grows (it grew with N when every append walked to the last node).
+  dll_pop takes the tail, flat too
+  usage :- bench_dlinked_list [largest no of elements]     ; default is 1e6
+*/
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+static void report(const char *op, int n, long ops, double elapsed) {
+  printf("%-12s %10d %12ld %10.2f\n", op, n, ops, elapsed * 1e9 / ops);
+}
+
+
+
+int main(int argc, char *argv[]) {
+  int max = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (max <= 0) return 1;
+
+  printf("%-12s %10s %12s %10s\n", "operation", "size", "ops", "ns/op");
+
+  for (int n = max / 100 > 0 ? max / 100 : 1; n <= max; n *= 10) {
+    dlinkedlist_t *dll = dll_init();
+    if (!dll) return 1;
+
+    double start = now_sec();
+    for (int i = 0; i < n; i++) dll_append(dll, INT, &i);
+    report("append", n, n, now_sec() - start);
+
+    // size and the last node, O(1) each
+    long long sum = 0;
+    int calls = 1000000;
+    start = now_sec();
+    for (int i = 0; i < calls; i++) sum += dll_size(dll) + dll_last_node(dll)->data.value.ival;
+    report("size_last", n, calls, now_sec() - start);
+
+    // pops take the tail, O(1)
+    int pops = n < 100 ? n : 100;
+    start = now_sec();
+    for (int i = 0; i < pops; i++) dll_free_node(dll_pop(dll));
+    report("pop", n, pops, now_sec() - start);
+
+    if (sum == 42) puts("");    // keep the size loop
+    dll_free(dll);
+  }
+
+  return 0;
+}
@@ -1,40 +1,58 @@
 #include "dlinked_list.h"
 
 
+static node_t* dll_make_node(pool_t *, intern_t *, etype_t, void *);
+
+
 
 dlinkedlist_t* dll_init() {
+  return dll_init_pool(NULL);
+}
+
+
+
+dlinkedlist_t* dll_init_pool(pool_t *pool) {
   dlinkedlist_t *dll = malloc(sizeof(dlinkedlist_t));
   if (!dll) return NULL;
 
   // initialize the value
   dll->head = NULL;
+  dll->tail = NULL;
+  dll->size = 0;
+  dll->pool = pool;
+  dll->intern = NULL;
   return dll;
 }
 
 
 
+bool dll_use_intern(dlinkedlist_t *dll, intern_t *intern) {
+  if (!dll || dll->head) return false;
+
+  dll->intern = intern;
+  return true;
+}
+
+
+
 bool dll_append(dlinkedlist_t *dll, etype_t etype, void *val) {
   if (!dll || !val) return false;
 
   // creat a node and update it with the value
-  node_t *new_node = dll_new_node(etype, val);
+  node_t *new_node = dll_make_node(dll->pool, dll->intern, etype, val);
   if (!new_node) return false;
 
   // double linked list has no nodes
   if (dll->head == NULL) {
     dll->head = new_node;
-    return true;
   }
-
-  // double linked list has nodes
-  node_t *last_node = dll_last_node(dll);
-  if (!last_node) {
-    dll_free_node(new_node);    // free the memory of the new node
-    return false;
+  else {
+    dll->tail->next = new_node;   // update the next node ref in last node
+    new_node->prev = dll->tail;   // update the prev node ref in new last node
   }
 
-  last_node->next = new_node;   // update the next node ref in last node
-  new_node->prev = last_node;   // update the prev node ref in new last node
+  dll->tail = new_node;
+  dll->size++;
   return true;
 }
 
@@ -52,8 +70,11 @@ bool dll_insert(dlinkedlist_t *dll, int idx, etype_t etype, void *val) {
       return false;
   }
 
+  // insertion at the end, no walk needed
+  if (idx == dll->size) return dll_append(dll, etype, val);
+
   // create a new node and update it with value
-  node_t *new_node = dll_new_node(etype, val);
+  node_t *new_node = dll_make_node(dll->pool, dll->intern, etype, val);
   if (!new_node) return false;
 
   // insertion at the head position
@@ -62,27 +83,37 @@ bool dll_insert(dlinkedlist_t *dll, int idx, etype_t etype, void *val) {
     new_node->next = dll->head;  // update new node with the next node ref
 
     dll->head = new_node;        // finally update the head node with new node
+    dll->size++;
     return true;
   }
 
   // get the node, which is at the insert positon
   node_t *idx_node = dll_get(dll, idx);
   if (!idx_node) {
-    dll_free_node(new_node);
+    dll_recycle_node(dll, new_node);
     return false;
   }
 
   // insert the new node by moving the idx node right
   new_node->prev = idx_node->prev;      // update the new node's prev ref
   new_node->next = idx_node;            // update the new node's next ref
+  idx_node->prev->next = new_node;      // update the prev node's next ref
   idx_node->prev = new_node;            // update the idx node's prev ref
+  dll->size++;
   return true;
 }
 
 
 
 node_t* dll_get(dlinkedlist_t *dll, int idx) {
-  if (!dll || idx < 0) return NULL;
+  if (!dll || idx < 0 || idx >= dll->size) return NULL;
+
+  // in the second half, walk back from the tail
+  if (idx >= dll->size / 2) {
+    node_t *curr = dll->tail;
+    for (int i = dll->size - 1; i > idx; i--) curr = curr->prev;
+    return curr;
+  }
 
   node_t *curr = dll->head;
 
@@ -100,26 +131,14 @@ node_t* dll_get(dlinkedlist_t *dll, int idx) {
 int dll_count(dlinkedlist_t *dll, etype_t etype, void *val) {
   if (!dll || !dll->head || !val) return 0;
 
+  element_t key;
+  if (!el_key(&key, etype, val, dll->intern)) return 0;
+
   node_t *curr = dll->head;
   int freq = 0;
 
   while (curr) {
-    switch (etype) {
-      case INT:
-        freq += curr->data.value.ival == *(int *)val ? 1 : 0;
-        break;
-
-      case FLO:
-        freq += curr->data.value.fval == *(float *)val ? 1 : 0;
-        break;
-
-      case STR:
-        freq += strcmp(curr->data.value.sval, (char *)val) == 0 ? 1 : 0;
-        break;
-
-      default:
-        return 0;
-    }
+    freq += el_match(&curr->data, &key, dll->intern) ? 1 : 0;
     curr = curr->next;
   }
   return freq;
@@ -130,28 +149,12 @@ int dll_count(dlinkedlist_t *dll, etype_t etype, void *val) {
 int dll_index(dlinkedlist_t *dll, etype_t etype, void *val) {
   if (!dll || !dll->head || !val) return -1;
 
+  element_t key;
+  if (!el_key(&key, etype, val, dll->intern)) return -1;
+
   node_t *curr = dll->head;
   for (int i = 0; curr != NULL; i++, curr = curr->next) {
-    switch (etype) {
-      case INT: {
-        if (curr->data.value.ival == *(int *)val) return i;
-        break;
-      }
-
-      case FLO: {
-        if (curr->data.value.fval == *(float *)val) return i;
-        break;
-      }
-
-      case STR: {
-        if (strcmp(curr->data.value.sval, (char *)val) == 0) return i;
-        break;
-      }
-
-      default:
-        // invalid element type found
-        return -1;
-    }
+    if (el_match(&curr->data, &key, dll->intern)) return i;
   }
   return -1;
 }
@@ -166,68 +169,53 @@ node_t* dll_pop(dlinkedlist_t *dll) {
     node_t* pop_node = dll->head;
 
     dll->head = NULL;
+    dll->tail = NULL;
+    dll->size = 0;
     return pop_node;   // user has to take care of freeing the node's memory
   }
 
-  node_t *last_node = dll_last_node(dll);  // get the last node
+  node_t *last_node = dll->tail;           // get the last node
   last_node->prev->next = NULL;            // update the second to last node's next reference 
 
+  dll->tail = last_node->prev;             // second to last node is the new last node
+  last_node->prev = NULL;
+  dll->size--;
   return last_node;    // user has to take care of freeing the node's memory
 }
 
 
 
 int dll_size(dlinkedlist_t *dll) {
-  if (!dll || !dll->head) return 0;
-
-  int len = 0;
-  node_t *curr = dll->head;
-
-  while (curr != NULL) {
-    len++;
-    curr = curr->next;
-  }
-
-  return len;
+  return dll ? dll->size : 0;
 }
 
 
 bool dll_remove(dlinkedlist_t *dll, etype_t etype, void *val) {
   if (!dll || !dll->head || !val) return false;
 
+  element_t key;
+  if (!el_key(&key, etype, val, dll->intern)) return false;
+
   node_t *curr = dll->head;
   bool is_match = false;
 
   while (curr) {
-    switch (etype) {
-      case INT:
-        is_match = ( curr->data.value.ival == *(int *)val );
-        break;
-
-      case FLO:
-        is_match = ( curr->data.value.fval == *(float *)val );
-        break;
-
-      case STR:
-        is_match =  ( strcmp(curr->data.value.sval, (char *)val) == 0 );
-        break;
-
-      default: return false;    // invalid element type
-    }
+    is_match = el_match(&curr->data, &key, dll->intern);
 
     // we got a match
     if (is_match) {
-      // if it's  head node
-      if (curr->prev == NULL) { 
-        dll->head = curr->next;   // update the head to point to next node
-        if (dll->head) dll->head->prev = NULL;
-      }
-      else {
-        // if it's not a head node
-        curr->prev->next = curr->next; // update prev node's next ref to curr's next node
-        curr->next->prev = curr->prev; // update next node's prev ref to curr's prev node
-      }
-      dll_free_node(curr);
+      // if it's  head node, update the head to point to next node
+      // else update prev node's next ref to curr's next node
+      if (curr->prev == NULL) dll->head = curr->next;
+      else curr->prev->next = curr->next;
+
+      // if it's the last node, update the tail to point to prev node
+      // else update next node's prev ref to curr's prev node
+      if (curr->next == NULL) dll->tail = curr->prev;
+      else curr->next->prev = curr->prev;
+
+      dll->size--;
+      dll_recycle_node(dll, curr);
       return true;
     }
     curr = curr->next;       // update the pointers to continue the loop
@@ -239,7 +227,8 @@ bool dll_remove(dlinkedlist_t *dll, etype_t etype, void *val) {
 
 
 void dll_reverse(dlinkedlist_t *dll) {
-  node_t *tmp = NULL;
+  if (!dll || !dll->head) return;
+
   node_t *curr = dll->head;
 
   while (curr) {
@@ -251,8 +240,10 @@ void dll_reverse(dlinkedlist_t *dll) {
     curr = tmp;
   }
 
-  if (tmp) 
-    dll->head = tmp->prev; // update head to the new first node
+  // the first and the last nodes swap places
+  node_t *tmp = dll->head;
+  dll->head = dll->tail;
+  dll->tail = tmp;
 }
 
 
@@ -264,12 +255,7 @@ void dll_print(dlinkedlist_t *dll) {
   printf("[");
 
   while (curr != NULL) {
-    switch (curr->data.etype) {
-      case INT: printf("%d", curr->data.value.ival); break;
-      case FLO: printf("%f", curr->data.value.fval); break;
-      case STR: printf("\"%s\"", curr->data.value.sval); break;
-      default: return;    // invalid element type
-    }
+    if (!el_print(&curr->data)) return;    // invalid element type
     curr = curr->next;
 
     if (curr) printf(", ");
@@ -288,7 +274,7 @@ void dll_free(dlinkedlist_t *ll) {
     node_t *todel = curr;    // note the reference of the node to be freed
     curr = curr->next;       // update the curr to next node
 
-    dll_free_node(todel);
+    dll_recycle_node(ll, todel);
   }
 
   // finally free the linkedlist_t struct
@@ -299,54 +285,34 @@ void dll_free(dlinkedlist_t *ll) {
 
 /* ---------- UTIL FUNCTIONS ---------- */
 
-node_t* dll_new_node(etype_t etype, void *val) {
-  node_t *new_node = malloc(sizeof(node_t));
+/* allocate the node from the pool (malloc, if there is no pool), a long
+   string is interned if there is a table */
+static node_t* dll_make_node(pool_t *pool, intern_t *intern, etype_t etype, void *val) {
+  node_t *new_node = pool_get(pool, sizeof(node_t));
   if (!new_node) return NULL;
 
   // initialize with values
   new_node->next = NULL;
   new_node->prev = NULL;
 
-  switch (etype) {
-    case INT:
-      // typecast void pointer to int pointer (int *) and then de-reference *
-      new_node->data.value.ival = *(int *)val;
-      break;
-
-    case FLO: 
-      new_node->data.value.fval = *(float *)val; 
-      break;
-
-    case STR: {
-      new_node->data.value.sval = strdup( (char *)val );
-      if (!new_node->data.value.sval) {
-        dll_free_node(new_node);
-        return NULL;
-      }
-      break;
-    }
-
-    default:
-      // if we reach here, then invalid etype is passed in
-      // release the memory of new node and return
-      dll_free_node(new_node);
-      return NULL;
+  if (!el_set(&new_node->data, etype, val, intern)) {
+    // invalid etype or out of memory
+    pool_put(pool, new_node);
+    return NULL;
   }
-  new_node->data.etype = etype;  // update the value type
   return new_node;
 }
 
 
 
-node_t* dll_last_node(dlinkedlist_t *dll) {
-  if (!dll || !dll->head) return NULL;
+node_t* dll_new_node(etype_t etype, void *val) {
+  return dll_make_node(NULL, NULL, etype, val);
+}
 
-  node_t *curr = dll->head;
 
-  // loop until the last element is reached
-  while (curr->next != NULL) curr = curr->next;
 
-  return curr;
+node_t* dll_last_node(dlinkedlist_t *dll) {
+  return dll ? dll->tail : NULL;
 }
 
 
@@ -354,9 +320,21 @@ node_t* dll_last_node(dlinkedlist_t *dll) {
 void dll_free_node(node_t *n) {
   if (!n) return;
 
-  // if node's value is string, then free it
-  if (n->data.etype == STR) free(n->data.value.sval);
+  // release the value (a string is freed)
+  el_clear(&n->data, NULL);
 
   // free the node
   free(n);
-}
\ No newline at end of file
+}
+
+
+
+void dll_recycle_node(dlinkedlist_t *dll, node_t *n) {
+  if (!n) return;
+
+  // release the value (a string is freed)
+  el_clear(&n->data, dll ? dll->intern : NULL);
+
+  // give the node back to the allocator it came from
+  pool_put(dll ? dll->pool : NULL, n);
+}
@@ -18,23 +18,8 @@
 #include <stdbool.h>
 #include <string.h>
 
-
-/* specify the type of value in the element */
-typedef enum { INT, FLO, STR } etype_t;
-
-
-
-/* structure to hold value in the node */
-typedef struct {
-  etype_t etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
-
+#include "pool.h"
+#include "element.h"
 
 
 /* structure to represent the node of double linked list */
@@ -49,6 +34,10 @@ typedef struct node {
 /* structure to define the linkedlist */
 typedef struct {
   node_t *head;       // refer the head of the linked list
+  node_t *tail;       // refer the last node, NULL if the list is empty
+  int size;           // no of nodes in the linked list
+  pool_t *pool;       // allocator for the nodes, NULL to use malloc
+  intern_t *intern;   // table of the long strings, NULL if not interned
 } dlinkedlist_t;
 
 
@@ -67,10 +56,37 @@ typedef struct {
  */
 dlinkedlist_t* dll_init();
 
+/**
+ * @brief Same as dll_init, but the nodes are allocated from the pool.
+ *        pool can be shared by many lists, and must outlive them
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param pool_t* - pool of sizeof(node_t) slots, NULL to use malloc
+ * @return dlinkedlist_t* 
+ */
+dlinkedlist_t* dll_init_pool(pool_t *);
+
+/**
+ * @brief Share the long strings of the list through an intern table (see
+ *        intern.h), equal strings are stored once and compared on the
+ *        pointer. the table has to outlive the list. only for an empty list
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param dlinkedlist_t* - pointer to dlinkedlist_t struct
+ * @param intern_t* - intern table, can be shared by many structures
+ * @return true
+ * @return false - list is not empty
+ */
+bool dll_use_intern(dlinkedlist_t *, intern_t *);
+
 /**
  * @brief Allocate memeory for new node and append it at the end of linked list
  * 
- *        time complexity  - O(N); N - no of nodes
+ *        time complexity  - O(1), linked to the tail node
  *        space complexity - O(1)
  * 
  * @param dlinkedlist_t* - pointer to linkedlist_t struct
@@ -86,6 +102,7 @@ bool dll_append(dlinkedlist_t *, etype_t, void *);
  * @brief Insert the value at the given position.
  * 
  *        time complexity  - O(N) ; N - node positon to be inserted
+ *                           O(1) at the head
  *        space complexity - O(1)
  * 
  * @param dlinkedlist_t* - reference to dlinkedlist_t struct
@@ -100,7 +117,8 @@ bool dll_insert(dlinkedlist_t *, int, etype_t, void *);
 /**
  * @brief Loop though the linked list and retun the node at the index posiiton
  * 
- *        time complexity  - O(N), N is the index position
+ *        time complexity  - O(N), N is the index position (or the
+ *                           distance from the end, walked back from the tail)
  *        space complexity - O(1)
  * 
  * @param dlinkedlist_t* - pointer to dlinkedlist_t struct
@@ -142,12 +160,13 @@ int dll_index(dlinkedlist_t *, etype_t, void *);
 /**
  * @brief Removes the last node from the linked list and returns it
  * 
- *        time complexity  - O(N)
+ *        time complexity  - O(1)
  *        space complexity - O(1)
  * 
  * @param dlinkedlist_t* - reference to dlinkedlist_t struct 
  * @return node_t* - returns the last node, NULL if not present
- *                   user has to take care of freeing the memeory of popped node
+ *                   release it with dll_recycle_node, dll_free_node is an
+ *                   invalid free for a node from a pool (or an intern table)
  */
 node_t* dll_pop(dlinkedlist_t *);
 
@@ -180,7 +199,7 @@ void dll_reverse(dlinkedlist_t *);
 /**
  * @brief Get no of nodes in the linked list.
  * 
- *        time complexity - O(N) ; N -  no of nodes in the linked list
+ *        time complexity - O(1) ; the size is kept in the list
  *        space complexiy - O(1)
  * 
  * @param linkedlist_t* - pointer to dlinkedlist_t struct 
@@ -225,9 +244,9 @@ void dll_free(dlinkedlist_t *);
 node_t* dll_new_node(etype_t, void *);
 
 /**
- * @brief Loop through the linked list and returns the last node
+ * @brief Returns the last node of the linked list
  * 
- *        time complexity  - O(N), N - no of nodes in the list
+ *        time complexity  - O(1), the tail is kept in the list
  *        space complexity - O(1)
  * 
  * @param linkedlist_t* - pointer to dlinkedlist_t struct  
@@ -237,9 +256,21 @@ node_t* dll_last_node(dlinkedlist_t *);
 
 /**
  * @brief Free the node. if the node's value is string, then free the string too
+ *        only for the nodes from dll_new_node, or a list without a pool / intern table
  * 
  * @param node_t* - pointer to node_t struct
  */
 void dll_free_node(node_t *);
 
+/**
+ * @brief Free a node of the list, back to the allocator it came from
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param dlinkedlist_t* - ref to dlinkedlist_t struct the node came from
+ * @param node_t* - pointer to node_t struct
+ */
+void dll_recycle_node(dlinkedlist_t *, node_t *);
+
 #endif   // __HEADER_DOUBLE_LINKED_LIST__
\ No newline at end of file
@@ -153,6 +153,56 @@ void test_dll_size() {
 
 
 
+// walk the list both ways, the links, tail and size must agree
+static bool dll_consistent(dlinkedlist_t *dll) {
+    int n = 0;
+    node_t *prev = NULL;
+
+    for (node_t *curr = dll->head; curr; prev = curr, curr = curr->next) {
+        if (curr->prev != prev) return false;
+        n++;
+    }
+
+    return prev == dll->tail && n == dll->size;
+}
+
+// Test function for the tail and size kept by every mutation
+void test_dll_tail_size() {
+    dlinkedlist_t *dll = dll_init();
+    int vals[] = {10, 20, 30, 40, 50};
+    bool ok = true;
+
+    for (int i = 0; i < 5; i++) ok = ok && dll_append(dll, INT, &vals[i]) && dll_consistent(dll);
+
+    // middle, head and end inserts
+    ok = ok && dll_insert(dll, 2, INT, &vals[0]) && dll_consistent(dll);
+    ok = ok && dll_insert(dll, 0, INT, &vals[1]) && dll_consistent(dll);
+    ok = ok && dll_insert(dll, dll->size, INT, &vals[2]) && dll_consistent(dll);
+    ok = ok && dll->tail->data.value.ival == 30 && dll_size(dll) == 8;
+
+    // [20, 10, 20, 10, 30, 40, 50, 30] ; get walks from either end
+    int expect[] = {20, 10, 20, 10, 30, 40, 50, 30};
+    for (int i = 0; i < 8; i++) ok = ok && dll_get(dll, i)->data.value.ival == expect[i];
+
+    // remove the last, a middle one and the first node
+    ok = ok && dll_remove(dll, INT, &vals[2]) && dll_consistent(dll);   // 30 at index 4
+    ok = ok && dll_remove(dll, INT, &vals[4]) && dll_consistent(dll);   // 50, next to the end
+    ok = ok && dll_remove(dll, INT, &vals[1]) && dll_consistent(dll);   // 20 at the head
+
+    dll_reverse(dll);
+    ok = ok && dll_consistent(dll) && dll->head->data.value.ival == 30 && dll->tail->data.value.ival == 10;
+
+    node_t *popped = dll_pop(dll);
+    ok = ok && popped->data.value.ival == 10 && popped->prev == NULL && dll_consistent(dll);
+    dll_free_node(popped);
+
+    while ((popped = dll_pop(dll))) dll_free_node(popped);
+    ok = ok && dll->head == NULL && dll->tail == NULL && dll_size(dll) == 0;
+
+    printf("Testing dll tail and size: %s\n", ok ? "Passed" : "Failed");
+    dll_free(dll);
+}
+
 
 
 // TESTING STARTS HERE
@@ -165,6 +215,7 @@ int main() {
   test_dll_index();
   test_dll_pop();
   test_dll_size();
+  test_dll_tail_size();
 
 
   printf("\n*** ALL TEST PASSES ***\n");
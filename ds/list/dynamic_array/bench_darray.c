@@ -0,0 +1,168 @@
+#include "darray.h"
+#include "vec.h"
+
+#include <time.h>
+
+DEFINE_VEC(int_vec, int)
+
+/*
+  Throughput of the common dynamic array operations, for the tagged darray_t
+  and the typed int_vec_t.
+  usage :- bench_darray [no of elements]     ; default is 1e6
+*/
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+static void report(const char *op, int ops, double elapsed) {
+  printf("%-12s %10d %12.2f\n", op, ops, elapsed * 1e9 / ops);
+}
+
+
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (n <= 0) return 1;
+
+  printf("%-12s %10s %12s\n", "operation", "ops", "ns/op");
+
+  darray_t *da = da_init();
+  if (!da) return 1;
+
+  // append, includes the resizes
+  double start = now_sec();
+  for (int i = 0; i < n; i++) da_append(da, INT, &i);
+  report("append", n, now_sec() - start);
+
+  // bulk load of the same values, from a C array
+  int *vals = malloc(n * sizeof(int));
+  if (!vals) return 1;
+  for (int i = 0; i < n; i++) vals[i] = i;
+
+  darray_t *bulk = da_init();
+  start = now_sec();
+  da_extend(bulk, INT, vals, n);
+  report("extend", n, now_sec() - start);
+  da_free(bulk);
+  free(vals);
+
+  // sequential read through da_get
+  long long sum = 0;
+  start = now_sec();
+  for (int i = 0; i < n; i++) sum += da_get(da, i)->value.ival;
+  report("get_seq", n, now_sec() - start);
+
+  // random read, with a cheap lcg for the indices
+  unsigned idx = 1;
+  start = now_sec();
+  for (int i = 0; i < n; i++) {
+    idx = idx * 1103515245u + 12345u;
+    sum += da_get(da, idx % n)->value.ival;
+  }
+  report("get_rand", n, now_sec() - start);
+
+  // linear scans, for a value that is not in the array
+  int missing = -1, scans = 10;
+  start = now_sec();
+  for (int i = 0; i < scans; i++) sum += da_count(da, INT, &missing);
+  report("count_scan", scans * n, now_sec() - start);
+
+  // inserts and removes at the front, moves the whole array every time
+  int front = n < 1000 ? n : 1000;
+  start = now_sec();
+  for (int i = 0; i < front; i++) da_insert(da, 0, INT, &missing);
+  for (int i = 0; i < front; i++) da_remove(da, INT, &missing);
+  report("front_move", 2 * front, now_sec() - start);
+
+  // pop every element
+  start = now_sec();
+  for (int i = 0; i < n; i++) da_free_element(da_pop(da));
+  report("pop", n, now_sec() - start);
+
+  da_free(da);
+
+  // short string keys, like "k123456"
+  darray_t *sa = da_init();
+  if (!sa) return 1;
+
+  char key[32];
+  start = now_sec();
+  for (int i = 0; i < n; i++) {
+    snprintf(key, sizeof(key), "k%d", i);
+    da_append(sa, STR, key);
+  }
+  report("str_append", n, now_sec() - start);
+
+  // a key of the same length as most, and one that only differs at the end
+  start = now_sec();
+  for (int i = 0; i < scans; i++) sum += da_count(sa, STR, "kmissing");
+  report("str_count", scans * n, now_sec() - start);
+
+  snprintf(key, sizeof(key), "k%d", n - 1);
+  start = now_sec();
+  for (int i = 0; i < scans; i++) sum += da_index(sa, STR, key);
+  report("str_index", scans * n, now_sec() - start);
+
+  da_free(sa);
+
+  // long keys (on the heap), 4096 distinct ones repeated over the array.
+  // l :- every element has its own copy, i :- shared through an intern table
+  intern_t *tab = intern_init(0);
+  const char *names[] = {"lstr", "istr"};
+
+  for (int t = 0; t < 2; t++) {
+    darray_t *la = da_init();
+    if (!la) return 1;
+    if (t == 1) da_use_intern(la, tab);
+
+    char op[32];
+    start = now_sec();
+    for (int i = 0; i < n; i++) {
+      snprintf(key, sizeof(key), "customer-%06d-record", i % 4096);
+      da_append(la, STR, key);
+    }
+    snprintf(op, sizeof(op), "%s_append", names[t]);
+    report(op, n, now_sec() - start);
+
+    // same length & prefix as every element
+    start = now_sec();
+    for (int i = 0; i < scans; i++) sum += da_count(la, STR, "customer-004095-record");
+    snprintf(op, sizeof(op), "%s_count", names[t]);
+    report(op, scans * n, now_sec() - start);
+
+    da_free(la);
+  }
+  intern_destroy(tab);
+
+  // same operations on the typed vector
+  int_vec_t *v = int_vec_init();
+  if (!v) return 1;
+
+  start = now_sec();
+  for (int i = 0; i < n; i++) int_vec_append(v, i);
+  report("vec_append", n, now_sec() - start);
+
+  start = now_sec();
+  for (int i = 0; i < n; i++) sum += *int_vec_get(v, i);
+  report("vec_get_seq", n, now_sec() - start);
+
+  start = now_sec();
+  for (int i = 0; i < scans; i++) sum += int_vec_count(v, missing);
+  report("vec_count", scans * n, now_sec() - start);
+
+  start = now_sec();
+  for (int i = 0; i < front; i++) int_vec_insert(v, 0, missing);
+  for (int i = 0; i < front; i++) int_vec_remove(v, missing);
+  report("vec_front", 2 * front, now_sec() - start);
+
+  int_vec_free(v);
+
+  // keep the reads from being optimized away
+  printf("checksum %lld\n", sum);
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include "vec_scan.h"
+
+#include <time.h>
+
+/*
+  Scan bandwidth of every kernel, on a packed array of ints and floats.
+  usage :- bench_vec_scan [no of elements]     ; default is 1e8
+*/
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+static const char *ISA_NAMES[] = {"scalar", "sse41", "avx2"};
+
+#define RUNS 5
+
+// best of the runs, as GB/s
+#define BENCH(op, call)                                                        \
+  do {                                                                         \
+    double best = 1e30;                                                        \
+    for (int r = 0; r < RUNS; r++) {                                           \
+      double start = now_sec();                                                \
+      sink += (double)(call);                                                  \
+      double elapsed = now_sec() - start;                                      \
+      best = elapsed < best ? elapsed : best;                                  \
+    }                                                                          \
+    printf("%-8s %-10s %10.2f\n", ISA_NAMES[isa], op, n * 4.0 / best / 1e9);   \
+  } while (0)
+
+
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 100000000;
+  if (n <= 0) return 1;
+
+  int *iarr = malloc((size_t)n * sizeof(int));
+  float *farr = malloc((size_t)n * sizeof(float));
+  if (!iarr || !farr) return 1;
+
+  srand(42);
+  for (int i = 0; i < n; i++) {
+    iarr[i] = rand() % 1000;
+    farr[i] = (float)(rand() % 1000);
+  }
+
+  double sink = 0;
+  printf("%-8s %-10s %10s\n", "isa", "kernel", "GB/s");
+
+  for (int isa = VS_SCALAR; isa <= (int)vs_isa(); isa++) {
+    const vs_kernels_t *k = vs_kernels((vs_isa_t)isa);
+
+    // -1 is never present, so find has to scan the whole array
+    BENCH("count_i32", k->count_i32(iarr, n, 7));
+    BENCH("find_i32", k->find_i32(iarr, n, -1));
+    BENCH("min_i32", k->min_i32(iarr, n));
+    BENCH("sum_i32", k->sum_i32(iarr, n));
+    BENCH("count_f32", k->count_f32(farr, n, 7.0f));
+    BENCH("find_f32", k->find_f32(farr, n, -1.0f));
+    BENCH("max_f32", k->max_f32(farr, n));
+    BENCH("sum_f32", k->sum_f32(farr, n));
+  }
+
+  // keep the results from being optimized away
+  printf("checksum %g\n", sink);
+
+  free(iarr);
+  free(farr);
+  return 0;
+}
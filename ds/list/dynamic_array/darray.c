@@ -2,6 +2,23 @@
 
 
 darray_t* da_init() {
+  return da_init_policy((da_policy_t){ SCALE_SIZE, SHRINK_BELOW });
+}
+
+
+
+/* growth has to make progress, and the shrink threshold must leave a gap
+   from the size right after a growth / shrink (1 / growth) */
+static bool da_valid_policy(da_policy_t policy) {
+  return policy.growth > 1.0f &&
+         policy.shrink_below >= 0.0f && policy.shrink_below * policy.growth < 1.0f;
+}
+
+
+
+darray_t* da_init_policy(da_policy_t policy) {
+  if (!da_valid_policy(policy)) return NULL;
+
   // allocate memory for dynamic array
   darray_t *da = malloc(sizeof(darray_t));
   if (!da) return NULL;
@@ -9,8 +26,10 @@ darray_t* da_init() {
   // initialize the members
   da->size = 0;
   da->capacity = INIT_CAPACITY;
+  da->policy = policy;
+  da->intern = NULL;
 
-  da->data = malloc(da->capacity * sizeof(element_t *));
+  da->data = malloc(da->capacity * sizeof(element_t));
   if (!da->data) {
     free(da);
     return NULL;
@@ -21,10 +40,56 @@ darray_t* da_init() {
 
 
 
+bool da_set_policy(darray_t *da, da_policy_t policy) {
+  if (!da || !da_valid_policy(policy)) return false;
+
+  da->policy = policy;
+  return true;
+}
+
+
+
+bool da_use_intern(darray_t *da, intern_t *intern) {
+  if (!da || !da_is_empty(da)) return false;
+
+  da->intern = intern;
+  return true;
+}
+
+
+
+/* capacity after growing by the policy, atleast one more than now */
+static int da_grown_capacity(darray_t *da) {
+  int grown = (int)(da->capacity * da->policy.growth);
+  return grown > da->capacity ? grown : da->capacity + 1;
+}
+
+
+
+/* give back the memory, once the array is below the shrink threshold */
+static void da_maybe_shrink(darray_t *da) {
+  if (da->capacity <= INIT_CAPACITY) return;
+  if (da->size >= da->capacity * da->policy.shrink_below) return;
+
+  // leave room to grow, so the next append doesn't resize right away
+  int target = (int)(da->size * da->policy.growth);
+  if (target < INIT_CAPACITY) target = INIT_CAPACITY;
+  if (target >= da->capacity) return;
+
+  // if realloc fails, the old (larger) buffer is still valid
+  element_t *new_memory = realloc(da->data, (size_t)target * sizeof(element_t));
+  if (!new_memory) return;
+
+  da->capacity = target;
+  da->data = new_memory;
+}
+
+
+
 const element_t* da_get(darray_t *da, int idx) {
-  if (!da || da_is_empty(da)) return NULL;
+  if (!da || idx < 0 || idx >= da->size) return NULL;
 
-  return da->data[idx];
+  return &da->data[idx];
 }
 
 
@@ -33,14 +98,12 @@ bool da_append(darray_t *da, etype_t etype, void *val) {
   if (!da || !val) return false;
 
   // if the array is full, then resize the array
-  if (da_is_full(da)) da_resize(da);
+  if (da_is_full(da) && !da_resize(da)) return false;
 
-  // create a element_t and udpate it with the value
-  element_t *new_element = da_new_element(etype, val);
-  if (!new_element) return false;
+  // update the next free slot with the value
+  if (!el_set(&da->data[da->size], etype, val, da->intern)) return false;
 
-  // update the array with the element
-  da->data[da->size++] = new_element;
+  da->size++;
   return true;
 }
 
@@ -53,12 +116,15 @@ bool da_insert(darray_t *da, int idx, etype_t etype, void *val) {
   if (idx == da->size) 
     return da_append(da, etype, val);
   
-  // move the elements from idx positon to right by one
-  if (!da_move_right(da, idx)) return false;
+  // build the element first, so a failure leaves the array untouched
+  element_t new_element;
+  if (!el_set(&new_element, etype, val, da->intern)) return false;
 
-  // create a element_t and udpate it with the value
-  element_t *new_element = da_new_element(etype, val);
-  if (!new_element) return false;
+  // move the elements from idx positon to right by one
+  if (!da_move_right(da, idx)) {
+    el_clear(&new_element, da->intern);
+    return false;
+  }
 
   // finally insert the element to the position
   da->data[idx] = new_element;
@@ -67,59 +133,108 @@ bool da_insert(darray_t *da, int idx, etype_t etype, void *val) {
 
 
 
-int da_count(darray_t *da, etype_t etype, void *val) {
-  if (!da || !val || da_is_empty(da)) return 0;
+/* fill n slots from a C array of values (int[], float[] or char *[]). if a
+   string can't be copied, the filled slots are cleared and false returned */
+static bool da_fill(darray_t *da, element_t *dst, etype_t etype, const void *vals, int n) {
+  int i = 0;
 
-  int freq = 0;
+  switch (etype) {
+    case INT:
+      for (; i < n; i++) {
+        dst[i].etype = INT;
+        dst[i].value.ival = ((const int *)vals)[i];
+      }
+      return true;
 
-  for (int i = 0; i < da->size; i++) {
-    // if the element types don't match, then skip that element
-    if (da->data[i]->etype != etype) continue;
-
-    switch (etype) {
-      case INT:
-        freq += da->data[i]->value.ival == *(int *)val ? 1 : 0;
-        break;
-
-      case FLO:
-        freq += da->data[i]->value.fval == *(float *)val ? 1 : 0;
-        break;
-
-      case STR:
-        freq += strcmp(da->data[i]->value.sval, (char *)val) == 0 ? 1 : 0;
-        break;
-    }
+    case FLO:
+      for (; i < n; i++) {
+        dst[i].etype = FLO;
+        dst[i].value.fval = ((const float *)vals)[i];
+      }
+      return true;
+
+    case STR:
+      for (; i < n; i++) {
+        if (!el_set(&dst[i], STR, ((char * const *)vals)[i], da->intern)) break;
+      }
+      if (i == n) return true;
+
+      while (i-- > 0) el_clear(&dst[i], da->intern);
+      return false;
   }
 
-  return freq;
+  return false;   // invalid element type
 }
 
 
 
-int da_index(darray_t *da, etype_t etype, void *val) {
-  if (!da || !val || da_is_empty(da)) return -1;
+/* make sure there is space for n more elements. grows atleast by the growth
+   factor, so a series of small extends stays amortized O(1) per element */
+static bool da_grow_for(darray_t *da, int n) {
+  if (n <= da->capacity - da->size) return true;
 
-  for (int i = 0; i < da->size; i++) {
-    // if the element types don't match, then skip that element
-    if (da->data[i]->etype != etype) continue;
+  int needed = da->size + n;
+  int grown = da_grown_capacity(da);
+
+  return da_reserve(da, needed > grown ? needed : grown);
+}
+
+
+
+bool da_extend(darray_t *da, etype_t etype, const void *vals, int n) {
+  if (!da || n < 0 || (n > 0 && !vals)) return false;
+  if (n == 0) return true;
+
+  // one reallocation for the whole range
+  if (!da_grow_for(da, n)) return false;
+
+  if (!da_fill(da, &da->data[da->size], etype, vals, n)) return false;
+
+  da->size += n;
+  return true;
+}
 
-    switch (etype) {
-      case INT:
-        if (da->data[i]->value.ival == *(int *)val) return i;
-        break;
 
-      case FLO:
-        if (da->data[i]->value.fval == *(float *)val) return i;
-        break;
 
-      case STR:
-        if (strcmp(da->data[i]->value.sval, (char *)val) == 0) return i;
-        break;
-    }
+bool da_insert_range(darray_t *da, int idx, etype_t etype, const void *vals, int n) {
+  if (!da || idx < 0 || idx > da->size || n < 0 || (n > 0 && !vals)) return false;
+  if (n == 0) return true;
 
-    // if we reach here, then there is no match
-    return -1;
+  if (!da_grow_for(da, n)) return false;
+
+  // open a gap of n slots in one move
+  element_t *gap = &da->data[idx];
+  memmove(gap + n, gap, (da->size - idx) * sizeof(element_t));
+
+  if (!da_fill(da, gap, etype, vals, n)) {
+    memmove(gap, gap + n, (da->size - idx) * sizeof(element_t));   // close the gap
+    return false;
   }
+
+  da->size += n;
+  return true;
+}
+
+
+
+int da_count(darray_t *da, etype_t etype, void *val) {
+  if (!da || !val || da_is_empty(da)) return 0;
+
+  element_t key;
+  if (!el_key(&key, etype, val, da->intern)) return 0;
+
+  return el_count(da->data, da->size, &key, da->intern);
+}
+
+
+
+int da_index(darray_t *da, etype_t etype, void *val) {
+  if (!da || !val || da_is_empty(da)) return -1;
+
+  element_t key;
+  if (!el_key(&key, etype, val, da->intern)) return -1;
+
+  return el_index(da->data, da->size, &key, da->intern);
 }
 
 
@@ -127,14 +242,29 @@ int da_index(darray_t *da, etype_t etype, void *val) {
 element_t* da_pop(darray_t *da) {
   if (!da || da_is_empty(da)) return NULL;
 
-  return da->data[--da->size];   // caller is ezpected to free the memory
+  element_t *pop_element = malloc(sizeof(element_t));
+  if (!pop_element) return NULL;
+
+  // string (if any) is now owned by the popped copy
+  *pop_element = da->data[da->size - 1];
+
+  // an interned string is shared, the copy gets its own chars
+  if (!el_own(pop_element, da->intern)) {
+    free(pop_element);
+    return NULL;
+  }
+
+  da->size--;
+
+  da_maybe_shrink(da);
+  return pop_element;   // caller is ezpected to free the memory
 }
 
 
 void da_reverse(darray_t *da) {
   if (!da || da->size <= 1) return;
 
-  element_t *tmp_swp = NULL;
+  element_t tmp_swp;
 
   // loop goes till the half of the array
   for (int i = 0; i < (da->size / 2); i++) {
@@ -152,12 +282,7 @@ void da_print(darray_t *da) {
   printf("[");
 
   for (int i = 0; i < da->size; i++) {
-    switch (da->data[i]->etype) {
-      case INT: printf("%d", da->data[i]->value.ival); break;
-      case FLO: printf("%f", da->data[i]->value.fval); break;
-      case STR: printf("\"%s\"", da->data[i]->value.sval); break;
-      default: return;    // invalid element type
-    }
+    if (!el_print(&da->data[i])) return;    // invalid element type
 
     if ((i + 1) < da->size) printf(", ");
   }
@@ -173,11 +298,11 @@ void da_remove(darray_t *da, etype_t etype, void *val) {
   int idx = da_index(da, etype, val);
   if (idx == -1) return;
 
-  element_t *to_del = da->data[idx];
-  da_free_element(to_del);
+  el_clear(&da->data[idx], da->intern);
 
   // move the elements to the left
   da_move_left(da, idx);
+  da_maybe_shrink(da);
 }
 
 
@@ -192,9 +317,10 @@ void da_free(darray_t *da) {
   if (!da) return;
 
   for (int i = 0; i < da->size; i++) {
-    da_free_element(da->data[i]);
+    el_clear(&da->data[i], da->intern);
   }
 
+  free(da->data);
   free(da);   // finally free the dynamic array
 }
 
@@ -205,11 +331,11 @@ void da_free(darray_t *da) {
 bool da_resize(darray_t *da) {
   if (!da) return false;
 
-  // double the current capacity
-  int new_capacity = da->capacity * SCALE_SIZE;
+  // grow the current capacity by the policy
+  int new_capacity = da_grown_capacity(da);
 
-  // reallocate new memory with double the current capacity
-  element_t **new_memory = realloc(da->data, new_capacity * sizeof(element_t *));
+  // reallocate new memory with the grown capacity
+  element_t *new_memory = realloc(da->data, (size_t)new_capacity * sizeof(element_t));
   if (!new_memory) return false;
 
   // update the values
@@ -219,18 +345,47 @@ bool da_resize(darray_t *da) {
 }
 
 
+bool da_reserve(darray_t *da, int capacity) {
+  if (!da || capacity < 0) return false;
+
+  // already has the space
+  if (capacity <= da->capacity) return true;
+
+  element_t *new_memory = realloc(da->data, (size_t)capacity * sizeof(element_t));
+  if (!new_memory) return false;
+
+  da->capacity = capacity;
+  da->data = new_memory;
+  return true;
+}
+
+
+
+bool da_shrink_to_fit(darray_t *da) {
+  if (!da) return false;
+
+  // keep room for one element, realloc of 0 bytes may free the buffer
+  int target = da->size > 0 ? da->size : 1;
+  if (target == da->capacity) return true;
+
+  element_t *new_memory = realloc(da->data, (size_t)target * sizeof(element_t));
+  if (!new_memory) return false;
+
+  da->capacity = target;
+  da->data = new_memory;
+  return true;
+}
+
+
+
 bool da_move_right(darray_t *da, int idx) {
   if (!da || idx < 0 || idx >= da->size) return false;
 
-  int tmp_swp;
-
   // if the array is full, then resize the array
-  if (da_is_full(da)) da_resize(da);
+  if (da_is_full(da) && !da_resize(da)) return false;
 
-  // move the element to right by one position
-  for (int i = da->size-1; i >= idx; i--) {
-    da->data[i + 1] = da->data[i];
-  }
+  // move the element to right by one position, in one go
+  memmove(&da->data[idx + 1], &da->data[idx], (da->size - idx) * sizeof(element_t));
 
   da->size++;   // increase size, after moving the element
   return true;
@@ -239,13 +394,10 @@ bool da_move_right(darray_t *da, int idx) {
 
 
 bool da_move_left(darray_t *da, int idx) {
-  if (!da || idx >= da->size) return false;
-
-  int tmp_swp;
+  if (!da || idx < 0 || idx >= da->size) return false;
 
-  // move the elements to the left by one position
-  for (int i = idx; i < da->size - 1; i++)
-    da->data[i] = da->data[i + 1];
+  // move the elements to the left by one position, in one go
+  memmove(&da->data[idx], &da->data[idx + 1], (da->size - idx - 1) * sizeof(element_t));
 
   da->size--;   // decrease size, after removing the element
   return true;
@@ -265,45 +417,23 @@ bool da_is_empty(darray_t *da) {
 
 
 element_t* da_new_element(etype_t etype, void *val) {
-  if (!val) return NULL;
+  return el_new(etype, val);
+}
 
-  // allocate memeory for new element
-  element_t *new_element = malloc(sizeof(element_t));
-  if (!new_element) return NULL;
 
-  switch (etype) {
-    case INT:
-      new_element->value.ival = *(int *)val;
-      break;
 
-    case FLO:
-      new_element->value.fval = *(float *)val;
-      break;
+bool da_set_element(element_t *ele, etype_t etype, void *val) {
+  return el_set(ele, etype, val, NULL);
+}
 
-    case STR:
-      new_element->value.sval = strdup((char *)val);
-      if (!new_element->value.sval) {
-        free(new_element);
-        return NULL;
-      }
-      break;
 
-    default:
-      free(new_element);       // invalid element type
-      return NULL;
-  }
 
-  new_element->etype = etype;  // update the element type
-  return new_element;
+void da_clear_element(element_t *ele) {
+  el_clear(ele, NULL);
 }
 
 
 
 void da_free_element(element_t *ele) {
-  if (!ele) return;
-
-  // free allocated memeory for string element
-  if (ele->etype == STR) free(ele->value.sval);
-
-  free(ele);
+  el_free(ele);
 }
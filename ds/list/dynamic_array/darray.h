@@ -6,8 +6,11 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "element.h"
+
 #define INIT_CAPACITY  10     // initial capacity of the array
-#define SCALE_SIZE     2      // every time the arr is full, it's double while resizing
+#define SCALE_SIZE     2      // default growth, every time the arr is full it's doubled
+#define SHRINK_BELOW   0.25f  // default shrink, once the arr is less than 1/4th full
 
 /*
 Some Design Notes:
@@ -22,30 +25,46 @@ Some Design Notes:
 - value pointer by size, is equivalent to no of elements
 
 - size == capacity, array full
-*/
-
 
-/* enum type to define the value type in union */
-typedef enum { INT, FLO, STR } etype_t;
+- elements are stored inline (contiguous element_t values, not pointers),
+  so there is no allocation per element and moving elements is a memmove.
+  element_t and its set / compare / free are shared by all the structures
+  (ds/core/element.h), da_count / da_index are its el_count / el_index scans
+
+- a string upto SSTR_INLINE chars is stored in the element itself (see
+  sstr.h), only the longer ones are a malloc. a STR lookup compares the
+  cached length & prefix first, so most of the mismatches never touch the
+  heap
+
+- an array can share its long strings through an intern table (intern.h,
+  da_use_intern), equal strings are then stored once and a STR lookup is a
+  pointer compare. a lookup of a string that is not in the table returns
+  right away, without a scan. a popped element always owns its string
+
+- every array has its own growth policy :- the growth factor (eg 1.5 or 2)
+  and the shrink threshold. after a pop / remove, if size < capacity *
+  shrink_below, the capacity is cut to size * growth (never below the
+  INIT_CAPACITY). shrink_below has to be less than 1 / growth, so right
+  after a shrink (or a growth) the array is neither full nor shrinkable,
+  this gap (hysteresis) keeps an append / pop at the boundary from
+  reallocating every time. shrink_below of 0 turns the shrinking off
+*/
 
 
-/* struct of an element */
+/* growth policy of the array */
 typedef struct {
-  etype_t etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
+  float growth;        // capacity is multiplied by this when full, > 1
+  float shrink_below;  // shrink once size < capacity * this, 0 to never shrink
+} da_policy_t;
 
 
 /* struct to define the dynamic arraay */
 typedef struct {
   int size;            // no of elements in the array
   int capacity;        // no of elements the array can hold
-  element_t **data;    // array of pointers to element_t's struct
+  da_policy_t policy;  // growth & shrink of the capacity
+  intern_t *intern;    // table of the long strings, NULL if not interned
+  element_t *data;     // array of element_t's struct
 } darray_t;
 
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
@@ -62,6 +81,45 @@ typedef struct {
  */
 darray_t* da_init();
 
+/**
+ * @brief Allocate memory for the darray_t struct, with the given policy
+ * 
+ * time complexity -> O(1)
+ * space complexity -> O(N);   N - is the initial capacity
+ * 
+ * @param da_policy_t - growth policy, see the design notes for the limits
+ * @return darray_t* - NULL, if the policy is invalid
+ */
+darray_t* da_init_policy(da_policy_t);
+
+/**
+ * @brief Change the growth policy of the array, the capacity is only
+ *        adjusted on the next append / pop
+ * 
+ * time complexity  -> O(1)
+ * space complexity -> O(1)
+ * 
+ * @param darray_t - pointer to the darray_t struct
+ * @param da_policy_t - growth policy, see the design notes for the limits
+ * @return true 
+ * @return false - invalid policy, the old one is kept
+ */
+bool da_set_policy(darray_t *, da_policy_t);
+
+/**
+ * @brief Share the long strings of the array through an intern table, the
+ *        table has to outlive the array. only for an empty array
+ * 
+ * time complexity  -> O(1)
+ * space complexity -> O(1)
+ * 
+ * @param darray_t - pointer to the darray_t struct
+ * @param intern_t - intern table, can be shared by many structures
+ * @return true 
+ * @return false - array is not empty
+ */
+bool da_use_intern(darray_t *, intern_t *);
+
 /**
  * @brief Get the element_t at the given index
  * 
@@ -71,7 +129,7 @@ darray_t* da_init();
  * @param darray_t - pointer to the darray_t struct
  * @param int - index positon to get the value
  * 
- * @return const element_t* 
+ * @return const element_t* - valid till the array is modified next
  */
 const element_t* da_get(darray_t *, int);
 
@@ -106,6 +164,41 @@ bool da_append(darray_t *, etype_t, void *);
  */
 bool da_insert(darray_t *, int, etype_t, void *);
 
+/**
+ * @brief Add n values at the end of the array, from a C array of values.
+ *        capacity grows once (atmost one reallocation)
+ * 
+ * time complexity  -> O(n), O(N + n); incase resizing happens
+ * space complexity -> O(1)
+ * 
+ * @param darray_t - pointer to the darray_t struct
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param void * - C array of values, int[], float[] or char *[] based on enum type
+ * @param int - no of values
+ * 
+ * @return true 
+ * @return false - array is left unchanged
+ */
+bool da_extend(darray_t *, etype_t, const void *, int);
+
+/**
+ * @brief Insert n values at the given index position, the elements from that
+ *        index are moved right by n in a single move
+ * 
+ * time complexity  -> O(N + n)
+ * space complexity -> O(1)
+ * 
+ * @param darray_t - pointer to the darray_t struct
+ * @param int - index position to insert the first value
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param void * - C array of values, int[], float[] or char *[] based on enum type
+ * @param int - no of values
+ * 
+ * @return true 
+ * @return false - array is left unchanged
+ */
+bool da_insert_range(darray_t *, int, etype_t, const void *, int);
+
 /**
  * @brief Identify the frequency of a given value
  * 
@@ -142,7 +235,8 @@ int da_index(darray_t *, etype_t, void *);
  * 
  * @param darray_t - pointer to the darray_t struct
  * 
- * @return element_t* 
+ * @return element_t* - copy of the element, caller has to free it with
+ *                      da_free_element
  */
 element_t* da_pop(darray_t *);
 
@@ -191,7 +285,19 @@ void da_free(darray_t *);
 
 
 /**
- * @brief Resize the array to be double the size and copy the old value to new array
+ * @brief Cut the capacity down to the size (atleast 1 element)
+ * 
+ * time complexity  -> O(N)
+ * space complexity -> O(N)
+ * 
+ * @param darray_t - pointer to the darray_t struct
+ * @return true 
+ * @return false 
+ */
+bool da_shrink_to_fit(darray_t *);
+
+/**
+ * @brief Resize the array by the growth factor of its policy and copy the old value to new array
  * 
  * time complexity  -> O(N)
  * space complexity -> O(N)
@@ -203,7 +309,22 @@ void da_free(darray_t *);
 bool da_resize(darray_t *);
 
 /**
- * @brief Move all the elements to right from the idx position
+ * @brief Grow the capacity to atleast the given no of elements, does nothing
+ *        if the array can already hold them
+ * 
+ * time complexity  -> O(N)
+ * space complexity -> O(capacity)
+ * 
+ * @param darray_t - pointer to the darray_t struct
+ * @param int - no of elements the array should be able to hold
+ * @return true 
+ * @return false 
+ */
+bool da_reserve(darray_t *, int);
+
+/**
+ * @brief Move all the elements to right from the idx position (memmove),
+ *        slot at idx is left to be overwritten by the caller
  * 
  * time complexity -> O(N)
  * space compleity -> O(1) 
@@ -216,7 +337,8 @@ bool da_resize(darray_t *);
 bool da_move_right(darray_t *, int);
 
 /**
- * @brief Move all the elements to left till the idx position
+ * @brief Move all the elements to left till the idx position (memmove),
+ *        element at idx is overwritten, caller has to clear it before
  * 
  * time complexity -> O(N)
  * space compleity -> O(1) 
@@ -266,6 +388,31 @@ bool da_is_empty(darray_t *);
  */
 element_t* da_new_element(etype_t, void *);
 
+/**
+ * @brief Update the element_t struct with the value
+ * 
+ * time complexity  -> O(1)
+ * space complexity -> O(1)
+ * 
+ * @param element_t - pointer to element_t struct
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param void * - void pointer to value, will be typecasted based on enum type
+ * @return true 
+ * @return false - invalid type or string allocation failed
+ */
+bool da_set_element(element_t *, etype_t, void *);
+
+/**
+ * @brief Release the memory owned by the element (string value),
+ *        the element_t struct itself is not freed
+ * 
+ * time complexity  -> O(1)
+ * space complexity -> O(1)
+ * 
+ * @param element_t - pointer to element_t struct
+ */
+void da_clear_element(element_t *);
+
 /**
  * @brief Release the memory allocated for the element
  * 
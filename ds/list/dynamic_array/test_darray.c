@@ -13,11 +13,7 @@ void test_da_init()
 {
   darray_t *da = da_init();
   print_test_result("test_da_init", da != NULL && da->size == 0 && da->capacity == INIT_CAPACITY);
-  if (da)
-  {
-    free(da->data);
-    free(da);
-  }
+  da_free(da);
 }
 
 // Test for da_append
@@ -26,10 +22,8 @@ void test_da_append()
   darray_t *da = da_init();
   int value = 42;
   bool result = da_append(da, INT, &value);
-  print_test_result("test_da_append", result && da->size == 1 && da->data[0]->value.ival == 42);
-  da_free_element(da->data[0]);
-  free(da->data);
-  free(da);
+  print_test_result("test_da_append", result && da->size == 1 && da->data[0].value.ival == 42);
+  da_free(da);
 }
 
 // Test for da_get
@@ -40,9 +34,7 @@ void test_da_get()
   da_append(da, INT, &value);
   const element_t *elem = da_get(da, 0);
   print_test_result("test_da_get", elem != NULL && elem->value.ival == 42);
-  da_free_element(da->data[0]);
-  free(da->data);
-  free(da);
+  da_free(da);
 }
 
 // Test for da_insert
@@ -52,11 +44,8 @@ void test_da_insert()
   int value1 = 42, value2 = 84;
   da_append(da, INT, &value1);
   bool result = da_insert(da, 0, INT, &value2); // Insert at the beginning
-  print_test_result("test_da_insert", result && da->size == 2 && da->data[0]->value.ival == 84);
-  da_free_element(da->data[0]);
-  da_free_element(da->data[1]);
-  free(da->data);
-  free(da);
+  print_test_result("test_da_insert", result && da->size == 2 && da->data[0].value.ival == 84);
+  da_free(da);
 }
 
 // Test for da_count
@@ -68,10 +57,7 @@ void test_da_count()
   da_append(da, INT, &value2);
   int count = da_count(da, INT, &value1);
   print_test_result("test_da_count", count == 2);
-  da_free_element(da->data[0]);
-  da_free_element(da->data[1]);
-  free(da->data);
-  free(da);
+  da_free(da);
 }
 
 // Test for da_index
@@ -82,9 +68,7 @@ void test_da_index()
   da_append(da, INT, &value);
   int index = da_index(da, INT, &value);
   print_test_result("test_da_index", index == 0);
-  da_free_element(da->data[0]);
-  free(da->data);
-  free(da);
+  da_free(da);
 }
 
 // Test for da_pop
@@ -96,8 +80,7 @@ void test_da_pop()
   element_t *elem = da_pop(da);
   print_test_result("test_da_pop", elem != NULL && elem->value.ival == 42 && da->size == 0);
   da_free_element(elem);
-  free(da->data);
-  free(da);
+  da_free(da);
 }
 
 // Test for da_remove
@@ -108,10 +91,8 @@ void test_da_remove()
   da_append(da, INT, &value1);
   da_append(da, INT, &value2);
   da_remove(da, INT, &value1);
-  print_test_result("test_da_remove", da->size == 1 && da->data[0]->value.ival == 84);
-  da_free_element(da->data[0]);
-  free(da->data);
-  free(da);
+  print_test_result("test_da_remove", da->size == 1 && da->data[0].value.ival == 84);
+  da_free(da);
 }
 
 // Test for da_size
@@ -122,9 +103,7 @@ void test_da_size()
   da_append(da, INT, &value);
   int size = da_size(da);
   print_test_result("test_da_size", size == 1);
-  da_free_element(da->data[0]);
-  free(da->data);
-  free(da);
+  da_free(da);
 }
 
 // Test for da_resize
@@ -141,12 +120,7 @@ void test_da_resize()
 
   bool result = da_append(da, INT, &val); // This should trigger a resize
   print_test_result("test_da_resize", result && da->capacity == INIT_CAPACITY * SCALE_SIZE);
-  for (int i = 0; i < da->size; i++)
-  {
-    da_free_element(da->data[i]);
-  }
-  free(da->data);
-  free(da);
+  da_free(da);
 }
 
 // Test for da_move_right
@@ -157,15 +131,10 @@ void test_da_move_right()
   da_append(da, INT, &value1);
   da_append(da, INT, &value2);
   bool result = da_move_right(da, 0); // Move right at index 0
-  da->data[0] = NULL;
+  da->data[0].value.ival = 0;   // opened slot holds a stale copy
 
-  print_test_result("test_da_move_right", result && da->size == 3 && da->data[1]->value.ival == 42);
-  for (int i = 0; i < da->size; i++)
-  {
-    da_free_element(da->data[i]);
-  }
-  free(da->data);
-  free(da);
+  print_test_result("test_da_move_right", result && da->size == 3 && da->data[1].value.ival == 42);
+  da_free(da);
 
 }
 
@@ -177,17 +146,12 @@ void test_da_move_left()
   da_append(da, INT, &value1);
   da_append(da, INT, &value2);
   da_move_right(da, 0);          // Move right to create space
-  da->data[0] = NULL;
+  da->data[0].value.ival = 0;   // opened slot holds a stale copy
 
   da_move_left(da, 0);           // Remove the first element
   
-  print_test_result("test_da_move_left", da->size == 2 && da->data[0]->value.ival == 42);
-  for (int i = 0; i < da->size; i++)
-  {
-    da_free_element(da->data[i]);
-  }
-  free(da->data);
-  free(da);
+  print_test_result("test_da_move_left", da->size == 2 && da->data[0].value.ival == 42);
+  da_free(da);
 }
 
 // Test for da_is_full
@@ -201,12 +165,7 @@ void test_da_is_full()
   }
   bool result = da_is_full(da);
   print_test_result("test_da_is_full", result);
-  for (int i = 0; i < da->size; i++)
-  {
-    da_free_element(da->data[i]);
-  }
-  free(da->data);
-  free(da);
+  da_free(da);
 }
 
 // Test for da_is_empty
@@ -219,9 +178,7 @@ void test_da_is_empty()
   da_append(da, INT, &value);
   result = da_is_empty(da);
   print_test_result("test_da_is_empty_after_append", !result);
-  da_free_element(da->data[0]);
-  free(da->data);
-  free(da);
+  da_free(da);
 }
 
 // test the array reverse
@@ -242,6 +199,212 @@ void test_da_reverse() {
   puts("after reverse");
   da_reverse(da);
   da_print(da);
+  da_free(da);
+}
+
+// strings are owned by the array, and survive the moves
+void test_da_strings()
+{
+  darray_t *da = da_init();
+  char buf[16];
+  for (int i = 0; i < 3 * INIT_CAPACITY; i++)
+  {
+    snprintf(buf, sizeof(buf), "s%d", i);
+    da_insert(da, 0, STR, buf);
+  }
+
+  da_remove(da, STR, "s0");
+  snprintf(buf, sizeof(buf), "s%d", 3 * INIT_CAPACITY - 1);
+  bool result = da->size == 3 * INIT_CAPACITY - 1 &&
+                strcmp(sstr_cstr(&da_get(da, 0)->value.sval), buf) == 0 &&
+                da_index(da, STR, "s1") == da->size - 1 &&
+                da_get(da, da->size) == NULL;
+
+  element_t *elem = da_pop(da);
+  result = result && elem && strcmp(sstr_cstr(&elem->value.sval), "s1") == 0;
+  print_test_result("test_da_strings", result);
+  da_free_element(elem);
+  da_free(da);
+}
+
+// short strings are inline, long ones on the heap, lookups see no difference
+void test_da_long_strings()
+{
+  darray_t *da = da_init();
+  char *vals[4] = {"key", "a key longer than 15 chars", "a key longer than 15 charz", "key"};
+  bool result = da_extend(da, STR, vals, 4) &&
+                sstr_is_inline(&da_get(da, 0)->value.sval) &&
+                !sstr_is_inline(&da_get(da, 1)->value.sval);
+
+  // same length & prefix, differs at the end
+  result = result && da_count(da, STR, "key") == 2 && da_count(da, STR, "kez") == 0 &&
+           da_index(da, STR, "a key longer than 15 charz") == 2 &&
+           da_index(da, STR, "a key longer than 15 chars!") == -1;
+
+  da_remove(da, STR, "a key longer than 15 chars");
+  result = result && da->size == 3 &&
+           strcmp(sstr_cstr(&da_get(da, 1)->value.sval), "a key longer than 15 charz") == 0;
+
+  print_test_result("test_da_long_strings", result);
+  da_free(da);
+}
+
+// long strings are shared through the table, and a popped one is a copy
+void test_da_intern()
+{
+  intern_t *tab = intern_init(0);
+  darray_t *da = da_init();
+  bool result = da_use_intern(da, tab);
+
+  char buf[32];
+  for (int i = 0; i < 100; i++)
+  {
+    snprintf(buf, sizeof(buf), "customer-%06d-record", i % 10);
+    result = result && da_append(da, STR, buf);
+  }
+
+  result = result && intern_count(tab) == 10 && !da_use_intern(da, NULL) &&
+           da_count(da, STR, "customer-000003-record") == 10 &&
+           da_index(da, STR, "customer-000009-record") == 9 &&
+           da_count(da, STR, "customer-000010-record") == 0;
+
+  da_remove(da, STR, "customer-000000-record");
+  element_t *elem = da_pop(da);
+  result = result && elem && strcmp(sstr_cstr(&elem->value.sval), "customer-000009-record") == 0 &&
+           sstr_cstr(&elem->value.sval) != sstr_cstr(&da_get(da, 8)->value.sval);
+  da_free_element(elem);
+
+  da_free(da);
+  print_test_result("test_da_intern", result && intern_count(tab) == 0);
+  intern_destroy(tab);
+}
+
+// count / index on a mix of types, the INT & FLO scans can run on simd
+void test_da_scan_mixed()
+{
+  darray_t *da = da_init();
+  bool result = true;
+
+  for (int n = 0; n < 37; n++)
+  {
+    int ival = n % 5;
+    float fval = (float)(n % 5);
+    if (n % 3 == 0) da_append(da, INT, &ival);
+    else if (n % 3 == 1) da_append(da, FLO, &fval);
+    else da_append(da, STR, "2");
+
+    // compare against a plain loop
+    int key = 2, freq_i = 0, freq_f = 0, idx_i = -1, idx_f = -1;
+    for (int i = 0; i < da->size; i++)
+    {
+      const element_t *e = da_get(da, i);
+      if (e->etype == INT && e->value.ival == key) { freq_i++; if (idx_i == -1) idx_i = i; }
+      if (e->etype == FLO && e->value.fval == 2.0f) { freq_f++; if (idx_f == -1) idx_f = i; }
+    }
+
+    float fkey = 2.0f;
+    result = result && da_count(da, INT, &key) == freq_i && da_index(da, INT, &key) == idx_i;
+    result = result && da_count(da, FLO, &fkey) == freq_f && da_index(da, FLO, &fkey) == idx_f;
+  }
+
+  print_test_result("test_da_scan_mixed", result && da_count(da, STR, "2") == 12);
+  da_free(da);
+}
+
+// Test for da_reserve, da_extend and da_insert_range
+void test_da_bulk()
+{
+  darray_t *da = da_init();
+  bool result = da_reserve(da, 1000) && da->capacity == 1000 && da_reserve(da, 10) && da->capacity == 1000;
+
+  int ivals[1000];
+  for (int i = 0; i < 1000; i++) ivals[i] = i;
+
+  // fits in the reserved space, so no reallocation
+  element_t *before = da->data;
+  result = result && da_extend(da, INT, ivals, 1000) && da->data == before && da->size == 1000;
+
+  // one growth for the whole range
+  result = result && da_extend(da, INT, ivals, 1000) && da->size == 2000 && da->capacity == 2000;
+
+  float fvals[3] = {1.5f, 2.5f, 3.5f};
+  char *svals[2] = {"x", "y"};
+  result = result && da_insert_range(da, 1, FLO, fvals, 3) && da_insert_range(da, 0, STR, svals, 2);
+  result = result && da_insert_range(da, da->size, INT, ivals, 1) && !da_insert_range(da, -1, INT, ivals, 1);
+
+  result = result && da->size == 2006 &&
+           strcmp(sstr_cstr(&da_get(da, 1)->value.sval), "y") == 0 &&
+           da_get(da, 2)->value.ival == 0 &&
+           da_get(da, 3)->value.fval == 1.5f &&
+           da_get(da, 6)->value.ival == 1 &&
+           da_get(da, 2005)->value.ival == 0;
+
+  print_test_result("test_da_bulk", result && da_extend(da, INT, NULL, 0) && !da_extend(da, INT, NULL, 1));
+  da_free(da);
+}
+
+// capacity follows the size down, after pops
+void test_da_shrink()
+{
+  darray_t *da = da_init();
+  for (int i = 0; i < 10000; i++) da_append(da, INT, &i);
+  int peak = da->capacity;
+
+  bool result = true;
+  while (da->size > 2)
+  {
+    da_free_element(da_pop(da));
+
+    // never more than 1 / SHRINK_BELOW times the size (plus the initial capacity)
+    result = result && da->capacity <= da->size / SHRINK_BELOW + INIT_CAPACITY;
+  }
+
+  print_test_result("test_da_shrink", result && peak >= 10000 && da->capacity == INIT_CAPACITY);
+  da_free(da);
+}
+
+// append / pop at the shrink boundary doesn't reallocate every time
+void test_da_hysteresis()
+{
+  darray_t *da = da_init();
+  for (int i = 0; i < 1000; i++) da_append(da, INT, &i);
+  while (da->size > 300) da_free_element(da_pop(da));
+
+  int changes = 0, capacity = da->capacity;
+  for (int r = 0; r < 1000; r++)
+  {
+    int val = r;
+    if (r % 2) da_free_element(da_pop(da));
+    else da_append(da, INT, &val);
+
+    if (da->capacity != capacity) changes++;
+    capacity = da->capacity;
+  }
+
+  print_test_result("test_da_hysteresis", changes <= 1);
+  da_free(da);
+}
+
+// custom growth policy, and the explicit shrink
+void test_da_policy()
+{
+  bool result = da_init_policy((da_policy_t){ 1.0f, 0.0f }) == NULL &&
+                da_init_policy((da_policy_t){ 2.0f, 0.5f }) == NULL;
+
+  darray_t *da = da_init_policy((da_policy_t){ 1.5f, 0.0f });
+  for (int i = 0; i <= INIT_CAPACITY; i++) da_append(da, INT, &i);
+  result = result && da->capacity == (int)(INIT_CAPACITY * 1.5f);
+
+  // shrinking is off, pops keep the capacity
+  for (int i = 0; i < 8; i++) da_free_element(da_pop(da));
+  result = result && da->capacity == (int)(INIT_CAPACITY * 1.5f);
+
+  result = result && da_shrink_to_fit(da) && da->capacity == 3 && da_get(da, 2)->value.ival == 2;
+  result = result && da_append(da, INT, &(int){ 7 }) && da->capacity == 4;
+
+  result = result && !da_set_policy(da, (da_policy_t){ 0.5f, 0.0f }) && da->policy.growth == 1.5f;
+  print_test_result("test_da_policy", result);
+  da_free(da);
 }
 
 // Main function to run all tests
@@ -262,6 +425,14 @@ int main()
   test_da_is_full();
   test_da_is_empty();
   test_da_reverse();
+  test_da_strings();
+  test_da_long_strings();
+  test_da_intern();
+  test_da_scan_mixed();
+  test_da_bulk();
+  test_da_shrink();
+  test_da_hysteresis();
+  test_da_policy();
 
   printf("*** All tests completed ***\n");
   return 0;
@@ -0,0 +1,135 @@
+#include "vec.h"
+
+#include <assert.h>
+
+typedef struct {
+  int id;
+  float score;
+} record_t;
+
+// records match on id alone
+#define RECORD_EQ(a, b) ((a).id == (b).id)
+
+DEFINE_VEC(int_vec, int)
+DEFINE_VEC(float_vec, float)
+DEFINE_VEC_EQ(record_vec, record_t, RECORD_EQ)
+
+
+// Helper function to print test results
+void print_test_result(const char *test_name, bool result)
+{
+  printf("%s: %s\n", test_name, result ? "PASS" : "FAIL");
+}
+
+// Test for int_vec_init
+void test_vec_init()
+{
+  int_vec_t *v = int_vec_init();
+  print_test_result("test_vec_init", v != NULL && v->size == 0 && v->capacity == VEC_INIT_CAPACITY);
+  int_vec_free(v);
+}
+
+// Test for append, including the resizes
+void test_vec_append()
+{
+  int_vec_t *v = int_vec_init();
+  bool result = true;
+  for (int i = 0; i < 5 * VEC_INIT_CAPACITY; i++)
+    result = result && int_vec_append(v, i);
+
+  for (int i = 0; i < v->size; i++)
+    result = result && *int_vec_get(v, i) == i;
+
+  print_test_result("test_vec_append", result && v->size == 5 * VEC_INIT_CAPACITY &&
+                                       int_vec_get(v, v->size) == NULL &&
+                                       int_vec_get(v, -1) == NULL);
+  int_vec_free(v);
+}
+
+// Test for insert at the front, middle and end
+void test_vec_insert()
+{
+  int_vec_t *v = int_vec_init();
+  int_vec_append(v, 2);
+  int_vec_insert(v, 0, 1);
+  int_vec_insert(v, 2, 4);
+  int_vec_insert(v, 2, 3);
+  bool result = !int_vec_insert(v, 6, 9);
+
+  for (int i = 0; i < 4; i++) result = result && v->data[i] == i + 1;
+  print_test_result("test_vec_insert", result && v->size == 4);
+  int_vec_free(v);
+}
+
+// Test for count and index
+void test_vec_count_index()
+{
+  float_vec_t *v = float_vec_init();
+  for (int i = 0; i < 100; i++) float_vec_append(v, (float)(i % 7));
+
+  print_test_result("test_vec_count", float_vec_count(v, 3.0f) == 14 && float_vec_count(v, 9.0f) == 0);
+  print_test_result("test_vec_index", float_vec_index(v, 3.0f) == 3 && float_vec_index(v, 9.0f) == -1);
+  float_vec_free(v);
+}
+
+// Test for pop and remove
+void test_vec_pop_remove()
+{
+  int_vec_t *v = int_vec_init();
+  for (int i = 0; i < 5; i++) int_vec_append(v, i);
+
+  int out = -1;
+  bool result = int_vec_pop(v, &out) && out == 4;
+
+  int_vec_remove(v, 0);
+  int_vec_remove(v, 42);
+  result = result && v->size == 3 && v->data[0] == 1 && v->data[2] == 3;
+
+  while (int_vec_pop(v, NULL));
+  print_test_result("test_vec_pop_remove", result && int_vec_is_empty(v) && !int_vec_pop(v, &out));
+  int_vec_free(v);
+}
+
+// Test for reverse
+void test_vec_reverse()
+{
+  int_vec_t *v = int_vec_init();
+  for (int i = 0; i < 7; i++) int_vec_append(v, i);
+  int_vec_reverse(v);
+
+  bool result = true;
+  for (int i = 0; i < 7; i++) result = result && v->data[i] == 6 - i;
+  print_test_result("test_vec_reverse", result);
+  int_vec_free(v);
+}
+
+// Test for a struct vector, with the custom equality
+void test_vec_struct()
+{
+  record_vec_t *v = record_vec_init();
+  for (int i = 0; i < 20; i++) record_vec_append(v, (record_t){ i, i * 0.5f });
+
+  record_t key = { 7, -1.0f };
+  int idx = record_vec_index(v, key);
+  bool result = idx == 7 && v->data[idx].score == 3.5f && record_vec_count(v, key) == 1;
+
+  record_vec_remove(v, key);
+  result = result && record_vec_index(v, key) == -1 && v->data[7].id == 8;
+  print_test_result("test_vec_struct", result);
+  record_vec_free(v);
+}
+
+// Main function to run all tests
+int main()
+{
+  test_vec_init();
+  test_vec_append();
+  test_vec_insert();
+  test_vec_count_index();
+  test_vec_pop_remove();
+  test_vec_reverse();
+  test_vec_struct();
+
+  printf("*** All tests completed ***\n");
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include "vec_scan.h"
+
+#include <math.h>
+#include <limits.h>
+#include <assert.h>
+
+// Helper function to print test results
+void print_test_result(const char *test_name, bool result)
+{
+  printf("%s: %s\n", test_name, result ? "PASS" : "FAIL");
+}
+
+// every size upto 100 covers all the tails, then a few large ones
+static const int SIZES[] = {0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000, 100003};
+#define NSIZES ((int)(sizeof(SIZES) / sizeof(SIZES[0])))
+
+static const char *ISA_NAMES[] = {"scalar", "sse41", "avx2"};
+
+
+// Test the int kernels of the isa against the scalar ones
+void test_scan_i32(vs_isa_t isa)
+{
+  const vs_kernels_t *ref = vs_kernels(VS_SCALAR);
+  const vs_kernels_t *k = vs_kernels(isa);
+  int *arr = malloc(100003 * sizeof(int));
+  bool result = true;
+
+  for (int s = 0; s < NSIZES; s++)
+  {
+    int n = SIZES[s];
+    for (int i = 0; i < n; i++) arr[i] = rand() % 50 - 25;
+
+    // extremes at the very end, so the tail handling is checked
+    if (n > 2) { arr[n - 1] = INT_MIN; arr[n - 2] = INT_MAX; }
+
+    for (int val = -26; val <= 26; val += 13)
+    {
+      result = result && k->count_i32(arr, n, val) == ref->count_i32(arr, n, val);
+      result = result && k->find_i32(arr, n, val) == ref->find_i32(arr, n, val);
+    }
+    result = result && k->find_i32(arr, n, INT_MIN) == ref->find_i32(arr, n, INT_MIN);
+    result = result && k->min_i32(arr, n) == ref->min_i32(arr, n);
+    result = result && k->max_i32(arr, n) == ref->max_i32(arr, n);
+    result = result && k->sum_i32(arr, n) == ref->sum_i32(arr, n);
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "test_scan_i32_%s", ISA_NAMES[isa]);
+  print_test_result(name, result);
+  free(arr);
+}
+
+// Test the float kernels of the isa against the scalar ones
+void test_scan_f32(vs_isa_t isa)
+{
+  const vs_kernels_t *ref = vs_kernels(VS_SCALAR);
+  const vs_kernels_t *k = vs_kernels(isa);
+  float *arr = malloc(100003 * sizeof(float));
+  bool result = true;
+
+  for (int s = 0; s < NSIZES; s++)
+  {
+    int n = SIZES[s];
+
+    // small integers, so the sum is exact in any order
+    for (int i = 0; i < n; i++) arr[i] = (float)(rand() % 50 - 25);
+    if (n > 3) { arr[0] = NAN; arr[n - 1] = -100.5f; arr[n - 2] = 100.5f; }
+
+    for (int v = -26; v <= 26; v += 13)
+    {
+      result = result && k->count_f32(arr, n, (float)v) == ref->count_f32(arr, n, (float)v);
+      result = result && k->find_f32(arr, n, (float)v) == ref->find_f32(arr, n, (float)v);
+    }
+    result = result && k->count_f32(arr, n, NAN) == 0 && k->find_f32(arr, n, NAN) == -1;
+    result = result && k->min_f32(arr, n) == ref->min_f32(arr, n);
+    result = result && k->max_f32(arr, n) == ref->max_f32(arr, n);
+
+    // NaN poisons the sum, compare without it
+    if (n > 3) result = result && k->sum_f32(arr + 1, n - 1) == ref->sum_f32(arr + 1, n - 1);
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "test_scan_f32_%s", ISA_NAMES[isa]);
+  print_test_result(name, result);
+  free(arr);
+}
+
+// Test the dispatched wrappers, on empty and NULL input
+void test_scan_empty()
+{
+  int arr[1] = {7};
+  bool result = vs_count_i32(NULL, 5, 7) == 0 && vs_find_i32(arr, 0, 7) == -1 &&
+                vs_min_i32(arr, 0) == INT_MAX && vs_max_i32(arr, 0) == INT_MIN &&
+                vs_sum_i32(arr, 0) == 0 && isinf(vs_min_f32(NULL, 3)) &&
+                vs_find_i32(arr, 1, 7) == 0;
+  print_test_result("test_scan_empty", result);
+}
+
+// Main function to run all tests
+int main()
+{
+  srand(42);
+  printf("cpu supports :- %s\n", ISA_NAMES[vs_isa()]);
+
+  for (int isa = VS_SCALAR; isa <= (int)vs_isa(); isa++)
+  {
+    test_scan_i32((vs_isa_t)isa);
+    test_scan_f32((vs_isa_t)isa);
+  }
+  test_scan_empty();
+
+  printf("*** All tests completed ***\n");
+  return 0;
+}
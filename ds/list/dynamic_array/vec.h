@@ -0,0 +1,213 @@
+#ifndef __VEC_HEADER__
+#define __VEC_HEADER__
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define VEC_INIT_CAPACITY  10     // initial capacity of the vector
+#define VEC_SCALE_SIZE     2      // every time the vec is full, it's double while resizing
+
+/*
+Some Design Notes:
+- same operations as darray.c, but generated for a single element type, so
+  the elements are packed (4 bytes for an int, instead of a 24 byte element_t)
+  and there is no type check / branch in the loops
+
+- DEFINE_VEC(name, T) generates the struct name##_t and the functions
+  name##_init, name##_append ... as static inline functions, use it once per
+  type in a header or a source file
+
+- equality (used by count, index & remove) defaults to ==, for structs (or a
+  custom match) use DEFINE_VEC_EQ(name, T, EQ) where EQ(a, b) is a macro or
+  a function taking two T values
+
+- the count loop is branchless, so the compiler can auto vectorize it for
+  the arithmetic types
+
+- element types are copied by value, a vector does not own anything the
+  elements point to
+
+usage :-
+  DEFINE_VEC(int_vec, int)
+
+  int_vec_t *v = int_vec_init();
+  int_vec_append(v, 42);
+  int_vec_count(v, 42);
+  int_vec_free(v);
+*/
+
+
+#define VEC_EQ_DEFAULT(a, b) ((a) == (b))
+
+
+#define DEFINE_VEC(name, T) DEFINE_VEC_EQ(name, T, VEC_EQ_DEFAULT)
+
+
+#define DEFINE_VEC_EQ(name, T, EQ)                                             \
+                                                                               \
+/* struct to define the vector */                                              \
+typedef struct {                                                               \
+  int size;            /* no of elements in the vector */                      \
+  int capacity;        /* no of elements the vector can hold */                \
+  T *data;             /* packed array of the elements */                      \
+} name##_t;                                                                    \
+                                                                               \
+                                                                               \
+static inline bool name##_is_full(name##_t *v) {                               \
+  return (v->size == v->capacity);                                             \
+}                                                                              \
+                                                                               \
+static inline bool name##_is_empty(name##_t *v) {                              \
+  return (v->size == 0);                                                       \
+}                                                                              \
+                                                                               \
+static inline int name##_size(name##_t *v) {                                   \
+  return v ? v->size : 0;                                                      \
+}                                                                              \
+                                                                               \
+                                                                               \
+static inline name##_t* name##_init() {                                        \
+  name##_t *v = malloc(sizeof(name##_t));                                      \
+  if (!v) return NULL;                                                         \
+                                                                               \
+  v->size = 0;                                                                 \
+  v->capacity = VEC_INIT_CAPACITY;                                             \
+                                                                               \
+  v->data = malloc(v->capacity * sizeof(T));                                   \
+  if (!v->data) {                                                              \
+    free(v);                                                                   \
+    return NULL;                                                               \
+  }                                                                            \
+  return v;                                                                    \
+}                                                                              \
+                                                                               \
+                                                                               \
+static inline void name##_free(name##_t *v) {                                  \
+  if (!v) return;                                                              \
+                                                                               \
+  free(v->data);                                                               \
+  free(v);                                                                     \
+}                                                                              \
+                                                                               \
+                                                                               \
+/* double the capacity */                                                      \
+static inline bool name##_resize(name##_t *v) {                                \
+  if (!v) return false;                                                        \
+                                                                               \
+  int new_capacity = v->capacity * VEC_SCALE_SIZE;                             \
+                                                                               \
+  T *new_memory = realloc(v->data, new_capacity * sizeof(T));                  \
+  if (!new_memory) return false;                                               \
+                                                                               \
+  v->capacity = new_capacity;                                                  \
+  v->data = new_memory;                                                        \
+  return true;                                                                 \
+}                                                                              \
+                                                                               \
+                                                                               \
+/* pointer to the element at idx, valid till the vector is modified next */   \
+static inline T* name##_get(name##_t *v, int idx) {                            \
+  if (!v || idx < 0 || idx >= v->size) return NULL;                            \
+                                                                               \
+  return &v->data[idx];                                                        \
+}                                                                              \
+                                                                               \
+                                                                               \
+static inline bool name##_append(name##_t *v, T val) {                         \
+  if (!v) return false;                                                        \
+                                                                               \
+  if (name##_is_full(v) && !name##_resize(v)) return false;                    \
+                                                                               \
+  v->data[v->size++] = val;                                                    \
+  return true;                                                                 \
+}                                                                              \
+                                                                               \
+                                                                               \
+/* move the elements from idx to right by one, slot at idx is left as is */    \
+static inline bool name##_move_right(name##_t *v, int idx) {                   \
+  if (!v || idx < 0 || idx >= v->size) return false;                           \
+                                                                               \
+  if (name##_is_full(v) && !name##_resize(v)) return false;                    \
+                                                                               \
+  memmove(&v->data[idx + 1], &v->data[idx], (v->size - idx) * sizeof(T));      \
+  v->size++;                                                                   \
+  return true;                                                                 \
+}                                                                              \
+                                                                               \
+                                                                               \
+/* move the elements after idx to left by one, element at idx is dropped */    \
+static inline bool name##_move_left(name##_t *v, int idx) {                    \
+  if (!v || idx < 0 || idx >= v->size) return false;                           \
+                                                                               \
+  memmove(&v->data[idx], &v->data[idx + 1], (v->size - idx - 1) * sizeof(T));  \
+  v->size--;                                                                   \
+  return true;                                                                 \
+}                                                                              \
+                                                                               \
+                                                                               \
+static inline bool name##_insert(name##_t *v, int idx, T val) {                \
+  if (!v || idx < 0 || idx > v->size) return false;                            \
+                                                                               \
+  if (idx == v->size) return name##_append(v, val);                            \
+                                                                               \
+  if (!name##_move_right(v, idx)) return false;                                \
+                                                                               \
+  v->data[idx] = val;                                                          \
+  return true;                                                                 \
+}                                                                              \
+                                                                               \
+                                                                               \
+/* no of elements equal to val, branchless so it can be vectorized */          \
+static inline int name##_count(name##_t *v, T val) {                           \
+  if (!v) return 0;                                                            \
+                                                                               \
+  int freq = 0;                                                                \
+  for (int i = 0; i < v->size; i++) freq += EQ(v->data[i], val) ? 1 : 0;       \
+  return freq;                                                                 \
+}                                                                              \
+                                                                               \
+                                                                               \
+/* index of the first element equal to val, -1 if there is none */            \
+static inline int name##_index(name##_t *v, T val) {                           \
+  if (!v) return -1;                                                           \
+                                                                               \
+  for (int i = 0; i < v->size; i++) {                                          \
+    if (EQ(v->data[i], val)) return i;                                         \
+  }                                                                            \
+  return -1;                                                                   \
+}                                                                              \
+                                                                               \
+                                                                               \
+/* remove the last element and copy it to out (if not NULL) */                 \
+static inline bool name##_pop(name##_t *v, T *out) {                           \
+  if (!v || name##_is_empty(v)) return false;                                  \
+                                                                               \
+  v->size--;                                                                   \
+  if (out) *out = v->data[v->size];                                            \
+  return true;                                                                 \
+}                                                                              \
+                                                                               \
+                                                                               \
+/* remove the first element equal to val */                                   \
+static inline void name##_remove(name##_t *v, T val) {                         \
+  int idx = name##_index(v, val);                                              \
+  if (idx == -1) return;                                                       \
+                                                                               \
+  name##_move_left(v, idx);                                                    \
+}                                                                              \
+                                                                               \
+                                                                               \
+static inline void name##_reverse(name##_t *v) {                               \
+  if (!v) return;                                                              \
+                                                                               \
+  for (int i = 0, j = v->size - 1; i < j; i++, j--) {                          \
+    T tmp = v->data[i];                                                        \
+    v->data[i] = v->data[j];                                                   \
+    v->data[j] = tmp;                                                          \
+  }                                                                            \
+}
+
+
+#endif   // __VEC_HEADER__
@@ -0,0 +1,649 @@
+#include "vec_scan.h"
+
+#include <math.h>
+#include <limits.h>
+#include <stdatomic.h>
+
+/*
+  The simd kernels keep 4 registers in flight (4 independent accumulators),
+  so the loop is bound by the memory bandwidth and not by the latency of the
+  add / min / compare. Whatever doesn't fill 4 registers is done one
+  register at a time, and the last few elements by the scalar loop.
+*/
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define VEC_SCAN_X86
+  #include <immintrin.h>
+#endif
+
+
+
+/* ---------- SCALAR ---------- */
+
+static int count_i32_scalar(const int arr[], int size, int val) {
+  int freq = 0;
+  for (int i = 0; i < size; i++) freq += arr[i] == val ? 1 : 0;
+  return freq;
+}
+
+static int find_i32_scalar(const int arr[], int size, int val) {
+  for (int i = 0; i < size; i++) {
+    if (arr[i] == val) return i;
+  }
+  return -1;
+}
+
+static int min_i32_scalar(const int arr[], int size) {
+  int min = INT_MAX;
+  for (int i = 0; i < size; i++) min = arr[i] < min ? arr[i] : min;
+  return min;
+}
+
+static int max_i32_scalar(const int arr[], int size) {
+  int max = INT_MIN;
+  for (int i = 0; i < size; i++) max = arr[i] > max ? arr[i] : max;
+  return max;
+}
+
+static long long sum_i32_scalar(const int arr[], int size) {
+  long long sum = 0;
+  for (int i = 0; i < size; i++) sum += arr[i];
+  return sum;
+}
+
+static int count_f32_scalar(const float arr[], int size, float val) {
+  int freq = 0;
+  for (int i = 0; i < size; i++) freq += arr[i] == val ? 1 : 0;
+  return freq;
+}
+
+static int find_f32_scalar(const float arr[], int size, float val) {
+  for (int i = 0; i < size; i++) {
+    if (arr[i] == val) return i;
+  }
+  return -1;
+}
+
+// a NaN fails the compare, so it never replaces the min / max
+static float min_f32_scalar(const float arr[], int size) {
+  float min = INFINITY;
+  for (int i = 0; i < size; i++) min = arr[i] < min ? arr[i] : min;
+  return min;
+}
+
+static float max_f32_scalar(const float arr[], int size) {
+  float max = -INFINITY;
+  for (int i = 0; i < size; i++) max = arr[i] > max ? arr[i] : max;
+  return max;
+}
+
+static double sum_f32_scalar(const float arr[], int size) {
+  double sum = 0;
+  for (int i = 0; i < size; i++) sum += arr[i];
+  return sum;
+}
+
+
+
+#ifdef VEC_SCAN_X86
+
+/* ---------- AVX2 :- 8 lanes per register ---------- */
+
+#define AVX2_FN static __attribute__((target("avx2")))
+
+#define AVX2_LOAD(p) _mm256_loadu_si256((const __m256i *)(p))
+
+AVX2_FN int count_i32_avx2(const int arr[], int size, int val) {
+  __m256i key = _mm256_set1_epi32(val);
+  __m256i acc0 = _mm256_setzero_si256(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  // a match is -1 in its lane, so subtracting it counts the match
+  for (; i + 32 <= size; i += 32) {
+    acc0 = _mm256_sub_epi32(acc0, _mm256_cmpeq_epi32(AVX2_LOAD(arr + i), key));
+    acc1 = _mm256_sub_epi32(acc1, _mm256_cmpeq_epi32(AVX2_LOAD(arr + i + 8), key));
+    acc2 = _mm256_sub_epi32(acc2, _mm256_cmpeq_epi32(AVX2_LOAD(arr + i + 16), key));
+    acc3 = _mm256_sub_epi32(acc3, _mm256_cmpeq_epi32(AVX2_LOAD(arr + i + 24), key));
+  }
+  for (; i + 8 <= size; i += 8)
+    acc0 = _mm256_sub_epi32(acc0, _mm256_cmpeq_epi32(AVX2_LOAD(arr + i), key));
+
+  acc0 = _mm256_add_epi32(_mm256_add_epi32(acc0, acc1), _mm256_add_epi32(acc2, acc3));
+
+  int lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, acc0);
+
+  int freq = count_i32_scalar(arr + i, size - i, val);
+  for (int l = 0; l < 8; l++) freq += lanes[l];
+  return freq;
+}
+
+AVX2_FN int find_i32_avx2(const int arr[], int size, int val) {
+  __m256i key = _mm256_set1_epi32(val);
+  int i = 0;
+
+  // look for any match in 4 registers, the exact lane is found below
+  for (; i + 32 <= size; i += 32) {
+    __m256i any = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi32(AVX2_LOAD(arr + i), key),
+                      _mm256_cmpeq_epi32(AVX2_LOAD(arr + i + 8), key)),
+      _mm256_or_si256(_mm256_cmpeq_epi32(AVX2_LOAD(arr + i + 16), key),
+                      _mm256_cmpeq_epi32(AVX2_LOAD(arr + i + 24), key)));
+
+    if (!_mm256_testz_si256(any, any)) break;
+  }
+  for (; i + 8 <= size; i += 8) {
+    __m256i eq = _mm256_cmpeq_epi32(AVX2_LOAD(arr + i), key);
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+    if (mask) return i + __builtin_ctz(mask);
+  }
+
+  int idx = find_i32_scalar(arr + i, size - i, val);
+  return idx == -1 ? -1 : i + idx;
+}
+
+AVX2_FN int min_i32_avx2(const int arr[], int size) {
+  __m256i acc0 = _mm256_set1_epi32(INT_MAX), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    acc0 = _mm256_min_epi32(acc0, AVX2_LOAD(arr + i));
+    acc1 = _mm256_min_epi32(acc1, AVX2_LOAD(arr + i + 8));
+    acc2 = _mm256_min_epi32(acc2, AVX2_LOAD(arr + i + 16));
+    acc3 = _mm256_min_epi32(acc3, AVX2_LOAD(arr + i + 24));
+  }
+  for (; i + 8 <= size; i += 8) acc0 = _mm256_min_epi32(acc0, AVX2_LOAD(arr + i));
+
+  acc0 = _mm256_min_epi32(_mm256_min_epi32(acc0, acc1), _mm256_min_epi32(acc2, acc3));
+
+  int lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, acc0);
+
+  int min = min_i32_scalar(arr + i, size - i);
+  for (int l = 0; l < 8; l++) min = lanes[l] < min ? lanes[l] : min;
+  return min;
+}
+
+AVX2_FN int max_i32_avx2(const int arr[], int size) {
+  __m256i acc0 = _mm256_set1_epi32(INT_MIN), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    acc0 = _mm256_max_epi32(acc0, AVX2_LOAD(arr + i));
+    acc1 = _mm256_max_epi32(acc1, AVX2_LOAD(arr + i + 8));
+    acc2 = _mm256_max_epi32(acc2, AVX2_LOAD(arr + i + 16));
+    acc3 = _mm256_max_epi32(acc3, AVX2_LOAD(arr + i + 24));
+  }
+  for (; i + 8 <= size; i += 8) acc0 = _mm256_max_epi32(acc0, AVX2_LOAD(arr + i));
+
+  acc0 = _mm256_max_epi32(_mm256_max_epi32(acc0, acc1), _mm256_max_epi32(acc2, acc3));
+
+  int lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, acc0);
+
+  int max = max_i32_scalar(arr + i, size - i);
+  for (int l = 0; l < 8; l++) max = lanes[l] > max ? lanes[l] : max;
+  return max;
+}
+
+AVX2_FN long long sum_i32_avx2(const int arr[], int size) {
+  __m256i acc0 = _mm256_setzero_si256(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  // widen every half register to 4 x 64 bit lanes before adding
+  for (; i + 16 <= size; i += 16) {
+    __m256i a = AVX2_LOAD(arr + i), b = AVX2_LOAD(arr + i + 8);
+    acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)));
+    acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)));
+    acc2 = _mm256_add_epi64(acc2, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(b)));
+    acc3 = _mm256_add_epi64(acc3, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(b, 1)));
+  }
+
+  acc0 = _mm256_add_epi64(_mm256_add_epi64(acc0, acc1), _mm256_add_epi64(acc2, acc3));
+
+  long long lanes[4];
+  _mm256_storeu_si256((__m256i *)lanes, acc0);
+
+  return sum_i32_scalar(arr + i, size - i) + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+AVX2_FN int count_f32_avx2(const float arr[], int size, float val) {
+  __m256 key = _mm256_set1_ps(val);
+  __m256i acc0 = _mm256_setzero_si256(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+#define AVX2_EQ_PS(p) _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(p), key, _CMP_EQ_OQ))
+
+  for (; i + 32 <= size; i += 32) {
+    acc0 = _mm256_sub_epi32(acc0, AVX2_EQ_PS(arr + i));
+    acc1 = _mm256_sub_epi32(acc1, AVX2_EQ_PS(arr + i + 8));
+    acc2 = _mm256_sub_epi32(acc2, AVX2_EQ_PS(arr + i + 16));
+    acc3 = _mm256_sub_epi32(acc3, AVX2_EQ_PS(arr + i + 24));
+  }
+  for (; i + 8 <= size; i += 8) acc0 = _mm256_sub_epi32(acc0, AVX2_EQ_PS(arr + i));
+
+  acc0 = _mm256_add_epi32(_mm256_add_epi32(acc0, acc1), _mm256_add_epi32(acc2, acc3));
+
+  int lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, acc0);
+
+  int freq = count_f32_scalar(arr + i, size - i, val);
+  for (int l = 0; l < 8; l++) freq += lanes[l];
+  return freq;
+}
+
+AVX2_FN int find_f32_avx2(const float arr[], int size, float val) {
+  __m256 key = _mm256_set1_ps(val);
+  int i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    __m256i any = _mm256_or_si256(_mm256_or_si256(AVX2_EQ_PS(arr + i), AVX2_EQ_PS(arr + i + 8)),
+                                  _mm256_or_si256(AVX2_EQ_PS(arr + i + 16), AVX2_EQ_PS(arr + i + 24)));
+
+    if (!_mm256_testz_si256(any, any)) break;
+  }
+  for (; i + 8 <= size; i += 8) {
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(AVX2_EQ_PS(arr + i)));
+    if (mask) return i + __builtin_ctz(mask);
+  }
+
+#undef AVX2_EQ_PS
+
+  int idx = find_f32_scalar(arr + i, size - i, val);
+  return idx == -1 ? -1 : i + idx;
+}
+
+// min_ps / max_ps give the second operand when either one is NaN, with the
+// accumulator as the second operand the NaNs are skipped
+AVX2_FN float min_f32_avx2(const float arr[], int size) {
+  __m256 acc0 = _mm256_set1_ps(INFINITY), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    acc0 = _mm256_min_ps(_mm256_loadu_ps(arr + i), acc0);
+    acc1 = _mm256_min_ps(_mm256_loadu_ps(arr + i + 8), acc1);
+    acc2 = _mm256_min_ps(_mm256_loadu_ps(arr + i + 16), acc2);
+    acc3 = _mm256_min_ps(_mm256_loadu_ps(arr + i + 24), acc3);
+  }
+  for (; i + 8 <= size; i += 8) acc0 = _mm256_min_ps(_mm256_loadu_ps(arr + i), acc0);
+
+  acc0 = _mm256_min_ps(_mm256_min_ps(acc0, acc1), _mm256_min_ps(acc2, acc3));
+
+  float lanes[8];
+  _mm256_storeu_ps(lanes, acc0);
+
+  float min = min_f32_scalar(arr + i, size - i);
+  for (int l = 0; l < 8; l++) min = lanes[l] < min ? lanes[l] : min;
+  return min;
+}
+
+AVX2_FN float max_f32_avx2(const float arr[], int size) {
+  __m256 acc0 = _mm256_set1_ps(-INFINITY), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    acc0 = _mm256_max_ps(_mm256_loadu_ps(arr + i), acc0);
+    acc1 = _mm256_max_ps(_mm256_loadu_ps(arr + i + 8), acc1);
+    acc2 = _mm256_max_ps(_mm256_loadu_ps(arr + i + 16), acc2);
+    acc3 = _mm256_max_ps(_mm256_loadu_ps(arr + i + 24), acc3);
+  }
+  for (; i + 8 <= size; i += 8) acc0 = _mm256_max_ps(_mm256_loadu_ps(arr + i), acc0);
+
+  acc0 = _mm256_max_ps(_mm256_max_ps(acc0, acc1), _mm256_max_ps(acc2, acc3));
+
+  float lanes[8];
+  _mm256_storeu_ps(lanes, acc0);
+
+  float max = max_f32_scalar(arr + i, size - i);
+  for (int l = 0; l < 8; l++) max = lanes[l] > max ? lanes[l] : max;
+  return max;
+}
+
+AVX2_FN double sum_f32_avx2(const float arr[], int size) {
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  // widen every half register to 4 doubles before adding
+  for (; i + 16 <= size; i += 16) {
+    __m256 a = _mm256_loadu_ps(arr + i), b = _mm256_loadu_ps(arr + i + 8);
+    acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(a)));
+    acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)));
+    acc2 = _mm256_add_pd(acc2, _mm256_cvtps_pd(_mm256_castps256_ps128(b)));
+    acc3 = _mm256_add_pd(acc3, _mm256_cvtps_pd(_mm256_extractf128_ps(b, 1)));
+  }
+
+  acc0 = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+
+  double lanes[4];
+  _mm256_storeu_pd(lanes, acc0);
+
+  return sum_f32_scalar(arr + i, size - i) + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+
+
+/* ---------- SSE4.1 :- 4 lanes per register ---------- */
+
+#define SSE41_FN static __attribute__((target("sse4.1")))
+
+#define SSE41_LOAD(p) _mm_loadu_si128((const __m128i *)(p))
+
+SSE41_FN int count_i32_sse41(const int arr[], int size, int val) {
+  __m128i key = _mm_set1_epi32(val);
+  __m128i acc0 = _mm_setzero_si128(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    acc0 = _mm_sub_epi32(acc0, _mm_cmpeq_epi32(SSE41_LOAD(arr + i), key));
+    acc1 = _mm_sub_epi32(acc1, _mm_cmpeq_epi32(SSE41_LOAD(arr + i + 4), key));
+    acc2 = _mm_sub_epi32(acc2, _mm_cmpeq_epi32(SSE41_LOAD(arr + i + 8), key));
+    acc3 = _mm_sub_epi32(acc3, _mm_cmpeq_epi32(SSE41_LOAD(arr + i + 12), key));
+  }
+  for (; i + 4 <= size; i += 4)
+    acc0 = _mm_sub_epi32(acc0, _mm_cmpeq_epi32(SSE41_LOAD(arr + i), key));
+
+  acc0 = _mm_add_epi32(_mm_add_epi32(acc0, acc1), _mm_add_epi32(acc2, acc3));
+
+  int lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, acc0);
+
+  return count_i32_scalar(arr + i, size - i, val) + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+SSE41_FN int find_i32_sse41(const int arr[], int size, int val) {
+  __m128i key = _mm_set1_epi32(val);
+  int i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    __m128i any = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi32(SSE41_LOAD(arr + i), key),
+                   _mm_cmpeq_epi32(SSE41_LOAD(arr + i + 4), key)),
+      _mm_or_si128(_mm_cmpeq_epi32(SSE41_LOAD(arr + i + 8), key),
+                   _mm_cmpeq_epi32(SSE41_LOAD(arr + i + 12), key)));
+
+    if (!_mm_testz_si128(any, any)) break;
+  }
+  for (; i + 4 <= size; i += 4) {
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(SSE41_LOAD(arr + i), key)));
+    if (mask) return i + __builtin_ctz(mask);
+  }
+
+  int idx = find_i32_scalar(arr + i, size - i, val);
+  return idx == -1 ? -1 : i + idx;
+}
+
+SSE41_FN int min_i32_sse41(const int arr[], int size) {
+  __m128i acc0 = _mm_set1_epi32(INT_MAX), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    acc0 = _mm_min_epi32(acc0, SSE41_LOAD(arr + i));
+    acc1 = _mm_min_epi32(acc1, SSE41_LOAD(arr + i + 4));
+    acc2 = _mm_min_epi32(acc2, SSE41_LOAD(arr + i + 8));
+    acc3 = _mm_min_epi32(acc3, SSE41_LOAD(arr + i + 12));
+  }
+  for (; i + 4 <= size; i += 4) acc0 = _mm_min_epi32(acc0, SSE41_LOAD(arr + i));
+
+  acc0 = _mm_min_epi32(_mm_min_epi32(acc0, acc1), _mm_min_epi32(acc2, acc3));
+
+  int lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, acc0);
+
+  int min = min_i32_scalar(arr + i, size - i);
+  for (int l = 0; l < 4; l++) min = lanes[l] < min ? lanes[l] : min;
+  return min;
+}
+
+SSE41_FN int max_i32_sse41(const int arr[], int size) {
+  __m128i acc0 = _mm_set1_epi32(INT_MIN), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    acc0 = _mm_max_epi32(acc0, SSE41_LOAD(arr + i));
+    acc1 = _mm_max_epi32(acc1, SSE41_LOAD(arr + i + 4));
+    acc2 = _mm_max_epi32(acc2, SSE41_LOAD(arr + i + 8));
+    acc3 = _mm_max_epi32(acc3, SSE41_LOAD(arr + i + 12));
+  }
+  for (; i + 4 <= size; i += 4) acc0 = _mm_max_epi32(acc0, SSE41_LOAD(arr + i));
+
+  acc0 = _mm_max_epi32(_mm_max_epi32(acc0, acc1), _mm_max_epi32(acc2, acc3));
+
+  int lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, acc0);
+
+  int max = max_i32_scalar(arr + i, size - i);
+  for (int l = 0; l < 4; l++) max = lanes[l] > max ? lanes[l] : max;
+  return max;
+}
+
+SSE41_FN long long sum_i32_sse41(const int arr[], int size) {
+  __m128i acc0 = _mm_setzero_si128(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 8 <= size; i += 8) {
+    __m128i a = SSE41_LOAD(arr + i), b = SSE41_LOAD(arr + i + 4);
+    acc0 = _mm_add_epi64(acc0, _mm_cvtepi32_epi64(a));
+    acc1 = _mm_add_epi64(acc1, _mm_cvtepi32_epi64(_mm_unpackhi_epi64(a, a)));
+    acc2 = _mm_add_epi64(acc2, _mm_cvtepi32_epi64(b));
+    acc3 = _mm_add_epi64(acc3, _mm_cvtepi32_epi64(_mm_unpackhi_epi64(b, b)));
+  }
+
+  acc0 = _mm_add_epi64(_mm_add_epi64(acc0, acc1), _mm_add_epi64(acc2, acc3));
+
+  long long lanes[2];
+  _mm_storeu_si128((__m128i *)lanes, acc0);
+
+  return sum_i32_scalar(arr + i, size - i) + lanes[0] + lanes[1];
+}
+
+SSE41_FN int count_f32_sse41(const float arr[], int size, float val) {
+  __m128 key = _mm_set1_ps(val);
+  __m128i acc0 = _mm_setzero_si128(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+#define SSE41_EQ_PS(p) _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(p), key))
+
+  for (; i + 16 <= size; i += 16) {
+    acc0 = _mm_sub_epi32(acc0, SSE41_EQ_PS(arr + i));
+    acc1 = _mm_sub_epi32(acc1, SSE41_EQ_PS(arr + i + 4));
+    acc2 = _mm_sub_epi32(acc2, SSE41_EQ_PS(arr + i + 8));
+    acc3 = _mm_sub_epi32(acc3, SSE41_EQ_PS(arr + i + 12));
+  }
+  for (; i + 4 <= size; i += 4) acc0 = _mm_sub_epi32(acc0, SSE41_EQ_PS(arr + i));
+
+  acc0 = _mm_add_epi32(_mm_add_epi32(acc0, acc1), _mm_add_epi32(acc2, acc3));
+
+  int lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, acc0);
+
+  return count_f32_scalar(arr + i, size - i, val) + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+SSE41_FN int find_f32_sse41(const float arr[], int size, float val) {
+  __m128 key = _mm_set1_ps(val);
+  int i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    __m128i any = _mm_or_si128(_mm_or_si128(SSE41_EQ_PS(arr + i), SSE41_EQ_PS(arr + i + 4)),
+                               _mm_or_si128(SSE41_EQ_PS(arr + i + 8), SSE41_EQ_PS(arr + i + 12)));
+
+    if (!_mm_testz_si128(any, any)) break;
+  }
+  for (; i + 4 <= size; i += 4) {
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(SSE41_EQ_PS(arr + i)));
+    if (mask) return i + __builtin_ctz(mask);
+  }
+
+#undef SSE41_EQ_PS
+
+  int idx = find_f32_scalar(arr + i, size - i, val);
+  return idx == -1 ? -1 : i + idx;
+}
+
+SSE41_FN float min_f32_sse41(const float arr[], int size) {
+  __m128 acc0 = _mm_set1_ps(INFINITY), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    acc0 = _mm_min_ps(_mm_loadu_ps(arr + i), acc0);
+    acc1 = _mm_min_ps(_mm_loadu_ps(arr + i + 4), acc1);
+    acc2 = _mm_min_ps(_mm_loadu_ps(arr + i + 8), acc2);
+    acc3 = _mm_min_ps(_mm_loadu_ps(arr + i + 12), acc3);
+  }
+  for (; i + 4 <= size; i += 4) acc0 = _mm_min_ps(_mm_loadu_ps(arr + i), acc0);
+
+  acc0 = _mm_min_ps(_mm_min_ps(acc0, acc1), _mm_min_ps(acc2, acc3));
+
+  float lanes[4];
+  _mm_storeu_ps(lanes, acc0);
+
+  float min = min_f32_scalar(arr + i, size - i);
+  for (int l = 0; l < 4; l++) min = lanes[l] < min ? lanes[l] : min;
+  return min;
+}
+
+SSE41_FN float max_f32_sse41(const float arr[], int size) {
+  __m128 acc0 = _mm_set1_ps(-INFINITY), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    acc0 = _mm_max_ps(_mm_loadu_ps(arr + i), acc0);
+    acc1 = _mm_max_ps(_mm_loadu_ps(arr + i + 4), acc1);
+    acc2 = _mm_max_ps(_mm_loadu_ps(arr + i + 8), acc2);
+    acc3 = _mm_max_ps(_mm_loadu_ps(arr + i + 12), acc3);
+  }
+  for (; i + 4 <= size; i += 4) acc0 = _mm_max_ps(_mm_loadu_ps(arr + i), acc0);
+
+  acc0 = _mm_max_ps(_mm_max_ps(acc0, acc1), _mm_max_ps(acc2, acc3));
+
+  float lanes[4];
+  _mm_storeu_ps(lanes, acc0);
+
+  float max = max_f32_scalar(arr + i, size - i);
+  for (int l = 0; l < 4; l++) max = lanes[l] > max ? lanes[l] : max;
+  return max;
+}
+
+SSE41_FN double sum_f32_sse41(const float arr[], int size) {
+  __m128d acc0 = _mm_setzero_pd(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  int i = 0;
+
+  for (; i + 8 <= size; i += 8) {
+    __m128 a = _mm_loadu_ps(arr + i), b = _mm_loadu_ps(arr + i + 4);
+    acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(a));
+    acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(a, a)));
+    acc2 = _mm_add_pd(acc2, _mm_cvtps_pd(b));
+    acc3 = _mm_add_pd(acc3, _mm_cvtps_pd(_mm_movehl_ps(b, b)));
+  }
+
+  acc0 = _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3));
+
+  double lanes[2];
+  _mm_storeu_pd(lanes, acc0);
+
+  return sum_f32_scalar(arr + i, size - i) + lanes[0] + lanes[1];
+}
+
+#endif   // VEC_SCAN_X86
+
+
+
+/* ---------- RUNTIME DISPATCH ---------- */
+
+#define KERNELS(isa) {                                                        \
+  count_i32_##isa, find_i32_##isa, min_i32_##isa, max_i32_##isa, sum_i32_##isa, \
+  count_f32_##isa, find_f32_##isa, min_f32_##isa, max_f32_##isa, sum_f32_##isa  \
+}
+
+static const vs_kernels_t SCAN_KERNELS[] = {
+#ifdef VEC_SCAN_X86
+  [VS_SCALAR] = KERNELS(scalar),
+  [VS_SSE41]  = KERNELS(sse41),
+  [VS_AVX2]   = KERNELS(avx2),
+#else
+  [VS_SCALAR] = KERNELS(scalar),
+  [VS_SSE41]  = KERNELS(scalar),
+  [VS_AVX2]   = KERNELS(scalar),
+#endif
+};
+
+// resolved on the first call, -1 until then
+static atomic_int scan_isa = -1;
+
+
+
+vs_isa_t vs_isa() {
+  int isa = atomic_load_explicit(&scan_isa, memory_order_relaxed);
+  if (isa >= 0) return (vs_isa_t)isa;
+
+  isa = VS_SCALAR;
+#ifdef VEC_SCAN_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) isa = VS_AVX2;
+  else if (__builtin_cpu_supports("sse4.1")) isa = VS_SSE41;
+#endif
+
+  atomic_store_explicit(&scan_isa, isa, memory_order_relaxed);
+  return (vs_isa_t)isa;
+}
+
+
+
+const vs_kernels_t* vs_kernels(vs_isa_t isa) {
+  // a kernel the cpu can't run, goes to the scalar kernel
+  if (isa < VS_SCALAR || isa > vs_isa()) isa = VS_SCALAR;
+
+  return &SCAN_KERNELS[isa];
+}
+
+
+
+int vs_count_i32(const int arr[], int size, int val) {
+  if (!arr || size <= 0) return 0;
+  return vs_kernels(vs_isa())->count_i32(arr, size, val);
+}
+
+int vs_find_i32(const int arr[], int size, int val) {
+  if (!arr || size <= 0) return -1;
+  return vs_kernels(vs_isa())->find_i32(arr, size, val);
+}
+
+int vs_min_i32(const int arr[], int size) {
+  if (!arr || size <= 0) return INT_MAX;
+  return vs_kernels(vs_isa())->min_i32(arr, size);
+}
+
+int vs_max_i32(const int arr[], int size) {
+  if (!arr || size <= 0) return INT_MIN;
+  return vs_kernels(vs_isa())->max_i32(arr, size);
+}
+
+long long vs_sum_i32(const int arr[], int size) {
+  if (!arr || size <= 0) return 0;
+  return vs_kernels(vs_isa())->sum_i32(arr, size);
+}
+
+int vs_count_f32(const float arr[], int size, float val) {
+  if (!arr || size <= 0) return 0;
+  return vs_kernels(vs_isa())->count_f32(arr, size, val);
+}
+
+int vs_find_f32(const float arr[], int size, float val) {
+  if (!arr || size <= 0) return -1;
+  return vs_kernels(vs_isa())->find_f32(arr, size, val);
+}
+
+float vs_min_f32(const float arr[], int size) {
+  if (!arr || size <= 0) return INFINITY;
+  return vs_kernels(vs_isa())->min_f32(arr, size);
+}
+
+float vs_max_f32(const float arr[], int size) {
+  if (!arr || size <= 0) return -INFINITY;
+  return vs_kernels(vs_isa())->max_f32(arr, size);
+}
+
+double vs_sum_f32(const float arr[], int size) {
+  if (!arr || size <= 0) return 0;
+  return vs_kernels(vs_isa())->sum_f32(arr, size);
+}
@@ -0,0 +1,130 @@
+#ifndef __VEC_SCAN_HEADER__
+#define __VEC_SCAN_HEADER__
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/*
+Some Design Notes:
+- scan kernels (count, find, min, max, sum) for packed int and float arrays,
+  like the data of an int / float vector from vec.h
+
+  int_vec_t *v = ...;
+  int freq = vs_count_i32(v->data, v->size, 42);
+
+- every kernel has a scalar, an SSE4.1 and an AVX2 version, the best one the
+  cpu supports is picked on the first call (runtime dispatch)
+
+- float compares are the ordered ==, so NaN never matches. min / max skip
+  the NaNs, and return +INF / -INF (INT_MAX / INT_MIN for ints) on an empty
+  array
+
+- sums are accumulated in wider types (long long / double), the simd
+  kernels add in a different order, so a float sum can differ from the
+  scalar one in the last few bits
+*/
+
+
+/* instruction sets with a kernel */
+typedef enum {
+  VS_SCALAR,
+  VS_SSE41,               // 4 lanes per register
+  VS_AVX2                 // 8 lanes per register
+} vs_isa_t;
+
+
+/* one set of kernels */
+typedef struct {
+  int (*count_i32)(const int *, int, int);
+  int (*find_i32)(const int *, int, int);
+  int (*min_i32)(const int *, int);
+  int (*max_i32)(const int *, int);
+  long long (*sum_i32)(const int *, int);
+
+  int (*count_f32)(const float *, int, float);
+  int (*find_f32)(const float *, int, float);
+  float (*min_f32)(const float *, int);
+  float (*max_f32)(const float *, int);
+  double (*sum_f32)(const float *, int);
+} vs_kernels_t;
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Best instruction set the cpu supports, resolved on the first call
+ *
+ * time complexity  -> O(1)
+ * space complexity -> O(1)
+ *
+ * @return vs_isa_t
+ */
+vs_isa_t vs_isa();
+
+/**
+ * @brief Kernels for the given instruction set, if the cpu can't run them
+ *        the scalar kernels are given instead
+ *
+ * time complexity  -> O(1)
+ * space complexity -> O(1)
+ *
+ * @param vs_isa_t - instruction set
+ * @return const vs_kernels_t*
+ */
+const vs_kernels_t* vs_kernels(vs_isa_t);
+
+/**
+ * @brief No of elements equal to the value
+ *
+ * time complexity  -> O(N)
+ * space complexity -> O(1)
+ *
+ * @param int * - packed array
+ * @param int - no of elements
+ * @param int - value to count
+ * @return int
+ */
+int vs_count_i32(const int *, int, int);
+
+/**
+ * @brief Index of the first element equal to the value, -1 if none
+ *
+ * time complexity  -> O(N)
+ * space complexity -> O(1)
+ */
+int vs_find_i32(const int *, int, int);
+
+/**
+ * @brief Smallest / largest element, INT_MAX / INT_MIN if the array is empty
+ *
+ * time complexity  -> O(N)
+ * space complexity -> O(1)
+ */
+int vs_min_i32(const int *, int);
+int vs_max_i32(const int *, int);
+
+/**
+ * @brief Sum of the elements, without overflow for upto 2^32 elements
+ *
+ * time complexity  -> O(N)
+ * space complexity -> O(1)
+ */
+long long vs_sum_i32(const int *, int);
+
+/**
+ * @brief Float versions of the above, see the design notes for NaN
+ *
+ * time complexity  -> O(N)
+ * space complexity -> O(1)
+ */
+int vs_count_f32(const float *, int, float);
+int vs_find_f32(const float *, int, float);
+float vs_min_f32(const float *, int);
+float vs_max_f32(const float *, int);
+double vs_sum_f32(const float *, int);
+
+
+#endif   // __VEC_SCAN_HEADER__
@@ -1,8 +1,17 @@
 #include "hlinked_list.h"
 
 
+static node_t* dhll_make_node(pool_t *, etype_t, void *);
+
+
 
 dhlinkedlist_t* dhll_init() {
+  return dhll_init_pool(NULL);
+}
+
+
+
+dhlinkedlist_t* dhll_init_pool(pool_t *pool) {
   dhlinkedlist_t *dhll = malloc(sizeof(dhlinkedlist_t));
   if (!dhll) return NULL;
 
@@ -10,6 +19,7 @@ dhlinkedlist_t* dhll_init() {
   dhll->size = 0;
   dhll->head = NULL;
   dhll->tail = NULL;
+  dhll->pool = pool;
   return dhll;
 }
 
@@ -19,7 +29,7 @@ bool dhll_append(dhlinkedlist_t *dhll, etype_t etype, void *val) {
   if (!dhll || !val) return false;
 
   // create a node and update it with the value
-  node_t *new_node = dhll_new_node(etype, val);
+  node_t *new_node = dhll_make_node(dhll->pool, etype, val);
   if (!new_node) return false;
 
   // linked list has no nodes
@@ -49,7 +59,7 @@ bool dhll_insert(dhlinkedlist_t *dhll, int idx, etype_t etype, void *val) {
     return dhll_append(dhll, etype, val);
 
   // create node and update it with the value
-  node_t *new_node = dhll_new_node(etype, val);
+  node_t *new_node = dhll_make_node(dhll->pool, etype, val);
   if (!new_node) return false;
 
   if (idx == 0) {
@@ -68,7 +78,7 @@ bool dhll_insert(dhlinkedlist_t *dhll, int idx, etype_t etype, void *val) {
     // get the node at the insert positon
     node_t *idx_node = dhll_get(dhll, idx);
     if (!idx_node) {
-      dhll_free_node(new_node);
+      dhll_recycle_node(dhll, new_node);
       return false;
     }
 
@@ -106,26 +116,14 @@ node_t* dhll_get(dhlinkedlist_t *dhll, int idx) {
 int dhll_count(dhlinkedlist_t *dhll, etype_t etype, void *val) {
   if (!dhll || dhll->size == 0 || !val) return 0;
 
+  element_t key;
+  if (!el_key(&key, etype, val, NULL)) return 0;
+
   node_t *curr = dhll->head;
   int freq = 0;
 
   while (curr) {
-    switch (etype) {
-      case INT:
-        freq += curr->data.value.ival == *(int *)val ? 1 : 0;
-        break;
-
-      case FLO:
-        freq += curr->data.value.fval == *(float *)val ? 1 : 0;
-        break;
-
-      case STR:
-        freq += strcmp(curr->data.value.sval, (char *)val) == 0 ? 1 : 0;
-        break;
-
-      default:
-        return 0;
-    }
+    freq += el_match(&curr->data, &key, NULL) ? 1 : 0;
     curr = curr->next;
   }
   return freq;
@@ -136,28 +134,12 @@ int dhll_count(dhlinkedlist_t *dhll, etype_t etype, void *val) {
 int dhll_index(dhlinkedlist_t *dhll, etype_t etype, void *val) {
   if (!dhll || dhll->size == 0 || !val) return -1;
 
+  element_t key;
+  if (!el_key(&key, etype, val, NULL)) return -1;
+
   node_t *curr = dhll->head;
   for (int i = 0; curr != NULL; i++, curr = curr->next) {
-    switch (etype) {
-      case INT: {
-        if (curr->data.value.ival == *(int *)val) return i;
-        break;
-      }
-
-      case FLO: {
-        if (curr->data.value.fval == *(float *)val) return i;
-        break;
-      }
-
-      case STR: {
-        if (strcmp(curr->data.value.sval, (char *)val) == 0) return i;
-        break;
-      }
-
-      default:
-        // invalid element type found
-        return -1;
-    }
+    if (el_match(&curr->data, &key, NULL)) return i;
   }
   return -1;
 }
@@ -193,25 +175,14 @@ node_t* dhll_pop(dhlinkedlist_t *dhll) {
 bool dhll_remove(dhlinkedlist_t *dhll, etype_t etype, void *val) {
   if (!dhll || dhll->size <= 0 || !val) return false;
 
+  element_t key;
+  if (!el_key(&key, etype, val, NULL)) return false;
+
   node_t *curr = dhll->head;
   bool is_match = false;
 
   while (curr) {
-    switch (etype) {
-      case INT:
-        is_match = ( curr->data.value.ival == *(int *)val );
-        break;
-
-      case FLO:
-        is_match = ( curr->data.value.fval == *(float *)val );
-        break;
-
-      case STR:
-        is_match =  ( strcmp(curr->data.value.sval, (char *)val) == 0 );
-        break;
-
-      default: return false;    // invalid element type
-    }
+    is_match = el_match(&curr->data, &key, NULL);
 
     // we got a match
     if (is_match) {
@@ -232,7 +203,7 @@ bool dhll_remove(dhlinkedlist_t *dhll, etype_t etype, void *val) {
         curr->prev->next = curr->next;  // update prev node's next ref
         curr->next->prev = curr->prev;  // update next node's prev ref
       }
-      dhll_free_node(curr);   // finally, free the removed node
+      dhll_recycle_node(dhll, curr);   // finally, free the removed node
       dhll->size--;           // decrement the node's count
       return true;
     }
@@ -280,12 +251,7 @@ void dhll_print(dhlinkedlist_t *dhll) {
   printf("[");
 
   while (curr != NULL) {
-    switch (curr->data.etype) {
-      case INT: printf("%d", curr->data.value.ival); break;
-      case FLO: printf("%f", curr->data.value.fval); break;
-      case STR: printf("\"%s\"", curr->data.value.sval); break;
-      default: return;    // invalid element type
-    }
+    if (!el_print(&curr->data)) return;    // invalid element type
     curr = curr->next;
 
     if (curr) printf(", ");
@@ -304,7 +270,7 @@ void dhll_free(dhlinkedlist_t *dhll) {
     node_t *todel = curr;    // note the reference of the node to be freed
     curr = curr->next;       // update the curr to next node
 
-    dhll_free_node(todel);
+    dhll_recycle_node(dhll, todel);
   }
 
   // finally free the linkedlist_t struct
@@ -315,52 +281,49 @@ void dhll_free(dhlinkedlist_t *dhll) {
 
 /* ---------- UTIL FUNCTIONS ---------- */
 
-node_t* dhll_new_node(etype_t etype, void *val) {
-  node_t *new_node = malloc(sizeof(node_t));
+/* allocate the node from the pool (malloc, if there is no pool) */
+static node_t* dhll_make_node(pool_t *pool, etype_t etype, void *val) {
+  node_t *new_node = pool_get(pool, sizeof(node_t));
   if (!new_node) return NULL;
 
   // initialize with values
   new_node->next = NULL;
   new_node->prev = NULL;
 
-  switch (etype) {
-    case INT:
-      // typecast void pointer to int pointer (int *) and then de-reference *
-      new_node->data.value.ival = *(int *)val;
-      break;
-
-    case FLO: 
-      new_node->data.value.fval = *(float *)val; 
-      break;
-
-    case STR: {
-      new_node->data.value.sval = strdup( (char *)val );
-      if (!new_node->data.value.sval) {
-        dhll_free_node(new_node);
-        return NULL;
-      }
-      break;
-    }
-
-    default:
-      // if we reach here, then invalid etype is passed in
-      // release the memory of new node and return
-      dhll_free_node(new_node);
-      return NULL;
+  if (!el_set(&new_node->data, etype, val, NULL)) {
+    // invalid etype or out of memory
+    pool_put(pool, new_node);
+    return NULL;
   }
-  new_node->data.etype = etype;  // update the value type
   return new_node;
 }
 
 
 
+node_t* dhll_new_node(etype_t etype, void *val) {
+  return dhll_make_node(NULL, etype, val);
+}
+
+
+
 void dhll_free_node(node_t *n) {
   if (!n) return;
 
-  // if node's value is string, then free it
-  if (n->data.etype == STR) free(n->data.value.sval);
+  // release the value (a string is freed)
+  el_clear(&n->data, NULL);
 
   // free the node
   free(n);
 }
 
+
+
+void dhll_recycle_node(dhlinkedlist_t *dhll, node_t *n) {
+  if (!n) return;
+
+  // release the value (a string is freed)
+  el_clear(&n->data, NULL);
+
+  // give the node back to the allocator it came from
+  pool_put(dhll ? dhll->pool : NULL, n);
+}
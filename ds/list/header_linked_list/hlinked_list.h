@@ -20,21 +20,8 @@
 #include <stdbool.h>
 #include <string.h>
 
-/* specify the permitted value type */
-typedef enum { INT, FLO, STR } etype_t;
-
-
-/* define an element, used in info part of the node */
-typedef struct {
-  etype_t etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
-
+#include "pool.h"
+#include "element.h"
 
 /* structure to represent the node of double linked list */
 typedef struct node {
@@ -49,6 +36,7 @@ typedef struct {
   int size;             // no of nodes in the linked list
   struct node *head;   // ref to first node of the linked list
   struct node *tail;    // ref to last node of the linked list
+  pool_t *pool;         // allocator for the nodes, NULL to use malloc
 } dhlinkedlist_t;
 
 
@@ -67,6 +55,18 @@ typedef struct {
  */
 dhlinkedlist_t* dhll_init();
 
+/**
+ * @brief Same as dhll_init, but the nodes are allocated from the pool.
+ *        pool can be shared by many lists, and must outlive them
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param pool_t* - pool of sizeof(node_t) slots, NULL to use malloc
+ * @return dhlinkedlist_t* 
+ */
+dhlinkedlist_t* dhll_init_pool(pool_t *);
+
 /**
  * @brief Create a new node and add it to the end of linked list.
  *        If  linked list has no nodes, then upate it as the first node.
@@ -147,7 +147,8 @@ int dhll_index(dhlinkedlist_t *, etype_t, void *);
  * 
  * @param dlinkedlist_t* - reference to dlinkedlist_t struct 
  * @return node_t* - returns the last node, NULL if not present
- *                   user has to take care of freeing the memeory of popped node
+ *                   release it with dhll_recycle_node, dhll_free_node is an
+ *                   invalid free for a node from a pool
  */
 node_t* dhll_pop(dhlinkedlist_t *);
 
@@ -226,10 +227,22 @@ node_t* dhll_new_node(etype_t, void *);
 
 /**
  * @brief Free the node. if the node's value is string, then free the string too
+ *        only for the nodes from dhll_new_node, or a list without a pool
  * 
  * @param node_t* - pointer to node_t struct
  */
 void dhll_free_node(node_t *);
 
+/**
+ * @brief Free a node of the list, back to the allocator it came from
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param dhlinkedlist_t* - ref to dhlinkedlist_t struct the node came from
+ * @param node_t* - pointer to node_t struct
+ */
+void dhll_recycle_node(dhlinkedlist_t *, node_t *);
+
 
 #endif   // __DOUBLE_HEADER_LINKED_LIST__
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "linked_list.h"
+
+#include <time.h>
+
+/*
+  Regression bench for the tail / size kept in linkedlist_t :- building a
+  list with ll_append is linear, so the ns per append stays flat as the
+  list grows (it grew with N when every append walked to the last node).
+  usage :- bench_linked_list [largest no of elements]     ; default is 1e6
+*/
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+static void report(const char *op, int n, long ops, double elapsed) {
+  printf("%-12s %10d %12ld %10.2f\n", op, n, ops, elapsed * 1e9 / ops);
+}
+
+
+
+int main(int argc, char *argv[]) {
+  int max = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (max <= 0) return 1;
+
+  printf("%-12s %10s %12s %10s\n", "operation", "size", "ops", "ns/op");
+
+  for (int n = max / 100 > 0 ? max / 100 : 1; n <= max; n *= 10) {
+    linkedlist_t *ll = ll_init();
+    if (!ll) return 1;
+
+    double start = now_sec();
+    for (int i = 0; i < n; i++) ll_append(ll, INT, &i);
+    report("append", n, n, now_sec() - start);
+
+    // size and the last node, O(1) each
+    long long sum = 0;
+    int calls = 1000000;
+    start = now_sec();
+    for (int i = 0; i < calls; i++) sum += ll_size(ll) + ll_last_node(ll)->data.value.ival;
+    report("size_last", n, calls, now_sec() - start);
+
+    // pops walk to the second to last node, kept small
+    int pops = n < 100 ? n : 100;
+    start = now_sec();
+    for (int i = 0; i < pops; i++) ll_free_node(ll_pop(ll));
+    report("pop", n, pops, now_sec() - start);
+
+    if (sum == 42) puts("");    // keep the size loop
+    ll_free(ll);
+  }
+
+  return 0;
+}
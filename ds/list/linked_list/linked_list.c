@@ -2,38 +2,69 @@
 
 
 linkedlist_t* ll_init() {
+  return ll_init_pool(NULL);
+}
+
+
+
+linkedlist_t* ll_init_pool(pool_t *pool) {
   linkedlist_t *ll = malloc(sizeof(linkedlist_t));
   if (!ll) return NULL;
 
   // initialize the linkedlist
   ll->head = NULL;
+  ll->tail = NULL;
+  ll->size = 0;
+  ll->pool = pool;
+  ll->intern = NULL;
 
   return ll;
 }
 
 
 
+bool ll_use_intern(linkedlist_t *ll, intern_t *intern) {
+  if (!ll || ll->head) return false;
+
+  ll->intern = intern;
+  return true;
+}
+
+
+
+/* allocate the node from the pool (malloc, if there is no pool), a long
+   string is interned if there is a table */
+static node_t* ll_make_node(pool_t *pool, intern_t *intern, etype_t etype, void *val) {
+  node_t *new_node = pool_get(pool, sizeof(node_t));
+  if (!new_node) return NULL;
+
+  // update the node with the value
+  new_node->next = NULL;
+
+  if (!el_set(&new_node->data, etype, val, intern)) {
+    // invalid etype or out of memory, release the new node
+    pool_put(pool, new_node);
+    return NULL;
+  }
+
+  return new_node;
+}
+
+
+
 bool ll_append(linkedlist_t *ll, etype_t etype, void *val) {
   if (!ll || !val) return false;
 
   // create node and update it with the value
-  node_t *new_node = ll_new_node(etype, val);
+  node_t *new_node = ll_make_node(ll->pool, ll->intern, etype, val);
   if (!new_node) return false;
 
   // linked list has no nodes
-  if (ll->head == NULL) {
-    ll->head = new_node;
-    return true;
-  }
+  if (ll->head == NULL) ll->head = new_node;
+  else ll->tail->next = new_node;     // link it after the last node
 
-  // linked list has nodes
-  node_t *last_node = ll_last_node(ll);
-  if (!last_node) {
-    ll_free_node(new_node);      // release the memory of new node
-    return false;
-  }
-
-  last_node->next = new_node;
+  ll->tail = new_node;
+  ll->size++;
   return true;
 }
 
@@ -51,31 +82,43 @@ bool ll_insert(linkedlist_t *ll, int idx, etype_t etype, void *val) {
       return false;
   }
 
+  // insertion at the end, no walk needed
+  if (idx == ll->size) return ll_append(ll, etype, val);
+
   // create a new node and update it with value
-  node_t *new_node = ll_new_node(etype, val);
+  node_t *new_node = ll_make_node(ll->pool, ll->intern, etype, val);
   if (!new_node) return false;
 
   // insertion at the head position
   if (idx == 0) {
     new_node->next = ll->head;
     ll->head = new_node;
+    ll->size++;
     return true;
   }
 
   // get the node; one before the idx position
   node_t *idx_node = ll_get(ll, idx - 1);
-  if (!idx_node) return false;
+  if (!idx_node) {
+    ll_recycle_node(ll, new_node);
+    return false;
+  }
 
-  // link the new node after the idx node
+  // link the new node after the idx node, it's never the last one (that
+  // was an append)
   new_node->next = idx_node->next;
   idx_node->next = new_node;
+  ll->size++;
   return true;
 }
 
 
 
 node_t* ll_get(linkedlist_t *ll, int idx) {
-  if (!ll || idx < 0) return NULL;
+  if (!ll || idx < 0 || idx >= ll->size) return NULL;
+
+  // last node is kept, no walk needed
+  if (idx == ll->size - 1) return ll->tail;
 
   node_t *head = ll->head;
 
@@ -93,27 +136,14 @@ node_t* ll_get(linkedlist_t *ll, int idx) {
 int ll_count(linkedlist_t *ll, etype_t etype, void *val) {
   if (!ll || !ll->head || !val) return 0;
 
+  element_t key;
+  if (!el_key(&key, etype, val, ll->intern)) return 0;
+
   node_t *head = ll->head;
   int freq = 0;
 
   while (head) {
-    switch (etype) {
-      case INT:
-        freq += head->data.value.ival == *(int *)val ? 1 : 0;
-        break;
-
-      case FLO:
-        freq += head->data.value.fval == *(float *)val ? 1 : 0;
-        break;
-
-      case STR:
-        freq += strcmp(head->data.value.sval, (char *)val) == 0 ? 1 : 0;
-        break;
-
-      default:
-        return 0;
-    }
-
+    freq += el_match(&head->data, &key, ll->intern) ? 1 : 0;
     head  = head->next;
   }
   return freq;
@@ -124,28 +154,12 @@ int ll_count(linkedlist_t *ll, etype_t etype, void *val) {
 int ll_index(linkedlist_t *ll, etype_t etype, void *val) {
   if (!ll || !ll->head || !val) return -1;
 
+  element_t key;
+  if (!el_key(&key, etype, val, ll->intern)) return -1;
+
   node_t *head = ll->head;
   for (int i = 0; head != NULL; i++, head = head->next) {
-    switch (etype) {
-      case INT: {
-        if (head->data.value.ival == *(int *)val) return i;
-        break;
-      }
-
-      case FLO: {
-        if (head->data.value.fval == *(float *)val) return i;
-        break;
-      }
-
-      case STR: {
-        if (strcmp(head->data.value.sval, (char *)val) == 0) return i;
-        break;
-      }
-
-      default:
-        // invalid element type found
-        return -1;
-    }
+    if (el_match(&head->data, &key, ll->intern)) return i;
   }
   return -1;
 }
@@ -160,6 +174,8 @@ node_t* ll_pop(linkedlist_t *ll) {
     node_t* pop_node = ll->head;
 
     ll->head = NULL;
+    ll->tail = NULL;
+    ll->size = 0;
     return pop_node;   // user has to take care of freeing the node's memory
   }
 
@@ -171,6 +187,9 @@ node_t* ll_pop(linkedlist_t *ll) {
   // update the second to last node's next reference 
   node_t *pop_node = head->next;
   head->next = NULL;
+
+  ll->tail = head;      // second to last node is the new last node
+  ll->size--;
   return pop_node;    // user has to take care of freeing the node's memory
 }
 
@@ -179,29 +198,15 @@ node_t* ll_pop(linkedlist_t *ll) {
 bool ll_remove(linkedlist_t *ll, etype_t etype, void *val) {
   if (!ll || !ll->head || !val) return false;
 
+  element_t key;
+  if (!el_key(&key, etype, val, ll->intern)) return false;
+
   node_t *curr = ll->head;
   node_t *prev = NULL;
-  bool is_match = false;
 
   while (curr) {
-    switch (etype) {
-      case INT:
-        is_match = ( curr->data.value.ival == *(int *)val );
-        break;
-
-      case FLO:
-        is_match = ( curr->data.value.fval == *(float *)val );
-        break;
-
-      case STR:
-        is_match =  ( strcmp(curr->data.value.sval, (char *)val) == 0 );
-        break;
-
-      default: return false;    // invalid element type
-    }
-
     // we got a match
-    if (is_match) {
+    if (el_match(&curr->data, &key, ll->intern)) {
       if (prev) {
         // value is in the middle or end
         prev->next = curr->next;
@@ -211,7 +216,11 @@ bool ll_remove(linkedlist_t *ll, etype_t etype, void *val) {
         ll->head = curr->next;
       }
 
-      ll_free_node(curr);
+      // removed the last node, the one before it is the new last node
+      if (curr == ll->tail) ll->tail = prev;
+      ll->size--;
+
+      ll_recycle_node(ll, curr);
       return true;      
     }
 
@@ -231,6 +240,8 @@ void ll_reverse(linkedlist_t *ll) {
   node_t *curr = ll->head;
   node_t *next = NULL;
 
+  ll->tail = ll->head;    // first node is going to be the last
+
   while (curr) {
     next = curr->next;    // take a copy of the next node
     curr->next = prev;    // update the curr node's next to prev node
@@ -246,17 +257,7 @@ void ll_reverse(linkedlist_t *ll) {
 
 
 int ll_size(linkedlist_t *ll) {
-  if (!ll || !ll->head) return 0;
-
-  int len = 0;
-  node_t *head = ll->head;
-
-  while (head != NULL) {
-    len++;
-    head = head->next;
-  }
-
-  return len;
+  return ll ? ll->size : 0;
 }
 
 
@@ -268,12 +269,7 @@ void ll_print(linkedlist_t *ll) {
   printf("[");
 
   while (curr != NULL) {
-    switch (curr->data.etype) {
-      case INT: printf("%d", curr->data.value.ival); break;
-      case FLO: printf("%f", curr->data.value.fval); break;
-      case STR: printf("\"%s\"", curr->data.value.sval); break;
-      default: return;    // invalid element type
-    }
+    if (!el_print(&curr->data)) return;    // invalid element type
     curr = curr->next;
 
     if (curr) printf(", ");
@@ -292,7 +288,7 @@ void ll_free(linkedlist_t *ll) {
     node_t *todel = head;    // note the reference of the node to be freed
     head = head->next;       // update the head to next node
 
-    ll_free_node(todel);
+    ll_recycle_node(ll, todel);
   }
 
   // finally free the linkedlist_t struct
@@ -303,63 +299,35 @@ void ll_free(linkedlist_t *ll) {
 /* ---------- UTIL FUNCTIONS ---------- */
 
 node_t* ll_new_node(etype_t etype, void *val) {
-  node_t *new_node = malloc(sizeof(node_t));
-  if (!new_node) return NULL;
+  return ll_make_node(NULL, NULL, etype, val);
+}
 
-  // update the node with the value
-  new_node->next = NULL;
 
-  switch (etype) {
-    case INT:
-      // typecast void pointer to int pointer (int *) and then de-reference *
-      new_node->data.value.ival = *(int *)val;
-      break;
-
-    case FLO: 
-      new_node->data.value.fval = *(float *)val; 
-      break;
-
-    case STR: {
-      new_node->data.value.sval = strdup( (char *)val );
-      if (!new_node->data.value.sval) {
-        ll_free_node(new_node);
-        return NULL;
-      }
-      break;
-    }
 
-    default:
-      // if we reach here, then invalid etype is passed in
-      // release the memory of new node and return
-      ll_free_node(new_node);
-      return NULL;
-  }
-  new_node->data.etype = etype;  // update the value type
-
-  return new_node;
+node_t* ll_last_node(linkedlist_t *ll) {
+  return ll ? ll->tail : NULL;
 }
 
 
 
-node_t* ll_last_node(linkedlist_t *ll) {
-  if (!ll || !ll->head) return NULL;
-
-  node_t *head = ll->head;
+void ll_free_node(node_t *n) {
+  if (!n) return;
 
-  // loop until the last element is reached
-  while (head->next != NULL) head = head->next;
+  // release the value (a string is freed)
+  el_clear(&n->data, NULL);
 
-  return head;
+  // free the node
+  free(n);
 }
 
 
 
-void ll_free_node(node_t *n) {
+void ll_recycle_node(linkedlist_t *ll, node_t *n) {
   if (!n) return;
 
-  // if node's value is string, then free it
-  if (n->data.etype == STR) free(n->data.value.sval);
+  // release the value (a string is freed)
+  el_clear(&n->data, ll ? ll->intern : NULL);
 
-  // free the node
-  free(n);
-}
\ No newline at end of file
+  // give the node back to the allocator it came from
+  pool_put(ll ? ll->pool : NULL, n);
+}
@@ -3,23 +3,8 @@
 #include <stdbool.h>
 #include <string.h>
 
-
-
-/* specify the type of value in the element */
-typedef enum { INT, FLO, STR } etype_t;
-
-
-
-/* structure to hold value in the node */
-typedef struct {
-  etype_t etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
+#include "pool.h"
+#include "element.h"
 
 
 
@@ -34,6 +19,10 @@ typedef struct node {
 /* structure to define the linkedlist */
 typedef struct {
   node_t *head;       // refer the head of the linked list
+  node_t *tail;       // refer the last node, NULL if the list is empty
+  int size;           // no of nodes in the linked list
+  pool_t *pool;       // allocator for the nodes, NULL to use malloc
+  intern_t *intern;   // table of the long strings, NULL if not interned
 } linkedlist_t;
 
 
@@ -53,12 +42,38 @@ typedef struct {
  */
 linkedlist_t* ll_init();
 
+/**
+ * @brief Same as ll_init, but the nodes are allocated from the pool.
+ *        pool can be shared by many lists, and must outlive them
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param pool_t* - pool of sizeof(node_t) slots, NULL to use malloc
+ * @return linkedlist_t* 
+ */
+linkedlist_t* ll_init_pool(pool_t *);
+
+/**
+ * @brief Share the long strings of the list through an intern table (see
+ *        intern.h), equal strings are stored once and compared on the
+ *        pointer. the table has to outlive the list. only for an empty list
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param linkedlist_t* - pointer to linkedlist_t struct
+ * @param intern_t* - intern table, can be shared by many structures
+ * @return true
+ * @return false - list is not empty
+ */
+bool ll_use_intern(linkedlist_t *, intern_t *);
+
 /**
  * @brief Append the value at the end of the linked list.
  *        If the linked list is empty, then it will be the first value.
  * 
- *        time complexity  - O(1) if linked list has no nodes
- *                           O(N) if linked has N nodes
+ *        time complexity  - O(1), linked to the tail node
  *        space complexity - O(1)
  * 
  * @param linkedlist_t* - reference to linkedlist_t struct
@@ -73,6 +88,7 @@ bool ll_append(linkedlist_t *, etype_t, void *);
  * @brief Insert the value at the given position.
  * 
  *        time complexity  - O(N) ; N- node positon to be inserted
+ *                           O(1) at the head or the end
  *        space complexity - O(1)
  * 
  * @param linkedlist_t* - reference to linkedlist_t struct
@@ -88,6 +104,7 @@ bool ll_insert(linkedlist_t *, int, etype_t, void *);
  * @brief Loop though the linked list and retun the node at the index posiiton
  * 
  *        time complexity  - O(N), N is the index position
+ *                           O(1) for the last node
  *        space complexity - O(1)
  * 
  * @param linkedlist_t* - pointer to linkedlist_t struct
@@ -134,7 +151,8 @@ int ll_index(linkedlist_t *, etype_t, void *);
  * 
  * @param linkedlist_t* - reference to linkedlist_t struct 
  * @return node_t* - returns the last node, NULL if not present
- *                   user has to take care of freeing the memeory of popped node
+ *                   release it with ll_recycle_node, ll_free_node is an
+ *                   invalid free for a node from a pool (or an intern table)
  */
 node_t* ll_pop(linkedlist_t *);
 
@@ -167,7 +185,7 @@ void ll_reverse(linkedlist_t *);
 /**
  * @brief Get no of nodes in the linked list.
  * 
- *        time complexity - O(N) ; N -  no of nodes in the linked list
+ *        time complexity - O(1) ; the size is kept in the list
  *        space complexiy - O(1)
  * 
  * @param linkedlist_t* - pointer to linkedlist_t struct 
@@ -213,9 +231,9 @@ void ll_free(linkedlist_t *);
 node_t* ll_new_node(etype_t, void *);
 
 /**
- * @brief Loop through the linked list and returns the last node
+ * @brief Returns the last node of the linked list
  * 
- *        time complexity  - O(N), N - no of nodes in the list
+ *        time complexity  - O(1), the tail is kept in the list
  *        space complexity - O(1)
  * 
  * @param linkedlist_t* - pointer to linkedlist_t struct  
@@ -225,7 +243,19 @@ node_t* ll_last_node(linkedlist_t *);
 
 /**
  * @brief Free the node. if the node's value is string, then free the string too
+ *        only for the nodes from ll_new_node, or a list without a pool / intern table
+ * 
+ * @param node_t* - pointer to node_t struct
+ */
+void ll_free_node(node_t *);
+
+/**
+ * @brief Free a node of the list (eg from ll_pop), back to its allocator
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
  * 
+ * @param linkedlist_t* - pointer to linkedlist_t struct the node came from
  * @param node_t* - pointer to node_t struct
  */
-void ll_free_node(node_t *);
\ No newline at end of file
+void ll_recycle_node(linkedlist_t *, node_t *);
\ No newline at end of file
@@ -15,6 +15,9 @@ void test_ll_reverse();
 void test_ll_size();
 void test_ll_print();
 void test_ll_free();
+void test_ll_pool();
+void test_ll_intern();
+void test_ll_tail_size();
 
 int main() {
   test_ll_init();
@@ -29,6 +32,9 @@ int main() {
   test_ll_size();
   test_ll_print();
   test_ll_free();
+  test_ll_pool();
+  test_ll_intern();
+  test_ll_tail_size();
 
   printf("\n*** All tests passed!***\n");
   return 0;
@@ -53,7 +59,7 @@ void test_ll_append() {
   assert(ll->head != NULL);
   assert(ll->head->data.value.ival == 10);
   assert(ll->head->next->data.value.fval == 20.5);
-  assert(strcmp(ll->head->next->next->data.value.sval, "Hello") == 0);
+  assert(strcmp(sstr_cstr(&ll->head->next->next->data.value.sval), "Hello") == 0);
 
   ll_free(ll);
 }
@@ -274,3 +280,112 @@ void test_ll_free() {
   printf("Linked list freed successfully.\n");
 }
 
+
+void test_ll_pool() {
+  pool_t *pool = pool_init(sizeof(node_t), 0);
+  linkedlist_t *ll = ll_init_pool(pool);
+  int vals[] = {10, 20, 30};
+
+  for (int i = 0; i < 3; i++) assert(ll_append(ll, INT, &vals[i]));
+  assert(ll_insert(ll, 1, INT, &vals[2]));
+  assert(!ll_insert(ll, 9, INT, &vals[0]));   // failed insert gives the node back
+  assert(pool_in_use(pool) == 4);
+
+  assert(ll_remove(ll, INT, &vals[2]));
+  ll_recycle_node(ll, ll_pop(ll));
+  assert(pool_in_use(pool) == 2);
+
+  ll_free(ll);
+  assert(pool_in_use(pool) == 0);
+  pool_destroy(pool);
+}
+
+void test_ll_intern() {
+  intern_t *tab = intern_init(0);
+  linkedlist_t *a = ll_init();
+  linkedlist_t *b = ll_init();
+  assert(ll_use_intern(a, tab) && ll_use_intern(b, tab));
+
+  char *key = "customer-000123-record";
+  for (int i = 0; i < 10; i++) {
+    assert(ll_append(a, STR, key));
+    assert(ll_append(b, STR, i % 2 ? key : "customer-000124-record"));
+  }
+
+  // every long string is stored once, across the lists
+  assert(intern_count(tab) == 2);
+  assert(a->head->data.value.sval.heap.ptr == b->head->next->data.value.sval.heap.ptr);
+
+  assert(ll_count(a, STR, key) == 10 && ll_count(b, STR, key) == 5);
+  assert(ll_index(b, STR, "customer-000124-record") == 0);
+  assert(ll_count(a, STR, "customer-999999-record") == 0);   // not in the table
+
+  // not empty any more
+  assert(!ll_use_intern(a, NULL));
+
+  while (ll_remove(b, STR, "customer-000124-record"));
+  assert(intern_count(tab) == 1);
+
+  ll_free(a);
+  ll_free(b);
+  assert(intern_count(tab) == 0);
+  intern_destroy(tab);
+}
+
+// the links, tail and size must agree
+static void check_tail_size(linkedlist_t *ll) {
+  int n = 0;
+  node_t *last = NULL;
+
+  for (node_t *curr = ll->head; curr; curr = curr->next) {
+    last = curr;
+    n++;
+  }
+
+  assert(ll->tail == last);
+  assert(ll_last_node(ll) == last);
+  assert(ll->size == n && ll_size(ll) == n);
+}
+
+void test_ll_tail_size() {
+  linkedlist_t *ll = ll_init();
+  int vals[] = {10, 20, 30, 40};
+
+  for (int i = 0; i < 4; i++) {
+    assert(ll_append(ll, INT, &vals[i]));
+    check_tail_size(ll);
+  }
+
+  // head, middle and end inserts
+  assert(ll_insert(ll, 0, INT, &vals[3]));
+  check_tail_size(ll);
+  assert(ll_insert(ll, 2, INT, &vals[2]));
+  check_tail_size(ll);
+  assert(ll_insert(ll, ll_size(ll), INT, &vals[0]));
+  check_tail_size(ll);
+  assert(ll->tail->data.value.ival == 10);
+  assert(ll_get(ll, ll_size(ll) - 1) == ll->tail);
+
+  // [40, 10, 30, 20, 30, 40, 10] ; remove the last, then the head
+  assert(ll_remove(ll, INT, &vals[0]));   // 10 at index 1
+  assert(ll_remove(ll, INT, &vals[3]));   // 40 at the head
+  check_tail_size(ll);
+
+  ll_reverse(ll);
+  check_tail_size(ll);
+  assert(ll->head->data.value.ival == 10 && ll->tail->data.value.ival == 30);
+
+  // appends go after the new tail
+  assert(ll_append(ll, INT, &vals[1]));
+  check_tail_size(ll);
+  assert(ll->tail->data.value.ival == 20);
+
+  node_t *popped;
+  while ((popped = ll_pop(ll))) {
+    ll_free_node(popped);
+    check_tail_size(ll);
+  }
+  assert(ll->head == NULL && ll->tail == NULL);
+
+  ll_free(ll);
+}
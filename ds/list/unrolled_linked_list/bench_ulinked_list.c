@@ -0,0 +1,148 @@
+#include "ulinked_list.h"
+#include "linked_list.h"
+
+#include <time.h>
+
+/*
+  Traversal and indexed access of the unrolled list (ulinkedlist_t) against
+  the singly linked list (linkedlist_t), both holding 0 .. N-1 as INT.
+  usage :- bench_ulinked_list [no of elements]     ; default is 1e6
+
+  build     :- N appends
+  get_rand  :- ll_get / ull_get at random indices, ns per call
+  count     :- ll_count / ull_count of a missing value, ns per element
+  index     :- ll_index / ull_index of the last value, ns per element
+
+  the linked list is built once in order, and once with its nodes shuffled
+  in memory (ll_scattered), like a list grown alongside other allocations
+*/
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+static void report(const char *list, const char *op, long ops, double elapsed) {
+  printf("%-14s %-10s %12ld %10.2f\n", list, op, ops, elapsed * 1e9 / ops);
+}
+
+
+
+/* link the nodes of the list in a random order of their addresses,
+   the values stay in order */
+static void ll_scatter(linkedlist_t *ll, int n) {
+  node_t **nodes = malloc(n * sizeof(node_t *));
+  if (!nodes) return;
+
+  int i = 0;
+  for (node_t *curr = ll->head; curr; curr = curr->next) nodes[i++] = curr;
+
+  unsigned seed = 11;
+  for (i = n - 1; i > 0; i--) {
+    seed = seed * 1103515245u + 12345u;
+    int j = (seed >> 8) % (i + 1);
+
+    node_t *swap = nodes[i];
+    nodes[i] = nodes[j];
+    nodes[j] = swap;
+  }
+
+  // nodes[k] now holds the k-th value
+  for (i = 0; i < n; i++) {
+    nodes[i]->data.etype = INT;
+    nodes[i]->data.value.ival = i;
+    nodes[i]->next = i + 1 < n ? nodes[i + 1] : NULL;
+  }
+  ll->head = nodes[0];
+  ll->tail = nodes[n - 1];
+
+  free(nodes);
+}
+
+
+
+static long long bench_ll(const char *name, linkedlist_t *ll, int n, int gets, int scans) {
+  long long sum = 0;
+  unsigned idx = 1;
+
+  double start = now_sec();
+  for (int i = 0; i < gets; i++) {
+    idx = idx * 1103515245u + 12345u;
+    sum += ll_get(ll, idx % n)->data.value.ival;
+  }
+  report(name, "get_rand", gets, now_sec() - start);
+
+  int missing = -1, last = n - 1;
+  start = now_sec();
+  for (int i = 0; i < scans; i++) sum += ll_count(ll, INT, &missing);
+  report(name, "count", (long)scans * n, now_sec() - start);
+
+  start = now_sec();
+  for (int i = 0; i < scans; i++) sum += ll_index(ll, INT, &last);
+  report(name, "index", (long)scans * n, now_sec() - start);
+
+  return sum;
+}
+
+
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (n <= 0) return 1;
+
+  // ll_get is O(index), keep its total work near the scans
+  int gets = 200, scans = 10;
+
+  printf("%-14s %-10s %12s %10s\n", "list", "operation", "ops", "ns/op");
+
+  // unrolled list
+  ulinkedlist_t *ull = ull_init();
+  if (!ull) return 1;
+
+  double start = now_sec();
+  for (int i = 0; i < n; i++) ull_append(ull, INT, &i);
+  report("ulinked_list", "build", n, now_sec() - start);
+
+  long long sum = 0;
+  unsigned idx = 1;
+
+  start = now_sec();
+  for (int i = 0; i < gets; i++) {
+    idx = idx * 1103515245u + 12345u;
+    sum += ull_get(ull, idx % n)->value.ival;
+  }
+  report("ulinked_list", "get_rand", gets, now_sec() - start);
+
+  int missing = -1, last = n - 1;
+  start = now_sec();
+  for (int i = 0; i < scans; i++) sum += ull_count(ull, INT, &missing);
+  report("ulinked_list", "count", (long)scans * n, now_sec() - start);
+
+  start = now_sec();
+  for (int i = 0; i < scans; i++) sum += ull_index(ull, INT, &last);
+  report("ulinked_list", "index", (long)scans * n, now_sec() - start);
+
+  ull_free(ull);
+
+  // singly linked list, nodes in allocation order
+  linkedlist_t *ll = ll_init();
+  if (!ll) return 1;
+
+  start = now_sec();
+  for (int i = 0; i < n; i++) ll_append(ll, INT, &i);
+  report("linked_list", "build", n, now_sec() - start);
+
+  sum += bench_ll("linked_list", ll, n, gets, scans);
+
+  // same list, nodes scattered in memory
+  ll_scatter(ll, n);
+  sum += bench_ll("ll_scattered", ll, n, gets, scans);
+
+  ll_free(ll);
+
+  printf("checksum %lld\n", sum);
+  return 0;
+}
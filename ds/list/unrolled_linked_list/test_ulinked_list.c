@@ -0,0 +1,373 @@
+#include <assert.h>
+
+#include "ulinked_list.h"
+
+// Function prototypes for test cases
+void test_ull_init();
+void test_ull_append();
+void test_ull_insert();
+void test_ull_get();
+void test_ull_count();
+void test_ull_index();
+void test_ull_pop();
+void test_ull_remove();
+void test_ull_reverse();
+void test_ull_size();
+void test_ull_model();
+void test_ull_pool();
+void test_ull_intern();
+
+int main() {
+  test_ull_init();
+  test_ull_append();
+  test_ull_insert();
+  test_ull_get();
+  test_ull_count();
+  test_ull_index();
+  test_ull_pop();
+  test_ull_remove();
+  test_ull_reverse();
+  test_ull_size();
+  test_ull_model();
+  test_ull_pool();
+  test_ull_intern();
+
+  printf("\n*** All tests passed!***\n");
+  return 0;
+}
+
+// the nodes are linked up to the tail, none is empty, all but the last are
+// atleast half full, counts add up to size
+static void check_shape(ulinkedlist_t *ull) {
+  int size = 0;
+  ull_node_t *last = NULL;
+
+  for (ull_node_t *curr = ull->head; curr; curr = curr->next) {
+    assert(curr->count > 0 && curr->count <= (int)ULL_NODE_CAP);
+    assert(curr == ull->tail || curr->count >= (int)ULL_NODE_CAP / 2);
+    size += curr->count;
+    last = curr;
+  }
+
+  assert(ull->tail == last);
+  assert(ull->size == size);
+}
+
+void test_ull_init() {
+  ulinkedlist_t *ull = ull_init();
+  assert(ull != NULL);
+  assert(ull->head == NULL && ull->tail == NULL && ull->size == 0);
+  ull_free(ull);
+}
+
+void test_ull_append() {
+  ulinkedlist_t *ull = ull_init();
+  int val1 = 10;
+  float val2 = 20.5;
+  char *val3 = "Hello";
+
+  assert(ull_append(ull, INT, &val1) == true);
+  assert(ull_append(ull, FLO, &val2) == true);
+  assert(ull_append(ull, STR, val3) == true);
+  assert(ull_append(ull, INT, NULL) == false);
+  assert(ull_append(ull, (etype_t)9, &val1) == false);
+
+  assert(ull_get(ull, 0)->value.ival == 10);
+  assert(ull_get(ull, 1)->value.fval == 20.5);
+  assert(strcmp(sstr_cstr(&ull_get(ull, 2)->value.sval), "Hello") == 0);
+
+  // a node per ULL_NODE_CAP elements
+  for (int i = 0; i < 100; i++) assert(ull_append(ull, INT, &i));
+  check_shape(ull);
+
+  ull_free(ull);
+}
+
+void test_ull_insert() {
+  ulinkedlist_t *ull = ull_init();
+  int val1 = 10;
+  int val2 = 20;
+  int val3 = 30;
+
+  ull_append(ull, INT, &val1);
+  ull_append(ull, INT, &val2);
+  assert(ull_insert(ull, 1, INT, &val3) == true);
+  assert(ull_get(ull, 1)->value.ival == 30); // Check if 30 is inserted at index 1
+
+  assert(ull_insert(ull, 0, INT, &val3) == true); // Insert at head
+  assert(ull_get(ull, 0)->value.ival == 30);
+
+  assert(ull_insert(ull, 4, INT, &val1) == true); // Insert at the end
+  assert(ull_get(ull, 4)->value.ival == 10);
+
+  assert(ull_insert(ull, 9, INT, &val3) == false); // Invalid index
+  assert(ull_insert(ull, -1, INT, &val3) == false);
+
+  // inserts into full nodes split them
+  for (int i = 0; i < 50; i++) assert(ull_insert(ull, 2, INT, &i));
+  check_shape(ull);
+  assert(ull_get(ull, 2)->value.ival == 49 && ull_get(ull, 51)->value.ival == 0);
+
+  ull_free(ull);
+}
+
+void test_ull_get() {
+  ulinkedlist_t *ull = ull_init();
+
+  for (int i = 0; i < 37; i++) ull_append(ull, INT, &i);
+  for (int i = 0; i < 37; i++) assert(ull_get(ull, i)->value.ival == i);
+
+  assert(ull_get(ull, 37) == NULL); // Out of bounds
+  assert(ull_get(ull, -1) == NULL);
+
+  ull_free(ull);
+}
+
+void test_ull_count() {
+  ulinkedlist_t *ull = ull_init();
+  int val1 = 10;
+  int val2 = 20;
+  float val3 = 10;
+
+  // spread over many nodes, mixed with floats of the same value
+  for (int i = 0; i < 30; i++) {
+    ull_append(ull, INT, i % 3 ? &val1 : &val2);
+    if (i % 5 == 0) ull_append(ull, FLO, &val3);
+  }
+
+  assert(ull_count(ull, INT, &val1) == 20);
+  assert(ull_count(ull, INT, &val2) == 10);
+  assert(ull_count(ull, FLO, &val3) == 6);
+  assert(ull_count(ull, STR, "10") == 0);
+
+  ull_free(ull);
+}
+
+void test_ull_index() {
+  ulinkedlist_t *ull = ull_init();
+  int val1 = 10;
+  int val2 = 20;
+  int val3 = 30;
+
+  for (int i = 0; i < 25; i++) ull_append(ull, INT, &val1);
+  ull_append(ull, INT, &val2);
+
+  assert(ull_index(ull, INT, &val1) == 0);
+  assert(ull_index(ull, INT, &val2) == 25);
+  assert(ull_index(ull, INT, &val3) == -1); // Not found
+
+  ull_free(ull);
+}
+
+void test_ull_pop() {
+  ulinkedlist_t *ull = ull_init();
+
+  for (int i = 0; i < 10; i++) ull_append(ull, INT, &i);
+  ull_append(ull, STR, "a string longer than inline");
+
+  element_t *popped = ull_pop(ull);
+  assert(popped != NULL && popped->etype == STR);
+  assert(strcmp(sstr_cstr(&popped->value.sval), "a string longer than inline") == 0);
+  el_free(popped);
+
+  // pop all, the emptied nodes are unlinked
+  for (int i = 9; i >= 0; i--) {
+    popped = ull_pop(ull);
+    assert(popped->value.ival == i);
+    el_free(popped);
+    check_shape(ull);
+  }
+
+  // Check if the list is now empty
+  assert(ull_pop(ull) == NULL);
+  assert(ull->head == NULL && ull->tail == NULL);
+
+  ull_free(ull);
+}
+
+void test_ull_remove() {
+  ulinkedlist_t *ull = ull_init();
+  int val1 = 10;
+  int val2 = 20;
+  int val3 = 30;
+
+  ull_append(ull, INT, &val1);
+  ull_append(ull, INT, &val2);
+  ull_append(ull, INT, &val3);
+
+  // Remove the second element (20)
+  assert(ull_remove(ull, INT, &val2) == true);
+  assert(ull_index(ull, INT, &val2) == -1); // Should not be found
+  assert(ull_remove(ull, INT, &val2) == false);
+
+  // Remove the head element (10), then the last (30)
+  assert(ull_remove(ull, INT, &val1) == true);
+  assert(ull_remove(ull, INT, &val3) == true);
+
+  // Check if the list is empty
+  assert(ull->head == NULL && ull->tail == NULL && ull->size == 0);
+
+  // the half empty nodes are merged
+  for (int i = 0; i < 40; i++) ull_append(ull, INT, &i);
+  for (int i = 0; i < 40; i += 2) assert(ull_remove(ull, INT, &i));
+  check_shape(ull);
+
+  int nodes = 0;
+  for (ull_node_t *curr = ull->head; curr; curr = curr->next) nodes++;
+  assert(nodes <= 2 * (20 / (int)ULL_NODE_CAP + 1));
+
+  for (int i = 0; i < 20; i++) assert(ull_get(ull, i)->value.ival == 2 * i + 1);
+
+  ull_free(ull);
+
+  // two full nodes, emptying the first one borrows from the second
+  ull = ull_init();
+  int cap = (int)ULL_NODE_CAP;
+  for (int i = 0; i < 2 * cap; i++) ull_append(ull, INT, &i);
+  for (int i = 0; i < cap - 1; i++) {
+    assert(ull_remove(ull, INT, &i));
+    check_shape(ull);
+  }
+  assert(ull_get(ull, 0)->value.ival == cap - 1);
+
+  ull_free(ull);
+}
+
+void test_ull_reverse() {
+  ulinkedlist_t *ull = ull_init();
+
+  for (int i = 0; i < 23; i++) ull_append(ull, INT, &i);
+
+  ull_reverse(ull);
+  check_shape(ull);
+
+  // After reversing, the head should now be the last element
+  for (int i = 0; i < 23; i++) assert(ull_get(ull, i)->value.ival == 22 - i);
+
+  // appends go to the new tail
+  int val = 100;
+  ull_append(ull, INT, &val);
+  assert(ull_get(ull, 23)->value.ival == 100);
+
+  ull_free(ull);
+}
+
+void test_ull_size() {
+  ulinkedlist_t *ull = ull_init();
+  int val1 = 10;
+  int val2 = 20;
+
+  assert(ull_size(ull) == 0); // Size should be 0
+
+  ull_append(ull, INT, &val1);
+  assert(ull_size(ull) == 1); // Size should be 1
+
+  ull_append(ull, INT, &val2);
+  assert(ull_size(ull) == 2); // Size should be 2
+
+  ull_remove(ull, INT, &val1);
+  assert(ull_size(ull) == 1); // Size should be 1 after removal
+
+  ull_free(ull);
+}
+
+// random inserts / removes / pops, against an array of the same values
+void test_ull_model() {
+  ulinkedlist_t *ull = ull_init();
+  int model[2000];
+  int size = 0;
+  unsigned seed = 7;
+
+  for (int step = 0; step < 20000; step++) {
+    seed = seed * 1103515245u + 12345u;
+    int op = (seed >> 16) % 4;
+    int val = (seed >> 8) % 50;
+
+    if (op <= 1 && size < 2000) {
+      int idx = size ? (int)((seed >> 4) % (size + 1)) : 0;
+      assert(ull_insert(ull, idx, INT, &val));
+
+      memmove(model + idx + 1, model + idx, (size - idx) * sizeof(int));
+      model[idx] = val;
+      size++;
+    }
+    else if (op == 2) {
+      int idx = -1;
+      for (int i = 0; i < size && idx < 0; i++) if (model[i] == val) idx = i;
+
+      assert(ull_remove(ull, INT, &val) == (idx >= 0));
+      if (idx >= 0) {
+        memmove(model + idx, model + idx + 1, (size - idx - 1) * sizeof(int));
+        size--;
+      }
+    }
+    else if (size) {
+      element_t *popped = ull_pop(ull);
+      assert(popped->value.ival == model[--size]);
+      el_free(popped);
+    }
+
+    if (step % 500 == 0) {
+      check_shape(ull);
+      for (int i = 0; i < size; i++) assert(ull_get(ull, i)->value.ival == model[i]);
+    }
+  }
+
+  check_shape(ull);
+  assert(ull_size(ull) == size);
+  ull_free(ull);
+}
+
+void test_ull_pool() {
+  pool_t *pool = pool_init(sizeof(ull_node_t), 0);
+  ulinkedlist_t *ull = ull_init_pool(pool);
+
+  for (int i = 0; i < 3 * (int)ULL_NODE_CAP; i++) assert(ull_append(ull, INT, &i));
+  assert(pool_in_use(pool) == 3);
+
+  // a full node is split
+  int val = -1;
+  assert(ull_insert(ull, 1, INT, &val));
+  assert(pool_in_use(pool) == 4);
+
+  ull_free(ull);
+  assert(pool_in_use(pool) == 0);
+  pool_destroy(pool);
+}
+
+void test_ull_intern() {
+  intern_t *tab = intern_init(0);
+  ulinkedlist_t *a = ull_init();
+  ulinkedlist_t *b = ull_init();
+  assert(ull_use_intern(a, tab) && ull_use_intern(b, tab));
+
+  char *key = "customer-000123-record";
+  for (int i = 0; i < 10; i++) {
+    assert(ull_append(a, STR, key));
+    assert(ull_append(b, STR, i % 2 ? key : "customer-000124-record"));
+  }
+
+  // every long string is stored once, across the lists
+  assert(intern_count(tab) == 2);
+  assert(ull_get(a, 0)->value.sval.heap.ptr == ull_get(b, 1)->value.sval.heap.ptr);
+
+  assert(ull_count(a, STR, key) == 10 && ull_count(b, STR, key) == 5);
+  assert(ull_index(b, STR, "customer-000124-record") == 0);
+  assert(ull_count(a, STR, "customer-999999-record") == 0);   // not in the table
+
+  // not empty any more
+  assert(!ull_use_intern(a, NULL));
+
+  while (ull_remove(b, STR, "customer-000124-record"));
+  assert(intern_count(tab) == 1);
+
+  // a popped string has its own chars
+  element_t *popped = ull_pop(a);
+  assert(strcmp(sstr_cstr(&popped->value.sval), key) == 0);
+  el_free(popped);
+
+  ull_free(a);
+  ull_free(b);
+  assert(intern_count(tab) == 0);
+  intern_destroy(tab);
+}
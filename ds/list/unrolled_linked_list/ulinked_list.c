@@ -0,0 +1,383 @@
+#include "ulinked_list.h"
+
+
+ulinkedlist_t* ull_init() {
+  return ull_init_pool(NULL);
+}
+
+
+
+ulinkedlist_t* ull_init_pool(pool_t *pool) {
+  ulinkedlist_t *ull = malloc(sizeof(ulinkedlist_t));
+  if (!ull) return NULL;
+
+  // initialize the list
+  ull->head = NULL;
+  ull->tail = NULL;
+  ull->size = 0;
+  ull->pool = pool;
+  ull->intern = NULL;
+
+  return ull;
+}
+
+
+
+bool ull_use_intern(ulinkedlist_t *ull, intern_t *intern) {
+  if (!ull || ull->head) return false;
+
+  ull->intern = intern;
+  return true;
+}
+
+
+
+/* allocate an empty node from the pool (malloc, if there is no pool) */
+static ull_node_t* ull_make_node(ulinkedlist_t *ull) {
+  ull_node_t *new_node = pool_get(ull->pool, sizeof(ull_node_t));
+  if (!new_node) return NULL;
+
+  new_node->next = NULL;
+  new_node->count = 0;
+  return new_node;
+}
+
+
+
+/* link the node after prev (at the head, if prev is NULL) */
+static void ull_link_after(ulinkedlist_t *ull, ull_node_t *prev, ull_node_t *n) {
+  if (prev) {
+    n->next = prev->next;
+    prev->next = n;
+  }
+  else {
+    n->next = ull->head;
+    ull->head = n;
+  }
+
+  if (ull->tail == prev) ull->tail = n;
+}
+
+
+
+/* unlink the node after prev (the head, if prev is NULL), the node is
+   given back to the allocator. its elements must be cleared or moved */
+static void ull_unlink_after(ulinkedlist_t *ull, ull_node_t *prev, ull_node_t *n) {
+  if (prev) prev->next = n->next;
+  else ull->head = n->next;
+
+  if (ull->tail == n) ull->tail = prev;
+
+  pool_put(ull->pool, n);
+}
+
+
+
+/* keep the node atleast half full :- the next node is merged into it if
+   both fit, else a node below half borrows from the next one (which keeps
+   more than half). the last node is left as it is */
+static void ull_rebalance(ulinkedlist_t *ull, ull_node_t *n) {
+  ull_node_t *next = n->next;
+  if (!next) return;
+
+  if (n->count + next->count <= (int)ULL_NODE_CAP) {
+    // the next node fits in this one, merge them
+    memcpy(n->data + n->count, next->data, next->count * sizeof(element_t));
+    n->count += next->count;
+    ull_unlink_after(ull, n, next);
+  }
+  else if (n->count < (int)ULL_NODE_CAP / 2) {
+    // too many for one node, borrow from the front of the next one
+    int k = (int)ULL_NODE_CAP / 2 - n->count;
+    memcpy(n->data + n->count, next->data, k * sizeof(element_t));
+    memmove(next->data, next->data + k, (next->count - k) * sizeof(element_t));
+    n->count += k;
+    next->count -= k;
+  }
+}
+
+
+
+bool ull_append(ulinkedlist_t *ull, etype_t etype, void *val) {
+  if (!ull || !val) return false;
+
+  ull_node_t *tail = ull->tail;
+
+  // the last node is full (or there is none), start a new one
+  if (!tail || tail->count == (int)ULL_NODE_CAP) {
+    ull_node_t *new_node = ull_make_node(ull);
+    if (!new_node) return false;
+
+    if (!el_set(&new_node->data[0], etype, val, ull->intern)) {
+      pool_put(ull->pool, new_node);
+      return false;
+    }
+
+    new_node->count = 1;
+    ull_link_after(ull, tail, new_node);
+    ull->size++;
+    return true;
+  }
+
+  if (!el_set(&tail->data[tail->count], etype, val, ull->intern)) return false;
+
+  tail->count++;
+  ull->size++;
+  return true;
+}
+
+
+
+bool ull_insert(ulinkedlist_t *ull, int idx, etype_t etype, void *val) {
+  if (!ull || !val || idx < 0 || idx > ull->size) return false;
+
+  // insertion at the end
+  if (idx == ull->size) return ull_append(ull, etype, val);
+
+  int pos;
+  ull_node_t *node = ull_find_node(ull, idx, &pos);
+  if (!node) return false;
+
+  // set the value aside first, so a failure leaves the list as it was
+  element_t ele;
+  if (!el_set(&ele, etype, val, ull->intern)) return false;
+
+  // full node, move its upper half to a new node after it
+  if (node->count == (int)ULL_NODE_CAP) {
+    ull_node_t *new_node = ull_make_node(ull);
+    if (!new_node) {
+      el_clear(&ele, ull->intern);
+      return false;
+    }
+
+    int half = node->count / 2;
+    new_node->count = node->count - half;
+    memcpy(new_node->data, node->data + half, new_node->count * sizeof(element_t));
+    node->count = half;
+
+    ull_link_after(ull, node, new_node);
+
+    // the position can be in either of the halves
+    if (pos > half) {
+      node = new_node;
+      pos -= half;
+    }
+  }
+
+  // move the elements from pos to the right, by one
+  memmove(node->data + pos + 1, node->data + pos, (node->count - pos) * sizeof(element_t));
+  node->data[pos] = ele;
+  node->count++;
+  ull->size++;
+  return true;
+}
+
+
+
+const element_t* ull_get(ulinkedlist_t *ull, int idx) {
+  int pos;
+  ull_node_t *node = ull_find_node(ull, idx, &pos);
+
+  return node ? &node->data[pos] : NULL;
+}
+
+
+
+int ull_count(ulinkedlist_t *ull, etype_t etype, void *val) {
+  if (!ull || !ull->head || !val) return 0;
+
+  element_t key;
+  if (!el_key(&key, etype, val, ull->intern)) return 0;
+
+  int freq = 0;
+
+  // the elements of a node are contiguous, scan them as an array
+  for (ull_node_t *curr = ull->head; curr; curr = curr->next)
+    freq += el_count(curr->data, curr->count, &key, ull->intern);
+
+  return freq;
+}
+
+
+
+int ull_index(ulinkedlist_t *ull, etype_t etype, void *val) {
+  if (!ull || !ull->head || !val) return -1;
+
+  element_t key;
+  if (!el_key(&key, etype, val, ull->intern)) return -1;
+
+  int base = 0;   // index of the first element of the node
+
+  for (ull_node_t *curr = ull->head; curr; curr = curr->next) {
+    int pos = el_index(curr->data, curr->count, &key, ull->intern);
+    if (pos != -1) return base + pos;
+
+    base += curr->count;
+  }
+  return -1;
+}
+
+
+
+element_t* ull_pop(ulinkedlist_t *ull) {
+  if (!ull || !ull->tail) return NULL;
+
+  element_t *pop_element = malloc(sizeof(element_t));
+  if (!pop_element) return NULL;
+
+  ull_node_t *tail = ull->tail;
+
+  // string (if any) is now owned by the popped copy, an interned string
+  // is shared, the copy gets its own chars
+  *pop_element = tail->data[tail->count - 1];
+  if (!el_own(pop_element, ull->intern)) {
+    free(pop_element);
+    return NULL;
+  }
+
+  tail->count--;
+  ull->size--;
+
+  // last node is empty, find the one before it to unlink it
+  if (tail->count == 0) {
+    ull_node_t *prev = NULL;
+    if (ull->head != tail) {
+      prev = ull->head;
+      while (prev->next != tail) prev = prev->next;
+    }
+
+    ull_unlink_after(ull, prev, tail);
+  }
+
+  return pop_element;   // caller has to free the memory with el_free
+}
+
+
+
+bool ull_remove(ulinkedlist_t *ull, etype_t etype, void *val) {
+  if (!ull || !ull->head || !val) return false;
+
+  element_t key;
+  if (!el_key(&key, etype, val, ull->intern)) return false;
+
+  ull_node_t *prev = NULL;
+
+  for (ull_node_t *curr = ull->head; curr; prev = curr, curr = curr->next) {
+    int pos = el_index(curr->data, curr->count, &key, ull->intern);
+    if (pos == -1) continue;
+
+    // we got a match, close the gap in the node
+    el_clear(&curr->data[pos], ull->intern);
+    memmove(curr->data + pos, curr->data + pos + 1, (curr->count - pos - 1) * sizeof(element_t));
+    curr->count--;
+    ull->size--;
+
+    // node is empty
+    if (curr->count == 0) ull_unlink_after(ull, prev, curr);
+    else ull_rebalance(ull, curr);
+    return true;
+  }
+  return false;
+}
+
+
+
+void ull_reverse(ulinkedlist_t *ull) {
+  if (!ull || !ull->head) return;
+
+  ull_node_t *prev = NULL;
+  ull_node_t *curr = ull->head;
+  ull->tail = curr;
+
+  while (curr) {
+    ull_node_t *next = curr->next;   // take a copy of the next node
+    curr->next = prev;               // update the curr node's next to prev node
+
+    // reverse the elements of the node
+    for (int i = 0, j = curr->count - 1; i < j; i++, j--) {
+      element_t tmp = curr->data[i];
+      curr->data[i] = curr->data[j];
+      curr->data[j] = tmp;
+    }
+
+    prev = curr;
+    curr = next;
+  }
+
+  // finally update the head with the new node
+  ull->head = prev;
+
+  // the old last node is the head now, it can be less than half full
+  ull_rebalance(ull, ull->head);
+}
+
+
+
+int ull_size(ulinkedlist_t *ull) {
+  return ull ? ull->size : 0;
+}
+
+
+
+void ull_print(ulinkedlist_t *ull) {
+  if (!ull) return;
+
+  printf("[");
+
+  for (ull_node_t *curr = ull->head; curr; curr = curr->next) {
+    for (int i = 0; i < curr->count; i++) {
+      if (!el_print(&curr->data[i])) return;    // invalid element type
+
+      if (i < curr->count - 1 || curr->next) printf(", ");
+    }
+  }
+  printf("]\n");
+}
+
+
+
+void ull_free(ulinkedlist_t *ull) {
+  if (!ull) return;
+
+  ull_node_t *curr = ull->head;
+
+  while (curr) {
+    ull_node_t *todel = curr;    // note the reference of the node to be freed
+    curr = curr->next;           // update the curr to next node
+
+    ull_recycle_node(ull, todel);
+  }
+
+  // finally free the ulinkedlist_t struct
+  free(ull);
+}
+
+
+/* ---------- UTIL FUNCTIONS ---------- */
+
+ull_node_t* ull_find_node(ulinkedlist_t *ull, int idx, int *pos) {
+  if (!ull || !pos || idx < 0 || idx >= ull->size) return NULL;
+
+  ull_node_t *curr = ull->head;
+
+  // skip the whole nodes before the index, on their count
+  while (idx >= curr->count) {
+    idx -= curr->count;
+    curr = curr->next;
+  }
+
+  *pos = idx;
+  return curr;
+}
+
+
+
+void ull_recycle_node(ulinkedlist_t *ull, ull_node_t *n) {
+  if (!n) return;
+
+  // release the values (a string is freed)
+  for (int i = 0; i < n->count; i++) el_clear(&n->data[i], ull ? ull->intern : NULL);
+
+  // give the node back to the allocator it came from
+  pool_put(ull ? ull->pool : NULL, n);
+}
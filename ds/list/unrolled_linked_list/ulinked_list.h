@@ -0,0 +1,271 @@
+#ifndef __ULINKED_LIST_HEADER__
+#define __ULINKED_LIST_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pool.h"
+#include "element.h"
+
+#ifndef ULL_NODE_BYTES
+#define ULL_NODE_BYTES  256     // target size of a node, four cache lines
+#endif
+
+/* no of elements in a node, whatever fits in ULL_NODE_BYTES after the header */
+#define ULL_NODE_CAP  ((ULL_NODE_BYTES - 2 * sizeof(void *)) / sizeof(element_t))
+
+/*
+Some Design Notes:
+- unrolled linked list :- every node holds upto ULL_NODE_CAP elements in an
+  inline array, so a walk follows one pointer per node, not one per element.
+  with the 24 byte element_t, a 256 byte node holds 10 elements (a two
+  cache line node holds just 4, and the per node work eats the gain)
+
+- same operations as linkedlist_t (linked_list.h), elements are addressed
+  by their position in the whole list
+
+- get / insert skip whole nodes on their count, count / index scan the
+  array of a node with el_count / el_index (AVX2 for INT / FLO)
+
+- a full node is split in two halves on insert. on remove, a node is
+  merged with its next one when both fit in one node, else a node below
+  half full borrows from the next one (same for the new first node after
+  a reverse), so the nodes stay atleast half full (except the last one)
+
+- tail and size are kept in the list, append and size are O(1)
+
+- nodes can come from a pool (pool.h) of sizeof(ull_node_t) slots, long
+  strings can be interned (intern.h), same as linkedlist_t
+*/
+
+
+/* structure to represent the node */
+typedef struct ull_node {
+  struct ull_node *next;          // pointer part - reference to next node
+  int count;                      // no of elements in use, from data[0]
+  element_t data[ULL_NODE_CAP];   // info part - the elements
+} ull_node_t;
+
+
+
+/* structure to define the unrolled linked list */
+typedef struct {
+  ull_node_t *head;   // first node, NULL if the list is empty
+  ull_node_t *tail;   // last node, the appends go here
+  int size;           // no of elements in the list
+  pool_t *pool;       // allocator for the nodes, NULL to use malloc
+  intern_t *intern;   // table of the long strings, NULL if not interned
+} ulinkedlist_t;
+
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Allocate memory for unrolled linked list and returns it.
+ *        Head of the list is marked as NULL.
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @return ulinkedlist_t*
+ */
+ulinkedlist_t* ull_init();
+
+/**
+ * @brief Same as ull_init, but the nodes are allocated from the pool.
+ *        pool can be shared by many lists, and must outlive them
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param pool_t* - pool of sizeof(ull_node_t) slots, NULL to use malloc
+ * @return ulinkedlist_t*
+ */
+ulinkedlist_t* ull_init_pool(pool_t *);
+
+/**
+ * @brief Share the long strings of the list through an intern table (see
+ *        intern.h). the table has to outlive the list. only for an empty list
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - pointer to ulinkedlist_t struct
+ * @param intern_t* - intern table, can be shared by many structures
+ * @return true
+ * @return false - list is not empty
+ */
+bool ull_use_intern(ulinkedlist_t *, intern_t *);
+
+/**
+ * @brief Append the value at the end of the list.
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - reference to ulinkedlist_t struct
+ * @param etype_t - specify type of data. allowed - INT, FLO, STR
+ * @param void* - data as void pointer, will type casted based on etype
+ * @return true - append is success
+ * @return false - append fails
+ */
+bool ull_append(ulinkedlist_t *, etype_t, void *);
+
+/**
+ * @brief Insert the value at the given position, a full node is split.
+ *
+ *        time complexity  - O(N / C) ; N - position, C - ULL_NODE_CAP
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - reference to ulinkedlist_t struct
+ * @param int - new value insert positon, 0 to size
+ * @param etype_t - specify type of data. allowed - INT, FLO, STR
+ * @param void* - data as void pointer, will type casted based on etype
+ * @return true - if insertion of value is success
+ * @return false - insertion failed
+ */
+bool ull_insert(ulinkedlist_t *, int, etype_t, void *);
+
+/**
+ * @brief Get the element at the index position
+ *
+ *        time complexity  - O(N / C) ; N - index, C - ULL_NODE_CAP
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - pointer to ulinkedlist_t struct
+ * @param int - index positon to retrieve the element
+ * @return const element_t* - NULL is returned for invalid positon
+ */
+const element_t* ull_get(ulinkedlist_t *, int);
+
+/**
+ * @brief Count no of times the value appears.
+ *
+ *        time complexity  - O(N) ; in case of int or float
+ *                           O(N * M) ; in case of string, M - length of string
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - reference to ulinkedlist_t struct
+ * @param etype_t - specify type of data. allowed - INT, FLO, STR
+ * @param void* - data as void pointer, will type casted based on etype
+ * @return int - frequency of the value
+ */
+int ull_count(ulinkedlist_t *, etype_t, void *);
+
+/**
+ * @brief Identify the first occurance of the value and return the index
+ *
+ *        time complexity  - O(N) ; in case of int or float
+ *                           O(N * M) ; in case of string, M - length of string
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - reference to ulinkedlist_t struct
+ * @param etype_t - specify type of data. allowed - INT, FLO, STR
+ * @param void* - data as void pointer, will type casted based on etype
+ * @return int - returns the first occurance index
+ *               returns -1 if not found
+ */
+int ull_index(ulinkedlist_t *, etype_t, void *);
+
+/**
+ * @brief Removes the last element from the list and returns it
+ *
+ *        time complexity  - O(1) ; O(N / C) if the last node is emptied
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - reference to ulinkedlist_t struct
+ * @return element_t* - copy of the last element, NULL if list is empty
+ *                      caller has to free it with el_free
+ */
+element_t* ull_pop(ulinkedlist_t *);
+
+/**
+ * @brief Remove the first occurance of the element.
+ *
+ *        time complexity  - O(N)
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - reference to ulinkedlist_t struct
+ * @param etype_t - specify type of data. allowed - INT, FLO, STR
+ * @param void* - data as void pointer, will type casted based on etype
+ * @return true - if value is removed successfully
+ * @return false - value removel failed, or value not found
+ */
+bool ull_remove(ulinkedlist_t *, etype_t, void *);
+
+/**
+ * @brief reverses the list in-place, the node links and the elements of
+ *        every node are reversed
+ *
+ *        time complexity  - O(N)
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - pointer to ulinkedlist_t struct
+ */
+void ull_reverse(ulinkedlist_t *);
+
+/**
+ * @brief Get no of elements in the list.
+ *
+ *        time complexity - O(1)
+ *        space complexiy - O(1)
+ *
+ * @param ulinkedlist_t* - pointer to ulinkedlist_t struct
+ * @return int - no of elements
+ */
+int ull_size(ulinkedlist_t *);
+
+/**
+ * @brief Prints the value in the list.
+ *
+ *        time complexity  - O(N) ; N - no of elements in the list
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - pointer to ulinkedlist_t struct
+ */
+void ull_print(ulinkedlist_t *);
+
+/**
+ * @brief Release the memory of the entire list
+ *
+ *        time complexity  - O(N) ; N - no of elements in the list
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - pointer to ulinkedlist_t struct
+ */
+void ull_free(ulinkedlist_t *);
+
+
+/* ---------- UTIL FUNCTION PROTOTYPES ---------- */
+
+/**
+ * @brief Find the node holding the element at the index position
+ *
+ *        time complexity  - O(N / C) ; N - index, C - ULL_NODE_CAP
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - pointer to ulinkedlist_t struct
+ * @param int - index position of the element
+ * @param int* - the position of the element inside the node is set here
+ * @return ull_node_t* - NULL is returned for invalid position
+ */
+ull_node_t* ull_find_node(ulinkedlist_t *, int, int *);
+
+/**
+ * @brief Free a node of the list and the values in it, back to its allocator
+ *
+ *        time complexity  - O(C) ; C - ULL_NODE_CAP
+ *        space complexity - O(1)
+ *
+ * @param ulinkedlist_t* - pointer to ulinkedlist_t struct the node came from
+ * @param ull_node_t* - pointer to ull_node_t struct
+ */
+void ull_recycle_node(ulinkedlist_t *, ull_node_t *);
+
+
+#endif   // __ULINKED_LIST_HEADER__
@@ -58,11 +58,7 @@ void cq_free(cqueue_t **cq) {
   if (!cq || !*cq) return;
 
   while (!cq_is_empty(*cq)) {
-    element_t *element = cq_dequeue(*cq);
-
-    if (element->etype == STR) free(element->value.sval);
-
-    free(element);
+    el_free(cq_dequeue(*cq));
   }
 
   free(*cq);
@@ -73,31 +69,6 @@ void cq_free(cqueue_t **cq) {
 /* ---------- UTIL FUNCTIONS ---------- */
 
 element_t* cq_new_element(etype_t etype, void *val) {
-  if (!val) return NULL;
-
-  // allocate memory for new element_t
-  element_t *element = malloc(sizeof(element_t));
-  if (!element) return NULL;
-
-  switch (etype) {
-    case INT: element->value.ival = *(int *)val; break;
-
-    case FLO: element->value.fval = *(float *)val; break;
-
-    case STR: {
-      element->value.sval = strdup( (char *)val );
-      if (!element->value.sval) {
-        free(element);
-        return NULL;
-      }
-      break;
-    }
-
-    default:     // invalid element type
-      free(element);
-      return NULL;
-  }
-
-  element->etype = etype;  // update the element type;
-  return element;
+  // allocate memory for new element_t, updated with the value
+  return el_new(etype, val);
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdbool.h>
 
+#include "element.h"
+
 #define SIZE 10
 
 // Queue implementation using Array (circular nature)
@@ -22,22 +24,6 @@
 // so the total elements queue can hold = SIZE - 1
 
 
-/* specify the type of value in the element */
-typedef enum { INT, FLO, STR } etype_t;
-
-
-/* struct representation of a element */
-typedef struct {
-  etype_t etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
-
-
 /* struct representation of a circular queue */
 typedef struct {
   int first;
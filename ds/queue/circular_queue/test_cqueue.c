@@ -43,7 +43,7 @@ void test_circular_queue() {
 
   // Test dequeueing the string
   element_t *dequeued3 = cq_dequeue(cq);
-  assert(dequeued3 != NULL && dequeued3->etype == STR && strcmp(dequeued3->value.sval, "Hello") == 0);
+  assert(dequeued3 != NULL && dequeued3->etype == STR && strcmp(sstr_cstr(&dequeued3->value.sval), "Hello") == 0);
   free(dequeued3);
   printf("Test 9: Dequeued string 'Hello'.\n");
 
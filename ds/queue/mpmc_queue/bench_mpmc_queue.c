@@ -0,0 +1,164 @@
+#include "mpmc_queue.h"
+#include "queue_ll.h"
+
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+/*
+  Scaling of the mpmc ring (mpmc_queue_t) against the linked list queue
+  (queue_ll_t) behind one pthread mutex, half the threads produce and half
+  consume. usage :- bench_mpmc_queue [no of elements] [max threads]
+                                     ; default is 2e6 and 64
+
+  threads   :- producers + consumers, 2 4 8 ... upto max threads
+  ns/elem   :- wall time per element moved through the queue
+  Melem/s   :- elements moved per second, by all the threads together
+
+  the spin loops yield the cpu when the queue is full / empty, so the
+  benchmark makes progress with more threads than cores (the numbers from
+  such a run measure the scheduler, not the queue)
+*/
+
+#define BENCH_RING  1024
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+/* queue_ll_t made shareable the usual way, a lock around every call */
+typedef struct {
+  pthread_mutex_t lock;
+  queue_ll_t *qll;
+} locked_qll_t;
+
+
+
+typedef struct {
+  mpmc_queue_t *q;
+  locked_qll_t *lq;
+  long n;                 // no of elements this thread moves
+  long long sum;
+} bench_arg_t;
+
+
+
+static void* mpmc_produce(void *p) {
+  bench_arg_t *arg = p;
+
+  for (long i = 0; i < arg->n; i++) {
+    int v = (int)i;
+    while (!mpmc_enqueue(arg->q, INT, &v)) sched_yield();
+  }
+  return NULL;
+}
+
+
+
+static void* mpmc_consume(void *p) {
+  bench_arg_t *arg = p;
+  element_t e;
+
+  for (long i = 0; i < arg->n; i++) {
+    while (!mpmc_dequeue(arg->q, &e)) sched_yield();
+    arg->sum += e.value.ival;
+  }
+  return NULL;
+}
+
+
+
+static void* qll_produce(void *p) {
+  bench_arg_t *arg = p;
+
+  for (long i = 0; i < arg->n; i++) {
+    int v = (int)i;
+    pthread_mutex_lock(&arg->lq->lock);
+    qll_enqueue(arg->lq->qll, INT, &v);
+    pthread_mutex_unlock(&arg->lq->lock);
+  }
+  return NULL;
+}
+
+
+
+static void* qll_consume(void *p) {
+  bench_arg_t *arg = p;
+
+  for (long i = 0; i < arg->n; ) {
+    pthread_mutex_lock(&arg->lq->lock);
+    node_t *node = qll_dequeue(arg->lq->qll);
+    pthread_mutex_unlock(&arg->lq->lock);
+
+    if (!node) { sched_yield(); continue; }
+    arg->sum += node->data.value.ival;
+    qll_recycle_node(arg->lq->qll, node);
+    i++;
+  }
+  return NULL;
+}
+
+
+
+/* run pairs producers and pairs consumers, each moving n / pairs elements */
+static long long run(const char *name, void *(*produce)(void *), void *(*consume)(void *),
+                     mpmc_queue_t *q, locked_qll_t *lq, long n, int pairs) {
+  pthread_t *threads = malloc(2 * pairs * sizeof(pthread_t));
+  bench_arg_t *args = malloc(2 * pairs * sizeof(bench_arg_t));
+  if (!threads || !args) return 0;
+
+  long per_thread = n / pairs;
+  double start = now_sec();
+
+  for (int i = 0; i < 2 * pairs; i++) {
+    args[i] = (bench_arg_t){ q, lq, per_thread, 0 };
+    pthread_create(&threads[i], NULL, i < pairs ? produce : consume, &args[i]);
+  }
+
+  long long sum = 0;
+  for (int i = 0; i < 2 * pairs; i++) {
+    pthread_join(threads[i], NULL);
+    sum += args[i].sum;
+  }
+
+  double elapsed = now_sec() - start;
+  long moved = per_thread * pairs;
+  printf("%-10s %8d %12ld %10.2f %10.2f\n", name, 2 * pairs, moved,
+         elapsed * 1e9 / moved, moved / elapsed / 1e6);
+
+  free(threads);
+  free(args);
+  return sum;
+}
+
+
+
+int main(int argc, char *argv[]) {
+  long n = argc > 1 ? atol(argv[1]) : 2000000;
+  int max_threads = argc > 2 ? atoi(argv[2]) : 64;
+  if (n <= 0 || n > 0x7fffffff || max_threads < 2) return 1;
+
+  printf("%-10s %8s %12s %10s %10s\n", "queue", "threads", "elements", "ns/elem", "Melem/s");
+
+  long long sum = 0;
+  for (int threads = 2; threads <= max_threads; threads *= 2) {
+    mpmc_queue_t *q = mpmc_init(BENCH_RING);
+    locked_qll_t lq;
+    lq.qll = qll_init();
+    if (!q || !lq.qll || pthread_mutex_init(&lq.lock, NULL) != 0) return 1;
+
+    sum += run("mpmc", mpmc_produce, mpmc_consume, q, NULL, n, threads / 2);
+    sum += run("qll+mutex", qll_produce, qll_consume, NULL, &lq, n, threads / 2);
+
+    pthread_mutex_destroy(&lq.lock);
+    qll_free(&lq.qll);
+    mpmc_free(&q);
+  }
+
+  printf("checksum %lld\n", sum);
+  return 0;
+}
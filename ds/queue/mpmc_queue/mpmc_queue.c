@@ -0,0 +1,148 @@
+#include "mpmc_queue.h"
+
+#define MPMC_MAX_CAPACITY (1 << 30)
+
+
+mpmc_queue_t* mpmc_init(int capacity) {
+  if (capacity <= 0 || capacity > MPMC_MAX_CAPACITY) return NULL;
+
+  // a ring of one slot can't tell a free slot from a filled one
+  size_t cap = 2;
+  while (cap < (size_t)capacity) cap *= 2;
+
+  // the struct is cache line aligned, so the positions don't share a line
+  mpmc_queue_t *q = aligned_alloc(MPMC_CACHE_LINE, sizeof(mpmc_queue_t));
+  if (!q) return NULL;
+
+  q->cells = malloc(cap * sizeof(mpmc_cell_t));
+  if (!q->cells) {
+    free(q);
+    return NULL;
+  }
+
+  // slot i is free for the producer at position i
+  for (size_t i = 0; i < cap; i++) atomic_init(&q->cells[i].seq, i);
+
+  atomic_init(&q->enqueue_pos, 0);
+  atomic_init(&q->dequeue_pos, 0);
+  q->mask = cap - 1;
+  return q;
+}
+
+
+
+bool mpmc_enqueue(mpmc_queue_t *q, etype_t etype, void *val) {
+  if (!q) return false;
+
+  // built before a slot is claimed, a claimed slot can't fail to fill
+  element_t e;
+  if (!el_set(&e, etype, val, NULL)) return false;
+
+  size_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+  mpmc_cell_t *cell;
+
+  for (;;) {
+    cell = &q->cells[pos & q->mask];
+    size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+    ptrdiff_t dif = (ptrdiff_t)(seq - pos);
+
+    if (dif == 0) {
+      // the slot is free, claim the position (pos is reloaded on failure)
+      if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                memory_order_relaxed, memory_order_relaxed))
+        break;
+    } else if (dif < 0) {
+      // the slot is still filled from the last lap, queue is full
+      el_clear(&e, NULL);
+      return false;
+    } else {
+      // another producer took the position, catch up
+      pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+    }
+  }
+
+  cell->data = e;
+  atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+  return true;
+}
+
+
+
+bool mpmc_dequeue(mpmc_queue_t *q, element_t *out) {
+  if (!q || !out) return false;
+
+  size_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+  mpmc_cell_t *cell;
+
+  for (;;) {
+    cell = &q->cells[pos & q->mask];
+    size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+    ptrdiff_t dif = (ptrdiff_t)(seq - (pos + 1));
+
+    if (dif == 0) {
+      // the slot is filled, claim the position (pos is reloaded on failure)
+      if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + 1,
+                                                memory_order_relaxed, memory_order_relaxed))
+        break;
+    } else if (dif < 0) {
+      // the slot is not filled yet, queue is empty
+      return false;
+    } else {
+      // another consumer took the position, catch up
+      pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+    }
+  }
+
+  *out = cell->data;
+
+  // free for the producer one lap ahead
+  atomic_store_explicit(&cell->seq, pos + q->mask + 1, memory_order_release);
+  return true;
+}
+
+
+
+bool mpmc_is_empty(mpmc_queue_t *q) {
+  return mpmc_size(q) == 0;
+}
+
+
+
+bool mpmc_is_full(mpmc_queue_t *q) {
+  return q && mpmc_size(q) == mpmc_capacity(q);
+}
+
+
+
+int mpmc_size(mpmc_queue_t *q) {
+  if (!q) return 0;
+
+  // the two loads are not one snapshot, keep the result in range
+  size_t deq = atomic_load_explicit(&q->dequeue_pos, memory_order_acquire);
+  size_t enq = atomic_load_explicit(&q->enqueue_pos, memory_order_acquire);
+  ptrdiff_t size = (ptrdiff_t)(enq - deq);
+
+  if (size < 0) return 0;
+  if ((size_t)size > q->mask + 1) return (int)(q->mask + 1);
+  return (int)size;
+}
+
+
+
+int mpmc_capacity(mpmc_queue_t *q) {
+  return q ? (int)(q->mask + 1) : 0;
+}
+
+
+
+void mpmc_free(mpmc_queue_t **q) {
+  if (!q || !*q) return;
+
+  // release the strings of the elements left in the queue
+  element_t e;
+  while (mpmc_dequeue(*q, &e)) el_clear(&e, NULL);
+
+  free((*q)->cells);
+  free(*q);
+  *q = NULL;
+}
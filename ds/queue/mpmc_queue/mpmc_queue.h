@@ -0,0 +1,177 @@
+#ifndef __QUEUE_MPMC_HEADER__
+#define __QUEUE_MPMC_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#include "element.h"
+
+#define MPMC_CACHE_LINE  64     // the two positions are kept on their own lines
+
+/*
+Some Design Notes:
+- multi producer / multi consumer bounded queue (D. Vyukov's design), any
+  no of threads can enqueue and dequeue at the same time. no locks, a
+  thread only retries its CAS when another thread took the same slot
+  (lock-free, not wait-free)
+
+- capacity is given at init and rounded upto a power of 2 (atleast 2), a
+  slot is (position & mask). the enqueue / dequeue positions are free
+  running counters, each on its own cache line
+
+- every slot has a sequence no, which says whose turn it is :-
+    seq == pos         -> free, a producer at pos can claim it
+    seq == pos + 1     -> filled, a consumer at pos can claim it
+  a producer claims pos with a CAS on the enqueue position, writes the
+  element and releases seq = pos + 1. a consumer claims pos with a CAS on
+  the dequeue position, reads the element and releases seq = pos + C, the
+  slot is then free for the producer one lap ahead. the threads contend
+  only on the position counters, never on a lock
+
+- the element is built (a string copied) before a slot is claimed, so a
+  claimed slot is always filled in a bounded no of steps
+
+- elements are stored in the ring by value. a string is owned by the
+  consumer after the dequeue (el_clear it)
+
+- same shape as the circular queue (cqueue_t) :- enqueue / dequeue /
+  is_empty / is_full, but dequeue copies the element out instead of
+  returning a malloc'd one (no allocation on the hot path). there is no
+  peek, another consumer can take the element right after it
+
+usage :-
+  mpmc_queue_t *q = mpmc_init(1024);
+
+  // any thread                      // any thread
+  mpmc_enqueue(q, INT, &val);         element_t e;
+                                      if (mpmc_dequeue(q, &e)) { ...; el_clear(&e, NULL); }
+  ...
+  mpmc_free(&q);                      // after all the threads are done
+*/
+
+
+/* a slot of the ring, its sequence no and the element */
+typedef struct {
+  atomic_size_t seq;
+  element_t data;
+} mpmc_cell_t;
+
+
+
+/* struct representation of the mpmc queue */
+typedef struct {
+  _Alignas(MPMC_CACHE_LINE) atomic_size_t enqueue_pos;   // next position to fill
+  _Alignas(MPMC_CACHE_LINE) atomic_size_t dequeue_pos;   // next position to empty
+
+  // read only after init
+  _Alignas(MPMC_CACHE_LINE) size_t mask;                 // capacity - 1
+  mpmc_cell_t *cells;
+} mpmc_queue_t;
+
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Allocate the queue with room for atleast the given no of elements
+ *
+ *        time complexity  - O(C); C - capacity, the sequence nos are set
+ *        space complexity - O(C)
+ *
+ * @param int - capacity, rounded upto a power of 2 (> 0)
+ * @return mpmc_queue_t* - NULL, if the capacity is invalid or out of memory
+ */
+mpmc_queue_t* mpmc_init(int);
+
+/**
+ * @brief Push a value into the last of the queue. any thread
+ *
+ *        time complexity  - O(1), retried on a lost CAS
+ *                           O(N); if etype is str, N - length of string
+ *        space complexity - O(1)
+ *
+ * @param mpmc_queue_t - ref to mpmc_queue_t struct
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param void * - void pointer to value, will be typecasted based on enum type
+ * @return true
+ * @return false - queue is full, invalid type or out of memory
+ */
+bool mpmc_enqueue(mpmc_queue_t *, etype_t, void *);
+
+/**
+ * @brief Removes the first element into the given element. any thread
+ *
+ *        time complexity  - O(1), retried on a lost CAS
+ *        space complexity - O(1)
+ *
+ * @param mpmc_queue_t - ref to mpmc_queue_t struct
+ * @param element_t - ref to element_t, takes the element (and its string)
+ * @return true
+ * @return false - queue is empty
+ */
+bool mpmc_dequeue(mpmc_queue_t *, element_t *);
+
+/**
+ * @brief Verify if the queue is empty, a snapshot if other threads are running
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param mpmc_queue_t - ref to mpmc_queue_t struct
+ * @return true
+ * @return false
+ */
+bool mpmc_is_empty(mpmc_queue_t *);
+
+/**
+ * @brief Verify if the queue is full, a snapshot if other threads are running
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param mpmc_queue_t - ref to mpmc_queue_t struct
+ * @return true
+ * @return false
+ */
+bool mpmc_is_full(mpmc_queue_t *);
+
+/**
+ * @brief No of elements in the queue, a snapshot if other threads are running
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param mpmc_queue_t - ref to mpmc_queue_t struct
+ * @return int - 0 to capacity
+ */
+int mpmc_size(mpmc_queue_t *);
+
+/**
+ * @brief Capacity of the queue (a power of 2)
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param mpmc_queue_t - ref to mpmc_queue_t struct
+ * @return int
+ */
+int mpmc_capacity(mpmc_queue_t *);
+
+/**
+ * @brief Release the memory of entire queue, and the elements left in it.
+ *        no thread may be using the queue
+ *
+ *        time complexity  - O(N); N - no of elements in queue
+ *        space complexity - O(1)
+ *
+ * @param mpmc_queue_t - ref to ref to mpmc_queue_t struct
+ */
+void mpmc_free(mpmc_queue_t **);
+
+#endif   // __QUEUE_MPMC_HEADER__
@@ -0,0 +1,139 @@
+#include "mpmc_queue.h"
+#include "stress.h"
+
+// Function prototypes for test cases
+void test_mpmc_init();
+void test_mpmc_enqueue_dequeue();
+void test_mpmc_full();
+void test_mpmc_wraparound();
+void test_mpmc_string();
+void test_mpmc_stress();
+
+int main() {
+  test_mpmc_init();
+  test_mpmc_enqueue_dequeue();
+  test_mpmc_full();
+  test_mpmc_wraparound();
+  test_mpmc_string();
+  test_mpmc_stress();
+
+  printf("\n*** All tests passed!***\n");
+  return 0;
+}
+
+void test_mpmc_init() {
+  mpmc_queue_t *q = mpmc_init(5);
+  assert(q != NULL);
+  assert(mpmc_capacity(q) == 8);
+  assert(mpmc_is_empty(q) && !mpmc_is_full(q));
+  mpmc_free(&q);
+  assert(q == NULL);
+
+  // atleast two slots
+  q = mpmc_init(1);
+  assert(mpmc_capacity(q) == 2);
+  mpmc_free(&q);
+
+  assert(mpmc_init(0) == NULL);
+  assert(mpmc_init(-1) == NULL);
+}
+
+void test_mpmc_enqueue_dequeue() {
+  mpmc_queue_t *q = mpmc_init(4);
+  element_t e;
+
+  int a = 10, b = 20;
+  float f = 1.5f;
+  assert(mpmc_enqueue(q, INT, &a));
+  assert(mpmc_enqueue(q, INT, &b));
+  assert(mpmc_enqueue(q, FLO, &f));
+  assert(mpmc_size(q) == 3);
+
+  assert(mpmc_dequeue(q, &e) && e.etype == INT && e.value.ival == 10);
+  assert(mpmc_dequeue(q, &e) && e.etype == INT && e.value.ival == 20);
+  assert(mpmc_dequeue(q, &e) && e.etype == FLO && e.value.fval == 1.5f);
+  assert(!mpmc_dequeue(q, &e));
+  assert(mpmc_is_empty(q));
+
+  mpmc_free(&q);
+}
+
+void test_mpmc_full() {
+  mpmc_queue_t *q = mpmc_init(4);
+
+  // every slot is usable, none is kept empty
+  for (int i = 0; i < 4; i++) assert(mpmc_enqueue(q, INT, &i));
+  assert(mpmc_is_full(q) && mpmc_size(q) == 4);
+
+  int extra = 99;
+  assert(!mpmc_enqueue(q, INT, &extra));
+
+  element_t e;
+  assert(mpmc_dequeue(q, &e) && e.value.ival == 0);
+  assert(mpmc_enqueue(q, INT, &extra));
+  assert(mpmc_is_full(q));
+
+  mpmc_free(&q);
+}
+
+void test_mpmc_wraparound() {
+  mpmc_queue_t *q = mpmc_init(4);
+  element_t e;
+  int next_in = 0, next_out = 0;
+
+  // the positions run many laps around the ring
+  for (int round = 0; round < 100; round++) {
+    for (int i = 0; i < 3; i++, next_in++) assert(mpmc_enqueue(q, INT, &next_in));
+    for (int i = 0; i < 3; i++, next_out++) {
+      assert(mpmc_dequeue(q, &e));
+      assert(e.value.ival == next_out);
+    }
+  }
+  assert(mpmc_is_empty(q));
+
+  mpmc_free(&q);
+}
+
+void test_mpmc_string() {
+  mpmc_queue_t *q = mpmc_init(4);
+  element_t e, key;
+
+  char *s = "hello";
+  char *l = "a string longer than the inline small string";
+  assert(mpmc_enqueue(q, STR, s));
+  assert(mpmc_enqueue(q, STR, l));
+
+  assert(mpmc_dequeue(q, &e) && e.etype == STR);
+  assert(el_key(&key, STR, s, NULL) && el_match(&e, &key, NULL));
+  el_clear(&e, NULL);
+
+  // the one left is released by mpmc_free
+  mpmc_free(&q);
+}
+
+
+static bool stress_put(void *q, int v) {
+  return mpmc_enqueue(q, INT, &v);
+}
+
+static bool stress_take(void *q, int *v) {
+  element_t e;
+  if (!mpmc_dequeue(q, &e)) return false;
+
+  assert(e.etype == INT);
+  *v = e.value.ival;
+  return true;
+}
+
+void test_mpmc_stress() {
+  // a small ring, so the full and the empty paths are taken often
+  mpmc_queue_t *q = mpmc_init(64);
+  assert(q);
+
+  stress_t st = { .shared = q, .put = stress_put, .take = stress_take,
+                  .producers = 4, .consumers = 4, .per_thread = 50000, .fifo = true };
+  stress_run(&st);
+  assert(mpmc_is_empty(q));
+
+  mpmc_free(&q);
+}
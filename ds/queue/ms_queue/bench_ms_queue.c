@@ -0,0 +1,152 @@
+#include "ms_queue.h"
+#include "queue_ll.h"
+
+#include <time.h>
+#include <pthread.h>
+
+/*
+  Scaling of the lock-free queue (ms_queue_t) against the linked list queue
+  (queue_ll_t) behind one pthread mutex. every thread does pairs of enqueue
+  and dequeue (so a dequeue never finds the queue empty), both the queues
+  take their nodes from a shared pool.
+  usage :- bench_ms_queue [no of pairs] [max threads]  ; default is 1e6 and 64
+
+  threads   :- 1 2 4 ... upto max threads
+  ns/pair   :- wall time per enqueue + dequeue
+  Mpair/s   :- pairs per second, by all the threads together
+
+  with more threads than cores, a thread can be preempted holding the
+  mutex (or in the middle of a CAS loop), the numbers from such a run
+  measure the scheduler more than the queue
+*/
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+/* queue_ll_t made shareable the usual way, a lock around every call */
+typedef struct {
+  pthread_mutex_t lock;
+  queue_ll_t *qll;
+} locked_qll_t;
+
+
+
+typedef struct {
+  ms_queue_t *q;
+  locked_qll_t *lq;
+  long n;                 // no of pairs this thread does
+  long long sum;
+} bench_arg_t;
+
+
+
+static void* msq_pairs(void *p) {
+  bench_arg_t *arg = p;
+  msq_handle_t *h = msq_attach(arg->q);
+  if (!h) return NULL;
+
+  element_t e;
+  for (long i = 0; i < arg->n; i++) {
+    int v = (int)i;
+    msq_enqueue(h, INT, &v);
+    if (msq_dequeue(h, &e)) arg->sum += e.value.ival;
+  }
+
+  msq_detach(h);
+  return NULL;
+}
+
+
+
+static void* qll_pairs(void *p) {
+  bench_arg_t *arg = p;
+  locked_qll_t *lq = arg->lq;
+
+  for (long i = 0; i < arg->n; i++) {
+    int v = (int)i;
+    pthread_mutex_lock(&lq->lock);
+    qll_enqueue(lq->qll, INT, &v);
+    pthread_mutex_unlock(&lq->lock);
+
+    pthread_mutex_lock(&lq->lock);
+    node_t *node = qll_dequeue(lq->qll);
+    if (node) {
+      arg->sum += node->data.value.ival;
+      qll_recycle_node(lq->qll, node);
+    }
+    pthread_mutex_unlock(&lq->lock);
+  }
+  return NULL;
+}
+
+
+
+/* run the threads, each doing n / threads pairs */
+static long long run(const char *name, void *(*body)(void *),
+                     ms_queue_t *q, locked_qll_t *lq, long n, int threads) {
+  pthread_t *tids = malloc(threads * sizeof(pthread_t));
+  bench_arg_t *args = malloc(threads * sizeof(bench_arg_t));
+  if (!tids || !args) return 0;
+
+  long per_thread = n / threads;
+  double start = now_sec();
+
+  for (int i = 0; i < threads; i++) {
+    args[i] = (bench_arg_t){ q, lq, per_thread, 0 };
+    pthread_create(&tids[i], NULL, body, &args[i]);
+  }
+
+  long long sum = 0;
+  for (int i = 0; i < threads; i++) {
+    pthread_join(tids[i], NULL);
+    sum += args[i].sum;
+  }
+
+  double elapsed = now_sec() - start;
+  long pairs = per_thread * threads;
+  printf("%-10s %8d %12ld %10.2f %10.2f\n", name, threads, pairs,
+         elapsed * 1e9 / pairs, pairs / elapsed / 1e6);
+
+  free(tids);
+  free(args);
+  return sum;
+}
+
+
+
+int main(int argc, char *argv[]) {
+  long n = argc > 1 ? atol(argv[1]) : 1000000;
+  int max_threads = argc > 2 ? atoi(argv[2]) : 64;
+  if (n <= 0 || n > 0x7fffffff || max_threads < 1) return 1;
+
+  printf("%-10s %8s %12s %10s %10s\n", "queue", "threads", "pairs", "ns/pair", "Mpair/s");
+
+  long long sum = 0;
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    // a pool for each queue's nodes, shared by its threads
+    pool_t *mpool = pool_init_shared(sizeof(msq_node_t), 0);
+    pool_t *qpool = pool_init_shared(sizeof(node_t), 0);
+
+    ms_queue_t *q = msq_init_pool(threads, mpool);
+    locked_qll_t lq;
+    lq.qll = qll_init_pool(qpool);
+    if (!q || !lq.qll || pthread_mutex_init(&lq.lock, NULL) != 0) return 1;
+
+    sum += run("ms_queue", msq_pairs, q, NULL, n, threads);
+    sum += run("qll+mutex", qll_pairs, NULL, &lq, n, threads);
+
+    pthread_mutex_destroy(&lq.lock);
+    qll_free(&lq.qll);
+    msq_free(&q);
+    pool_destroy(mpool);
+    pool_destroy(qpool);
+  }
+
+  printf("checksum %lld\n", sum);
+  return 0;
+}
@@ -0,0 +1,288 @@
+#include "ms_queue.h"
+
+
+static msq_node_t* msq_alloc_node(ms_queue_t *, pool_cache_t *);
+static void msq_release_node(ms_queue_t *, pool_cache_t *, msq_node_t *);
+static void msq_retire(msq_handle_t *, msq_node_t *);
+static void msq_scan(msq_handle_t *);
+
+
+ms_queue_t* msq_init(int max_threads) {
+  return msq_init_pool(max_threads, NULL);
+}
+
+
+
+ms_queue_t* msq_init_pool(int max_threads, pool_t *pool) {
+  if (max_threads <= 0) return NULL;
+
+  // the struct is cache line aligned, so the two ends don't share a line
+  ms_queue_t *q = aligned_alloc(MSQ_CACHE_LINE, sizeof(ms_queue_t));
+  if (!q) return NULL;
+
+  q->pool = pool;
+  q->max_threads = max_threads;
+  q->retire_limit = 2 * MSQ_HAZARDS * max_threads;
+  q->handles = aligned_alloc(MSQ_CACHE_LINE, max_threads * sizeof(msq_handle_t));
+
+  msq_node_t *dummy = msq_alloc_node(q, NULL);
+  if (!q->handles || !dummy) {
+    msq_release_node(q, NULL, dummy);
+    free(q->handles);
+    free(q);
+    return NULL;
+  }
+
+  // the retired lists are taken on the first attach of a handle
+  for (int i = 0; i < max_threads; i++) {
+    msq_handle_t *h = &q->handles[i];
+    for (int j = 0; j < MSQ_HAZARDS; j++) atomic_init(&h->hazard[j], NULL);
+    atomic_init(&h->active, false);
+    h->q = q;
+    h->cache = NULL;
+    h->retired = NULL;
+    h->nretired = 0;
+    h->scratch = NULL;
+  }
+
+  atomic_init(&dummy->next, NULL);
+  atomic_init(&q->first, dummy);
+  atomic_init(&q->last, dummy);
+  return q;
+}
+
+
+
+msq_handle_t* msq_attach(ms_queue_t *q) {
+  if (!q) return NULL;
+
+  for (int i = 0; i < q->max_threads; i++) {
+    msq_handle_t *h = &q->handles[i];
+
+    bool expected = false;
+    if (atomic_load_explicit(&h->active, memory_order_relaxed) ||
+        !atomic_compare_exchange_strong(&h->active, &expected, true))
+      continue;
+
+    // kept across owners, what failed before is retried here
+    if (!h->retired) h->retired = malloc(q->retire_limit * sizeof(msq_node_t *));
+    if (!h->scratch) h->scratch = malloc(q->max_threads * MSQ_HAZARDS * sizeof(msq_node_t *));
+    if (q->pool) h->cache = pool_cache_init(q->pool);
+
+    // release the slot and try the other free handles
+    if (!h->retired || !h->scratch || (q->pool && !h->cache)) {
+      msq_detach(h);
+      continue;
+    }
+    return h;
+  }
+  return NULL;
+}
+
+
+
+void msq_detach(msq_handle_t *h) {
+  if (!h) return;
+
+  // free what can be freed now, the rest waits for the next owner
+  if (h->retired && h->scratch) msq_scan(h);
+
+  pool_cache_destroy(h->cache);
+  h->cache = NULL;
+  atomic_store(&h->active, false);
+}
+
+
+
+bool msq_enqueue(msq_handle_t *h, etype_t etype, void *val) {
+  if (!h || !val) return false;
+  ms_queue_t *q = h->q;
+
+  msq_node_t *node = msq_alloc_node(q, h->cache);
+  if (!node) return false;
+
+  if (!el_set(&node->data, etype, val, NULL)) {
+    msq_release_node(q, h->cache, node);
+    return false;
+  }
+  atomic_init(&node->next, NULL);
+
+  for (;;) {
+    // publish the hazard, then check last didn't move meanwhile
+    msq_node_t *last = atomic_load(&q->last);
+    atomic_store(&h->hazard[0], last);
+    if (last != atomic_load(&q->last)) continue;
+
+    msq_node_t *next = atomic_load(&last->next);
+    if (next) {
+      // last is lagging, help it forward and retry
+      atomic_compare_exchange_strong(&q->last, &last, next);
+      continue;
+    }
+
+    msq_node_t *expected = NULL;
+    if (atomic_compare_exchange_strong(&last->next, &expected, node)) {
+      // linked, move last to it (some other thread may do it first)
+      atomic_compare_exchange_strong(&q->last, &last, node);
+      break;
+    }
+  }
+
+  atomic_store_explicit(&h->hazard[0], NULL, memory_order_release);
+  return true;
+}
+
+
+
+bool msq_dequeue(msq_handle_t *h, element_t *out) {
+  if (!h || !out) return false;
+  ms_queue_t *q = h->q;
+
+  msq_node_t *first, *next;
+  element_t value;
+
+  for (;;) {
+    first = atomic_load(&q->first);
+    atomic_store(&h->hazard[0], first);
+    if (first != atomic_load(&q->first)) continue;
+
+    msq_node_t *last = atomic_load(&q->last);
+    next = atomic_load(&first->next);
+
+    // next can't be retired while first is still the dummy
+    atomic_store(&h->hazard[1], next);
+    if (first != atomic_load(&q->first)) continue;
+
+    if (!next) {
+      atomic_store_explicit(&h->hazard[0], NULL, memory_order_release);
+      atomic_store_explicit(&h->hazard[1], NULL, memory_order_release);
+      return false;
+    }
+
+    if (first == last) {
+      // last is lagging behind first, help it forward
+      atomic_compare_exchange_strong(&q->last, &last, next);
+      continue;
+    }
+
+    // read before the CAS, after it next may be dequeued by another thread
+    value = next->data;
+    if (atomic_compare_exchange_strong(&q->first, &first, next)) break;
+  }
+
+  atomic_store_explicit(&h->hazard[0], NULL, memory_order_release);
+  atomic_store_explicit(&h->hazard[1], NULL, memory_order_release);
+
+  // next is the new dummy, its value (and string) now belongs to the caller
+  *out = value;
+  msq_retire(h, first);
+  return true;
+}
+
+
+
+bool msq_is_empty(msq_handle_t *h) {
+  if (!h) return true;
+  ms_queue_t *q = h->q;
+
+  msq_node_t *first;
+  do {
+    first = atomic_load(&q->first);
+    atomic_store(&h->hazard[0], first);
+  } while (first != atomic_load(&q->first));
+
+  bool empty = atomic_load(&first->next) == NULL;
+  atomic_store_explicit(&h->hazard[0], NULL, memory_order_release);
+  return empty;
+}
+
+
+
+void msq_free(ms_queue_t **q) {
+  if (!q || !*q) return;
+  ms_queue_t *queue = *q;
+
+  // the dummy's value was taken by its dequeue, the rest own theirs
+  msq_node_t *curr = atomic_load(&queue->first);
+  msq_node_t *next = atomic_load(&curr->next);
+  msq_release_node(queue, NULL, curr);
+
+  for (curr = next; curr; curr = next) {
+    next = atomic_load(&curr->next);
+    el_clear(&curr->data, NULL);
+    msq_release_node(queue, NULL, curr);
+  }
+
+  // no thread is left to read the retired nodes
+  for (int i = 0; i < queue->max_threads; i++) {
+    msq_handle_t *h = &queue->handles[i];
+    for (int j = 0; j < h->nretired; j++) msq_release_node(queue, NULL, h->retired[j]);
+    free(h->retired);
+    free(h->scratch);
+  }
+
+  free(queue->handles);
+  free(queue);
+  *q = NULL;
+}
+
+
+/* ---------- UTIL FUNCTIONS ---------- */
+
+/* node from the thread's cache, the shared pool or malloc */
+static msq_node_t* msq_alloc_node(ms_queue_t *q, pool_cache_t *cache) {
+  if (cache) return pool_cache_alloc(cache);
+  return pool_get(q->pool, sizeof(msq_node_t));
+}
+
+
+
+static void msq_release_node(ms_queue_t *q, pool_cache_t *cache, msq_node_t *node) {
+  if (!node) return;
+
+  if (cache) pool_cache_free(cache, node);
+  else pool_put(q->pool, node);
+}
+
+
+
+/* hold a removed node till no hazard pointer refers it */
+static void msq_retire(msq_handle_t *h, msq_node_t *node) {
+  h->retired[h->nretired++] = node;
+  if (h->nretired >= h->q->retire_limit) msq_scan(h);
+}
+
+
+
+static int cmp_ptr(const void *a, const void *b) {
+  const char *x = *(const char * const *)a, *y = *(const char * const *)b;
+  return (x > y) - (x < y);
+}
+
+
+
+/* free the retired nodes that are in no hazard pointer. the list has
+   2 * H nodes (H - all the hazard pointers), so atleast half are freed */
+static void msq_scan(msq_handle_t *h) {
+  ms_queue_t *q = h->q;
+  int nhazards = 0;
+
+  for (int i = 0; i < q->max_threads; i++) {
+    for (int j = 0; j < MSQ_HAZARDS; j++) {
+      msq_node_t *hp = atomic_load(&q->handles[i].hazard[j]);
+      if (hp) h->scratch[nhazards++] = hp;
+    }
+  }
+  qsort(h->scratch, nhazards, sizeof(msq_node_t *), cmp_ptr);
+
+  int kept = 0;
+  for (int i = 0; i < h->nretired; i++) {
+    msq_node_t *node = h->retired[i];
+
+    if (bsearch(&node, h->scratch, nhazards, sizeof(msq_node_t *), cmp_ptr))
+      h->retired[kept++] = node;
+    else
+      msq_release_node(q, h->cache, node);
+  }
+  h->nretired = kept;
+}
@@ -0,0 +1,197 @@
+#ifndef __QUEUE_MS_HEADER__
+#define __QUEUE_MS_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "pool.h"
+#include "element.h"
+
+#define MSQ_CACHE_LINE  64     // first, last & every handle are on their own lines
+#define MSQ_HAZARDS     2      // hazard pointers per thread
+
+/*
+Some Design Notes:
+- unbounded multi producer / multi consumer queue (Michael & Scott), the
+  linked list queue (queue_ll_t) made lock-free :- values are added at the
+  last and removed from the first, both the ends are moved with a CAS
+
+- the list always starts with a dummy node, first points to it and the
+  value of the queue's first element is in first->next. a dequeue copies
+  that value out and makes first->next the new dummy, so the producers and
+  the consumers never touch the same node pointer. last may lag one node
+  behind, any thread that sees it lagging moves it forward
+
+- a dequeued node can't be freed right away, another thread may still be
+  reading it. every thread publishes the nodes it is about to read in its
+  hazard pointers (MSQ_HAZARDS of them), and a removed node is retired to
+  a list of the thread. when the list has 2 * MSQ_HAZARDS * T nodes (T -
+  max threads), it is scanned and the nodes no hazard pointer holds are
+  freed, atleast half the list each time (amortized O(1) per dequeue)
+
+- a thread attaches to the queue to get its handle (hazard pointers,
+  retired list, pool cache), upto max_threads at a time. a detached handle
+  is reused by the next thread to attach, along with the nodes still left
+  in its retired list
+
+- nodes can come from a shared pool (pool_init_shared), each handle keeps
+  a pool_cache_t in front of it, so a node alloc / free doesn't lock
+
+- no size is kept, a shared counter would be one more contended line on
+  every call
+
+usage :-
+  ms_queue_t *q = msq_init(64);
+
+  // every thread
+  msq_handle_t *h = msq_attach(q);
+  msq_enqueue(h, INT, &val);
+  element_t e;
+  if (msq_dequeue(h, &e)) { ...; el_clear(&e, NULL); }
+  msq_detach(h);
+
+  msq_free(&q);                       // after all the threads are done
+*/
+
+
+/* struct representation of a node */
+typedef struct msq_node {
+  element_t data;
+  _Atomic(struct msq_node *) next;
+} msq_node_t;
+
+
+struct ms_queue;
+
+/* per thread state, from msq_attach */
+typedef struct {
+  _Alignas(MSQ_CACHE_LINE) _Atomic(msq_node_t *) hazard[MSQ_HAZARDS];
+  atomic_bool active;         // attached to a thread?
+
+  struct ms_queue *q;
+  pool_cache_t *cache;        // node allocator, NULL if the queue has no pool
+  msq_node_t **retired;       // removed nodes, waiting for no hazard
+  int nretired;
+  msq_node_t **scratch;       // hazard snapshot of a scan
+} msq_handle_t;
+
+
+/* struct representation of a queue */
+typedef struct ms_queue {
+  _Alignas(MSQ_CACHE_LINE) _Atomic(msq_node_t *) first;   // dummy, values are removed after it
+  _Alignas(MSQ_CACHE_LINE) _Atomic(msq_node_t *) last;    // values are added after it
+
+  // read only after init
+  _Alignas(MSQ_CACHE_LINE) pool_t *pool;  // shared allocator for the nodes, NULL to use malloc
+  int max_threads;
+  int retire_limit;                       // retired nodes that trigger a scan
+  msq_handle_t *handles;                  // max_threads handles
+} ms_queue_t;
+
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Allocate memory for the queue, with the dummy node
+ *
+ *        time complexity  - O(T); T - max threads
+ *        space complexity - O(T^2), the retired lists of the handles
+ *
+ * @param int - max no of threads attached at a time (> 0)
+ * @return ms_queue_t* - NULL, if invalid or out of memory
+ */
+ms_queue_t* msq_init(int);
+
+/**
+ * @brief Same as msq_init, but the nodes are allocated from the pool
+ *
+ *        time complexity  - O(T); T - max threads
+ *        space complexity - O(T^2)
+ *
+ * @param int - max no of threads attached at a time (> 0)
+ * @param pool_t* - pool from pool_init_shared, of sizeof(msq_node_t) slots
+ * @return ms_queue_t*
+ */
+ms_queue_t* msq_init_pool(int, pool_t *);
+
+/**
+ * @brief Attach the calling thread to the queue, and get its handle
+ *
+ *        time complexity  - O(T); T - max threads
+ *        space complexity - O(1)
+ *
+ * @param ms_queue_t* - ref to ms_queue_t struct
+ * @return msq_handle_t* - NULL, if max threads are attached
+ */
+msq_handle_t* msq_attach(ms_queue_t *);
+
+/**
+ * @brief Detach the thread, the handle is free for another thread. the
+ *        retired nodes no thread reads are freed
+ *
+ *        time complexity  - O(T log T); T - max threads
+ *        space complexity - O(1)
+ *
+ * @param msq_handle_t* - handle from msq_attach
+ */
+void msq_detach(msq_handle_t *);
+
+/**
+ * @brief Push a value into the last of the queue
+ *
+ *        time complexity  - O(1), retried on a lost CAS
+ *                           O(N); if etype is str, N - length of string
+ *        space complexity - O(1)
+ *
+ * @param msq_handle_t* - handle of the calling thread
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param void * - void pointer to value, will be typecasted based on enum type
+ * @return true
+ * @return false - invalid type or out of memory
+ */
+bool msq_enqueue(msq_handle_t *, etype_t, void *);
+
+/**
+ * @brief Removes the first element into the given element
+ *
+ *        time complexity  - O(1), retried on a lost CAS
+ *                           O(T log T) amortized over O(T) calls, on a scan
+ *        space complexity - O(1)
+ *
+ * @param msq_handle_t* - handle of the calling thread
+ * @param element_t - ref to element_t, takes the element (and its string)
+ * @return true
+ * @return false - queue is empty
+ */
+bool msq_dequeue(msq_handle_t *, element_t *);
+
+/**
+ * @brief Verify if the queue is empty, a snapshot if other threads are running
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param msq_handle_t* - handle of the calling thread
+ * @return true
+ * @return false
+ */
+bool msq_is_empty(msq_handle_t *);
+
+/**
+ * @brief Release the memory of entire queue, the elements left in it and
+ *        the retired nodes. no thread may be using the queue
+ *
+ *        time complexity  - O(N + T^2); N - no of elements in queue
+ *        space complexity - O(1)
+ *
+ * @param ms_queue_t* - ref to ref to ms_queue_t struct
+ */
+void msq_free(ms_queue_t **);
+
+#endif   // __QUEUE_MS_HEADER__
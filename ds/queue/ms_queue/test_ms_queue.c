@@ -0,0 +1,171 @@
+#include "ms_queue.h"
+#include "stress.h"
+
+// Function prototypes for test cases
+void test_msq_init();
+void test_msq_attach();
+void test_msq_enqueue_dequeue();
+void test_msq_string();
+void test_msq_reclaim();
+void test_msq_stress();
+
+int main() {
+  test_msq_init();
+  test_msq_attach();
+  test_msq_enqueue_dequeue();
+  test_msq_string();
+  test_msq_reclaim();
+  test_msq_stress();
+
+  printf("\n*** All tests passed!***\n");
+  return 0;
+}
+
+void test_msq_init() {
+  ms_queue_t *q = msq_init(4);
+  assert(q != NULL);
+  assert(atomic_load(&q->first) == atomic_load(&q->last));
+  assert(atomic_load(&atomic_load(&q->first)->next) == NULL);
+  msq_free(&q);
+  assert(q == NULL);
+
+  assert(msq_init(0) == NULL);
+}
+
+void test_msq_attach() {
+  ms_queue_t *q = msq_init(2);
+
+  msq_handle_t *a = msq_attach(q), *b = msq_attach(q);
+  assert(a && b && a != b);
+  assert(msq_attach(q) == NULL);
+
+  // a detached handle is given to the next thread
+  msq_detach(a);
+  assert(msq_attach(q) == a);
+
+  msq_detach(a);
+  msq_detach(b);
+  msq_free(&q);
+}
+
+void test_msq_enqueue_dequeue() {
+  ms_queue_t *q = msq_init(1);
+  msq_handle_t *h = msq_attach(q);
+  element_t e;
+
+  assert(msq_is_empty(h));
+  assert(!msq_dequeue(h, &e));
+
+  int a = 10, b = 20;
+  float f = 1.5f;
+  assert(msq_enqueue(h, INT, &a));
+  assert(msq_enqueue(h, INT, &b));
+  assert(msq_enqueue(h, FLO, &f));
+  assert(!msq_is_empty(h));
+
+  assert(msq_dequeue(h, &e) && e.etype == INT && e.value.ival == 10);
+  assert(msq_dequeue(h, &e) && e.etype == INT && e.value.ival == 20);
+  assert(msq_dequeue(h, &e) && e.etype == FLO && e.value.fval == 1.5f);
+  assert(!msq_dequeue(h, &e));
+  assert(msq_is_empty(h));
+
+  msq_detach(h);
+  msq_free(&q);
+}
+
+void test_msq_string() {
+  ms_queue_t *q = msq_init(1);
+  msq_handle_t *h = msq_attach(q);
+  element_t e, key;
+
+  char *s = "hello";
+  char *l = "a string longer than the inline small string";
+  assert(msq_enqueue(h, STR, s));
+  assert(msq_enqueue(h, STR, l));
+  assert(msq_enqueue(h, STR, l));
+
+  assert(msq_dequeue(h, &e) && e.etype == STR);
+  assert(el_key(&key, STR, s, NULL) && el_match(&e, &key, NULL));
+  el_clear(&e, NULL);
+
+  assert(msq_dequeue(h, &e));
+  assert(el_key(&key, STR, l, NULL) && el_match(&e, &key, NULL));
+  el_clear(&e, NULL);
+
+  // the one left is released by msq_free
+  msq_detach(h);
+  msq_free(&q);
+}
+
+void test_msq_reclaim() {
+  pool_t *pool = pool_init_shared(sizeof(msq_node_t), 0);
+  ms_queue_t *q = msq_init_pool(2, pool);
+  msq_handle_t *h = msq_attach(q);
+  element_t e;
+
+  // the retired list is scanned every few dequeues, the nodes go back
+  for (int i = 0; i < 1000; i++) {
+    assert(msq_enqueue(h, INT, &i));
+    assert(msq_dequeue(h, &e) && e.value.ival == i);
+  }
+  assert(h->nretired < q->retire_limit);
+
+  // a node in a hazard pointer is kept by the scan
+  assert(msq_enqueue(h, INT, &e.value.ival));
+  msq_handle_t *reader = msq_attach(q);
+  msq_node_t *dummy = atomic_load(&q->first);
+  atomic_store(&reader->hazard[0], dummy);
+
+  assert(msq_dequeue(h, &e));
+  msq_detach(h);
+  bool kept = false;
+  for (int i = 0; i < h->nretired; i++) kept |= h->retired[i] == dummy;
+  assert(kept);
+
+  atomic_store(&reader->hazard[0], NULL);
+  msq_detach(reader);
+  msq_free(&q);
+
+  // every node went back to the pool
+  assert(pool_in_use(pool) == 0);
+  pool_destroy(pool);
+}
+
+
+static void* stress_attach(void *q) {
+  return msq_attach(q);
+}
+
+static void stress_detach(void *h) {
+  msq_detach(h);
+}
+
+static bool stress_put(void *h, int v) {
+  return msq_enqueue(h, INT, &v);
+}
+
+static bool stress_take(void *h, int *v) {
+  element_t e;
+  if (!msq_dequeue(h, &e)) return false;
+
+  assert(e.etype == INT);
+  *v = e.value.ival;
+  return true;
+}
+
+void test_msq_stress() {
+  pool_t *pool = pool_init_shared(sizeof(msq_node_t), 0);
+  ms_queue_t *q = msq_init_pool(8, pool);
+  assert(q);
+
+  // every thread works through its own handle
+  stress_t st = { .shared = q, .attach = stress_attach, .detach = stress_detach,
+                  .put = stress_put, .take = stress_take,
+                  .producers = 4, .consumers = 4, .per_thread = 50000, .fifo = true };
+  stress_run(&st);
+
+  // no node is leaked, the retired ones included
+  msq_free(&q);
+  assert(pool_in_use(pool) == 0);
+  pool_destroy(pool);
+}
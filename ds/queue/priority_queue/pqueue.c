@@ -1,13 +1,73 @@
 #include "pqueue.h"
 
 
+/* should node a be dequeued before node b? */
+static inline bool pq_before(const node_t *a, const node_t *b) {
+  if (a->priority != b->priority) return a->priority < b->priority;
+  return a->seq < b->seq;
+}
+
+
+
+/* move the node at idx up, till its parent is not after it */
+static void pq_sift_up(priority_queue_t *pq, int idx) {
+  node_t curr = pq->nodes[idx];
+
+  while (idx > 0) {
+    int parent = (idx - 1) / PQ_ARITY;
+    if (!pq_before(&curr, &pq->nodes[parent])) break;
+
+    pq->nodes[idx] = pq->nodes[parent];
+    idx = parent;
+  }
+
+  pq->nodes[idx] = curr;
+}
+
+
+
+/* move the node at idx down, till none of its children are before it */
+static void pq_sift_down(priority_queue_t *pq, int idx) {
+  node_t curr = pq->nodes[idx];
+
+  while (true) {
+    int first_child = PQ_ARITY * idx + 1;
+    if (first_child >= pq->size) break;
+
+    // find the child to be dequeued first
+    int last_child = first_child + PQ_ARITY;
+    if (last_child > pq->size) last_child = pq->size;
+
+    int best = first_child;
+    for (int c = first_child + 1; c < last_child; c++) {
+      if (pq_before(&pq->nodes[c], &pq->nodes[best])) best = c;
+    }
+
+    if (!pq_before(&pq->nodes[best], &curr)) break;
+
+    pq->nodes[idx] = pq->nodes[best];
+    idx = best;
+  }
+
+  pq->nodes[idx] = curr;
+}
+
+
+
+
 priority_queue_t* pq_init() {
   priority_queue_t* pq = malloc(sizeof(priority_queue_t));
   if (!pq) return NULL;
 
-  pq->first = NULL;
-  pq->last = NULL;
+  pq->nodes = malloc(PQ_INIT_CAPACITY * sizeof(node_t));
+  if (!pq->nodes) {
+    free(pq);
+    return NULL;
+  }
+
+  pq->capacity = PQ_INIT_CAPACITY;
   pq->size = 0;
+  pq->seq = 0;
   return pq;
 }
 
@@ -16,37 +76,34 @@ priority_queue_t* pq_init() {
 bool pq_enqueue(priority_queue_t *pq, etype_t etype, void *val, int priority) {
   if (!pq || !val) return false;
 
-  // create a node and update it with values
-  node_t *new_node = pq_new_node(etype, val, priority);
-  if (!new_node) return false;
-
-  if (pq_is_empty(pq)) {                       // new node
-    pq->first = new_node;
-    pq->last = new_node;
-  } 
-  else if (priority < pq->first->priority) {   // insert at first
-    new_node->next = pq->first;
-    pq->first = new_node;
-  }
-  else if (priority >= pq->last->priority) {   // insert at last
-    pq->last->next = new_node;
-    pq->last = new_node;
-  } 
-  else {                                       // insert at b/w nodes
-    node_t* curr = pq->first;
-    node_t* prev = NULL;
-
-    // find the positon to insert the new value
-    while (curr != NULL && curr->priority <= priority) {
-      prev = curr;
-      curr = curr->next;
-    }
+  // heap is full, double the capacity
+  if (pq->size == pq->capacity && !pq_resize(pq)) return false;
+
+  // update the node at the end of the heap with values
+  node_t *new_node = &pq->nodes[pq->size];
+  if (!pq_set_node(new_node, etype, val, priority)) return false;
 
-    new_node->next = curr;
-    prev->next = new_node;
+  new_node->seq = pq->seq++;
+
+  // and let it float up to its position
+  pq_sift_up(pq, pq->size++);
+  return true;
+}
+
+
+
+bool pq_dequeue_into(priority_queue_t *pq, node_t *out) {
+  if (!pq || !out || pq_is_empty(pq)) return false;
+
+  *out = pq->nodes[0];
+
+  // last node takes the root, and sinks down to its position
+  pq->size--;
+  if (pq->size > 0) {
+    pq->nodes[0] = pq->nodes[pq->size];
+    pq_sift_down(pq, 0);
   }
 
-  pq->size++;   // finally increment the size
   return true;
 }
 
@@ -55,10 +112,10 @@ bool pq_enqueue(priority_queue_t *pq, etype_t etype, void *val, int priority) {
 node_t* pq_dequeue(priority_queue_t *pq) {
   if (!pq || pq_is_empty(pq)) return NULL;
 
-  node_t* pop_node = pq->first;
-  pq->first = pq->first->next;
-  pq->size--;
+  node_t* pop_node = malloc(sizeof(node_t));
+  if (!pop_node) return NULL;
 
+  pq_dequeue_into(pq, pop_node);
   return pop_node;    // caller has to free the memeory
 }
 
@@ -67,7 +124,7 @@ node_t* pq_dequeue(priority_queue_t *pq) {
 node_t* pq_peek(priority_queue_t *pq) {
   if (!pq || pq_is_empty(pq)) return NULL;
 
-  return pq->first;
+  return &pq->nodes[0];
 }
 
 
@@ -75,7 +132,7 @@ node_t* pq_peek(priority_queue_t *pq) {
 bool pq_is_empty(priority_queue_t *pq) {
   if (!pq) return false;
 
-  return pq->first == NULL;
+  return pq->size == 0;
 }
 
 
@@ -91,14 +148,11 @@ int pq_size(priority_queue_t *pq) {
 void pq_free(priority_queue_t **pq) {
   if (!pq || !*pq) return;
 
-  while (!pq_is_empty(*pq)) {
-    node_t* todel = pq_dequeue(*pq);
-
-    if (todel->data.etype == STR) free(todel->data.value.sval);
-
-    free(todel);
+  for (int i = 0; i < (*pq)->size; i++) {
+    el_clear(&(*pq)->nodes[i].data, NULL);
   }
 
+  free((*pq)->nodes);
   free(*pq);
   *pq = NULL;
 }
@@ -113,31 +167,38 @@ node_t* pq_new_node(etype_t etype, void *val, int priority) {
   node_t *new_node = malloc(sizeof(node_t));
   if (!new_node) return NULL;
 
-  new_node->next = NULL;          // initilize next to NULL
-
-  // update the element with the value
-  switch (etype) {
-    case INT: new_node->data.value.ival = *(int *)val; break;
-
-    case FLO: new_node->data.value.fval = *(float *)val; break;
-
-    case STR: {
-      new_node->data.value.sval = strdup( (char *)val );
-      if (!new_node->data.value.sval) {
-        free(new_node);
-        return NULL;
-      }
-      break;
-    }
-
-    default: {    // invalid value type
-      free(new_node);
-      return NULL;
-    }
+  if (!pq_set_node(new_node, etype, val, priority)) {
+    free(new_node);
+    return NULL;
   }
 
-  new_node->data.etype = etype;  // update the element type
-  new_node->priority = priority;
+  new_node->seq = 0;
   return new_node;
 }
 
+
+
+bool pq_set_node(node_t *node, etype_t etype, void *val, int priority) {
+  if (!node || !val) return false;
+
+  // update the element with the value
+  if (!el_set(&node->data, etype, val, NULL)) return false;
+
+  node->priority = priority;
+  return true;
+}
+
+
+
+bool pq_resize(priority_queue_t *pq) {
+  if (!pq) return false;
+
+  int new_capacity = pq->capacity * 2;
+
+  node_t *new_memory = realloc(pq->nodes, new_capacity * sizeof(node_t));
+  if (!new_memory) return false;
+
+  pq->capacity = new_capacity;
+  pq->nodes = new_memory;
+  return true;
+}
@@ -6,35 +6,33 @@
 #include <string.h>
 #include <stdbool.h>
 
-/* specify the type of value in the element */
-typedef enum { INT, FLO, STR } etype_t;
+#include "element.h"
 
+#define PQ_INIT_CAPACITY  16     // initial no of nodes the heap can hold
+#define PQ_ARITY          4      // children per heap node
 
-/* struct representation of a element */
-typedef struct {
-  etype_t etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
-
+// Priority queue implementation using an array backed 4-ary min heap
+// node with the lowest priority value is dequeued first
+// nodes with equal priority are dequeued in the order they were enqueued,
+// every node is stamped with an increasing sequence number to break the tie
+//
+// children of node i are at PQ_ARITY * i + 1 ... PQ_ARITY * i + PQ_ARITY
+// parent of node i is at (i - 1) / PQ_ARITY
 
 /* struct representation of a node */
 typedef struct node {
   element_t data;
   int priority;         // priority of a node's value
-  struct node *next;
+  unsigned long seq;    // enqueue order, to keep equal priorities FIFO
 } node_t;
 
 
 /* struct representation of a priority queue */
 typedef struct {
-  int size;          // no of nodes in queue
-  node_t *first;     // values are removed from first
-  node_t *last;      // valuse are added from last
+  int size;            // no of nodes in queue
+  int capacity;        // no of nodes the heap can hold
+  unsigned long seq;   // sequence number for the next enqueued node
+  node_t *nodes;       // heap, nodes[0] is the next to be dequeued
 } priority_queue_t;
 
 
@@ -55,10 +53,10 @@ priority_queue_t* pq_init();
 
 /**
  * @brief Push an value into the queue
- *        This is done by iterating the queue to find the proper position
- *        with correct prirority value and insert it
+ *        value is added at the end of the heap and sifted up to its
+ *        position. heap is doubled when it's full
  * 
- *        time complexity  - O(N)
+ *        time complexity  - O(log N)
  *        space complexity - O(1)
  * 
  * @param priority_queue_t - ref to priority_queue_t struct
@@ -72,15 +70,39 @@ bool pq_enqueue(priority_queue_t *, etype_t, void *, int);
 
 /**
  * @brief Removes the first element and returns it
+ *        the last node takes the root and is sifted down to its position
  * 
- *        time complexity  - O(1)
+ *        time complexity  - O(log N)
  *        space complexity - O(1) 
  * 
  * @param priority_queue_t - ref to priority_queue_t struct
- * @return node_t* 
+ * @return node_t* - copy of the node, caller has to free the memory
  */
 node_t* pq_dequeue(priority_queue_t *);
 
+/**
+ * @brief Removes the first element and copies it to the given node,
+ *        without any memory allocation
+ * 
+ *        time complexity  - O(log N)
+ *        space complexity - O(1) 
+ * 
+ * @param priority_queue_t - ref to priority_queue_t struct
+ * @param node_t* - node to copy the removed value into
+ * @return true 
+ * @return false - queue is empty
+ */
+bool pq_dequeue_into(priority_queue_t *, node_t *);
+
+/**
+ * @brief Returns the first element without removing it
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1) 
+ * 
+ * @param priority_queue_t - ref to priority_queue_t struct
+ * @return node_t* - valid till the queue is modified next
+ */
 node_t* pq_peek(priority_queue_t *);
 
 bool pq_is_empty(priority_queue_t *);
@@ -93,4 +115,28 @@ void pq_free(priority_queue_t **);
 
 node_t* pq_new_node(etype_t, void *, int);
 
+/**
+ * @brief Update the node with the value and priority
+ * 
+ * @param node_t* - node to update
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param void * - void pointer to value, will be typecasted based on enum type
+ * @param int - priority value
+ * @return true 
+ * @return false - invalid type or string allocation failed
+ */
+bool pq_set_node(node_t *, etype_t, void *, int);
+
+/**
+ * @brief Double the capacity of the heap
+ * 
+ *        time complexity  - O(N)
+ *        space complexity - O(N)
+ * 
+ * @param priority_queue_t - ref to priority_queue_t struct
+ * @return true 
+ * @return false 
+ */
+bool pq_resize(priority_queue_t *);
+
 #endif   // __PRIORITY_QUEUE_HEADER__
\ No newline at end of file
@@ -81,8 +81,75 @@ void test_priority_queue() {
     printf("All tests passed!\n");
 }
 
+// Equal priorities must come out in the order they went in
+void test_fifo_ties() {
+    priority_queue_t *pq = pq_init();
+
+    for (int i = 0; i < 100; i++) {
+        assert(pq_enqueue(pq, INT, &i, i % 3) == true);
+    }
+
+    node_t node;
+    int last_priority = -1, last_value = -1;
+
+    while (pq_dequeue_into(pq, &node)) {
+        if (node.priority == last_priority) {
+            assert(node.data.value.ival > last_value);
+        } else {
+            assert(node.priority > last_priority);
+        }
+
+        last_priority = node.priority;
+        last_value = node.data.value.ival;
+    }
+
+    assert(pq_is_empty(pq) == true);
+    pq_free(&pq);
+    printf("Test 15: Equal priorities dequeued in FIFO order\n");
+}
+
+// Random priorities past the initial capacity, interleaved with dequeues
+void test_heap_order() {
+    priority_queue_t *pq = pq_init();
+    char *words[] = {"low", "mid", "high"};
+
+    for (int i = 0; i < 10000; i++) {
+        int priority = rand() % 1000;
+        assert(pq_enqueue(pq, STR, words[i % 3], priority) == true);
+
+        // every few enqueues, take one out
+        if (i % 4 == 3) {
+            node_t *n = pq_dequeue(pq);
+            assert(n != NULL);
+            sstr_free(&n->data.value.sval);
+            free(n);
+        }
+    }
+    assert(pq_size(pq) == 10000 - 2500);
+
+    node_t prev, curr;
+    assert(pq_dequeue_into(pq, &prev) == true);
+    sstr_free(&prev.data.value.sval);
+
+    while (pq_dequeue_into(pq, &curr)) {
+        assert(prev.priority < curr.priority ||
+               (prev.priority == curr.priority && prev.seq < curr.seq));
+        sstr_free(&curr.data.value.sval);
+        prev = curr;
+    }
+
+    // free with values still in the queue
+    int val = 1;
+    pq_enqueue(pq, STR, "left over", 5);
+    pq_enqueue(pq, INT, &val, 2);
+    pq_free(&pq);
+    printf("Test 16: Heap order kept across resizes\n");
+}
+
 int main() {
     test_priority_queue();
+    test_fifo_ties();
+    test_heap_order();
     return 0;
 }
 
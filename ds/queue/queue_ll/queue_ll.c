@@ -1,7 +1,16 @@
 #include "queue_ll.h"
 
 
+static node_t* qll_make_node(pool_t *, intern_t *, etype_t, void *);
+
+
 queue_ll_t* qll_init() {
+  return qll_init_pool(NULL);
+}
+
+
+
+queue_ll_t* qll_init_pool(pool_t *pool) {
   queue_ll_t *qll = malloc(sizeof(queue_ll_t));
   if (!qll) return NULL;
 
@@ -9,16 +18,27 @@ queue_ll_t* qll_init() {
   qll->size = 0;
   qll->first = NULL;
   qll->last = NULL;
+  qll->pool = pool;
+  qll->intern = NULL;
   return qll;
 }
 
 
 
+bool qll_use_intern(queue_ll_t *qll, intern_t *intern) {
+  if (!qll || !qll_is_empty(qll)) return false;
+
+  qll->intern = intern;
+  return true;
+}
+
+
+
 bool qll_enqueue(queue_ll_t *qll, etype_t etype, void *val) {
   if (!qll || !val) return false;
 
   // create a node and update it with the value
-  node_t *new_node = qll_new_node(etype, val);
+  node_t *new_node = qll_make_node(qll->pool, qll->intern, etype, val);
   if (!new_node) return false;
 
   // the queue is empty
@@ -78,11 +98,8 @@ void qll_free(queue_ll_t **qll) {
   if (!qll || !*qll) return;
 
   while (!qll_is_empty(*qll)) {
-    node_t *todel = qll_dequeue(*qll);
-    
-    if (todel->data.etype == STR) free(todel->data.value.sval);
-
-    free(todel);
+    // string data is released with the node
+    qll_recycle_node(*qll, qll_dequeue(*qll));
   }
 
   // finally free the queue_ll_t struct and make it as NULL
@@ -93,42 +110,34 @@ void qll_free(queue_ll_t **qll) {
 
 /* ---------- UTIL FUNCTIONS ---------- */
 
-node_t* qll_new_node(etype_t etype, void *val) {
+/* allocate the node from the pool (malloc, if there is no pool), a long
+   string is interned if there is a table */
+static node_t* qll_make_node(pool_t *pool, intern_t *intern, etype_t etype, void *val) {
   if (!val) return NULL;
 
   // allocate memory for a Node
-  node_t *new_node = malloc(sizeof(node_t));
+  node_t *new_node = pool_get(pool, sizeof(node_t));
   if (!new_node) return NULL;
 
   new_node->next = NULL;          // initilize next to NULL
 
   // update the element with the value
-  switch (etype) {
-    case INT: new_node->data.value.ival = *(int *)val; break;
-
-    case FLO: new_node->data.value.fval = *(float *)val; break;
-
-    case STR: {
-      new_node->data.value.sval = strdup( (char *)val );
-      if (!new_node->data.value.sval) {
-        free(new_node);
-        return NULL;
-      }
-      break;
-    }
-
-    default: {    // invalid value type
-      free(new_node);
-      return NULL;
-    }
+  if (!el_set(&new_node->data, etype, val, intern)) {
+    // invalid value type or out of memory
+    pool_put(pool, new_node);
+    return NULL;
   }
-
-  new_node->data.etype = etype;  // update the element type
   return new_node;
 }
 
 
 
+node_t* qll_new_node(etype_t etype, void *val) {
+  return qll_make_node(NULL, NULL, etype, val);
+}
+
+
+
 void qll_print(queue_ll_t *qll) {
   if (!qll || qll_is_empty(qll)) {
     puts("[]");
@@ -138,15 +147,23 @@ void qll_print(queue_ll_t *qll) {
   printf("\n[");
   node_t *curr = qll->first;
   while (curr) {
-    switch(curr->data.etype) {
-      case INT: printf("%d", curr->data.value.ival); break;
-      case FLO: printf("%f", curr->data.value.fval); break;
-      case STR: printf("\"%s\"", curr->data.value.sval); break;
-    }
+    el_print(&curr->data);
 
     curr = curr->next;
     if (curr) printf(", ");
   }
 
   printf("]\n");
-}
\ No newline at end of file
+}
+
+
+
+void qll_recycle_node(queue_ll_t *qll, node_t *n) {
+  if (!n) return;
+
+  // release the value (a string is freed)
+  el_clear(&n->data, qll ? qll->intern : NULL);
+
+  // give the node back to the allocator it came from
+  pool_put(qll ? qll->pool : NULL, n);
+}
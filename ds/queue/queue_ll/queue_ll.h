@@ -5,6 +5,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+
+#include "pool.h"
+#include "element.h"
 #include <stdbool.h>
 
 
@@ -14,22 +17,6 @@
 // values are added at the last(rear) and removed from the first(front)
 
 
-/* specify the type of value in the element */
-typedef enum { INT, FLO, STR } etype_t;
-
-
-/* struct representation of a element */
-typedef struct {
-  etype_t etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
-
-
 /* struct representation of a node */
 typedef struct node {
   element_t data;
@@ -42,6 +29,8 @@ typedef struct {
   int size;          // no of nodes in queue
   node_t *first;     // values are removed from first
   node_t *last;      // valuse are added from last
+  pool_t *pool;      // allocator for the nodes, NULL to use malloc
+  intern_t *intern;   // table of the long strings, NULL if not interned
 } queue_ll_t;
 
 
@@ -61,6 +50,33 @@ typedef struct {
  */
 queue_ll_t* qll_init();
 
+/**
+ * @brief Same as qll_init, but the nodes are allocated from the pool.
+ *        pool can be shared by many queues, and must outlive them
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param pool_t* - pool of sizeof(node_t) slots, NULL to use malloc
+ * @return queue_ll_t* 
+ */
+queue_ll_t* qll_init_pool(pool_t *);
+
+/**
+ * @brief Share the long strings of the queue through an intern table (see
+ *        intern.h), equal strings are stored once. the table has to
+ *        outlive the queue. only for an empty queue
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param queue_ll_t* - pointer to queue_ll_t struct
+ * @param intern_t* - intern table, can be shared by many structures
+ * @return true
+ * @return false - queue is not empty
+ */
+bool qll_use_intern(queue_ll_t *, intern_t *);
+
 /**
  * @brief Push an value into the last of the queue
  * 
@@ -82,7 +98,7 @@ bool qll_enqueue(queue_ll_t *, etype_t, void *);
  *        space complexity - O(1) 
  * 
  * @param queue_ll_t - ref to queue_ll_t struct
- * @return node_t* 
+ * @return node_t* - release it with qll_recycle_node
  */
 node_t* qll_dequeue(queue_ll_t *);
 
@@ -159,5 +175,16 @@ void qll_print(queue_ll_t *);
  */
 node_t* qll_new_node(etype_t, void *);
 
+/**
+ * @brief Free a node of the queue, back to the allocator it came from
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param queue_ll_t* - ref to queue_ll_t struct the node came from
+ * @param node_t* - pointer to node_t struct
+ */
+void qll_recycle_node(queue_ll_t *, node_t *);
+
 
 #endif   // __QUEUE_LINKED_LIST_HEADER__
\ No newline at end of file
@@ -22,8 +22,8 @@ void test_qll_enqueue() {
   char *str_value = "Hello";
   assert(qll_enqueue(queue, STR, str_value) == true);
   assert(queue->size == 2);
-  assert(queue->last->data.value.sval != NULL);
-  assert(strcmp(queue->last->data.value.sval, "Hello") == 0);
+  assert(sstr_len(&queue->last->data.value.sval) == 5);
+  assert(strcmp(sstr_cstr(&queue->last->data.value.sval), "Hello") == 0);
 
   qll_free(&queue);
 }
@@ -117,6 +117,54 @@ void test_qll_print() {
   qll_free(&queue);
 }
 
+// queues sharing a pool, dequeued nodes go back to the pool
+void test_qll_pool() {
+  pool_t *pool = pool_init(sizeof(node_t), 0);
+  queue_ll_t *a = qll_init_pool(pool);
+  queue_ll_t *b = qll_init_pool(pool);
+
+  for (int i = 0; i < 100; i++) {
+    assert(qll_enqueue(a, INT, &i) == true);
+    assert(qll_enqueue(b, STR, "node") == true);
+  }
+  assert(pool_in_use(pool) == 200);
+
+  for (int i = 0; i < 50; i++) {
+    node_t *node = qll_dequeue(a);
+    assert(node->data.value.ival == i);
+    qll_recycle_node(a, node);
+  }
+  assert(pool_in_use(pool) == 150);
+
+  // freed slots are reused, the pool doesn't grow
+  int capacity = pool->capacity;
+  for (int i = 0; i < 50; i++) qll_enqueue(a, INT, &i);
+  assert(pool->capacity == capacity);
+
+  qll_free(&a);
+  qll_free(&b);
+  assert(pool_in_use(pool) == 0);
+  pool_destroy(pool);
+}
+
+void test_qll_intern() {
+  intern_t *tab = intern_init(0);
+  queue_ll_t *queue = qll_init();
+  assert(qll_use_intern(queue, tab) == true);
+
+  for (int i = 0; i < 100; i++)
+    assert(qll_enqueue(queue, STR, i % 2 ? "an order from the web shop" : "an order from the app") == true);
+  assert(intern_count(tab) == 2);
+
+  node_t *node = qll_dequeue(queue);
+  assert(strcmp(sstr_cstr(&node->data.value.sval), "an order from the app") == 0);
+  qll_recycle_node(queue, node);
+
+  qll_free(&queue);
+  assert(intern_count(tab) == 0);
+  intern_destroy(tab);
+}
+
 void run_tests() {
   test_qll_init();
   test_qll_enqueue();
@@ -126,6 +174,8 @@ void run_tests() {
   test_qll_size();
   test_qll_free();
   test_qll_print();
+  test_qll_pool();
+  test_qll_intern();
 
   printf("All tests passed!\n");
 }
@@ -0,0 +1,188 @@
+#include "spsc_queue.h"
+
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+/*
+  Two thread benchmark of the spsc ring, a producer and a consumer thread.
+  usage :- bench_spsc_queue [no of elements]     ; default is 1e7
+
+  single    :- spsc_enqueue / spsc_dequeue, one element a call
+  batch_N   :- spsc_enqueue_batch / spsc_dequeue_batch, N elements a call
+  ping-pong :- one element sent over a queue and echoed back on another,
+               round trip latency (p50 / p99 / max) in ns
+
+  the spin loops yield the cpu when the queue is full / empty, so the
+  benchmark still makes progress with both the threads on one core (the
+  numbers from such a run measure the scheduler, not the queue)
+*/
+
+#define BENCH_RING    1024
+#define BENCH_ROUNDS  100000
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+typedef struct {
+  spsc_queue_t *q;
+  spsc_queue_t *back;   // reply queue, for the ping-pong
+  long n;
+  int batch;            // 0 for the single element calls
+} bench_arg_t;
+
+
+
+static void* produce(void *p) {
+  bench_arg_t *arg = p;
+  element_t buf[256];
+
+  if (!arg->batch) {
+    for (long i = 0; i < arg->n; i++) {
+      int v = (int)i;
+      while (!spsc_enqueue(arg->q, INT, &v)) sched_yield();
+    }
+    return NULL;
+  }
+
+  for (long i = 0; i < arg->n; ) {
+    int n = arg->n - i < arg->batch ? (int)(arg->n - i) : arg->batch;
+    for (int k = 0; k < n; k++) {
+      buf[k].etype = INT;
+      buf[k].value.ival = (int)(i + k);
+    }
+
+    // push the whole batch, a part at a time if the ring is near full
+    for (int done = 0; done < n; ) {
+      int moved = spsc_enqueue_batch(arg->q, buf + done, n - done);
+      if (!moved) sched_yield();
+      done += moved;
+    }
+    i += n;
+  }
+  return NULL;
+}
+
+
+
+/* consume n elements on the calling thread, returns the sum of the values */
+static long long consume(bench_arg_t *arg) {
+  element_t buf[256];
+  long long sum = 0;
+
+  for (long i = 0; i < arg->n; ) {
+    if (!arg->batch) {
+      element_t e;
+      if (!spsc_dequeue(arg->q, &e)) { sched_yield(); continue; }
+      sum += e.value.ival;
+      i++;
+      continue;
+    }
+
+    int n = spsc_dequeue_batch(arg->q, buf, arg->batch);
+    if (!n) { sched_yield(); continue; }
+    for (int k = 0; k < n; k++) sum += buf[k].value.ival;
+    i += n;
+  }
+  return sum;
+}
+
+
+
+static long long bench_throughput(const char *name, long n, int batch) {
+  spsc_queue_t *q = spsc_init(BENCH_RING);
+  if (!q) return 0;
+
+  bench_arg_t arg = { q, NULL, n, batch };
+  pthread_t t;
+
+  double start = now_sec();
+  if (pthread_create(&t, NULL, produce, &arg) != 0) return 0;
+  long long sum = consume(&arg);
+  pthread_join(t, NULL);
+  double elapsed = now_sec() - start;
+
+  printf("%-10s %12ld %10.2f %12.2f\n", name, n, elapsed * 1e9 / n, n / elapsed / 1e6);
+  spsc_free(&q);
+  return sum;
+}
+
+
+
+/* echo every element of q back on the reply queue */
+static void* echo(void *p) {
+  bench_arg_t *arg = p;
+  element_t e;
+
+  for (long i = 0; i < arg->n; i++) {
+    while (!spsc_dequeue(arg->q, &e)) sched_yield();
+    while (!spsc_enqueue(arg->back, INT, &e.value.ival)) sched_yield();
+  }
+  return NULL;
+}
+
+
+
+static int cmp_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+
+
+static long long bench_latency(long rounds) {
+  spsc_queue_t *ping = spsc_init(BENCH_RING), *pong = spsc_init(BENCH_RING);
+  double *rtt = malloc(rounds * sizeof(double));
+  if (!ping || !pong || !rtt) return 0;
+
+  bench_arg_t arg = { ping, pong, rounds, 0 };
+  pthread_t t;
+  if (pthread_create(&t, NULL, echo, &arg) != 0) return 0;
+
+  long long sum = 0;
+  element_t e;
+  for (long i = 0; i < rounds; i++) {
+    int v = (int)i;
+    double start = now_sec();
+
+    while (!spsc_enqueue(ping, INT, &v)) sched_yield();
+    while (!spsc_dequeue(pong, &e)) sched_yield();
+
+    rtt[i] = (now_sec() - start) * 1e9;
+    sum += e.value.ival;
+  }
+  pthread_join(t, NULL);
+
+  qsort(rtt, rounds, sizeof(double), cmp_double);
+  printf("\n%-10s %12s %10s %10s %10s\n", "latency", "rounds", "p50 ns", "p99 ns", "max ns");
+  printf("%-10s %12ld %10.0f %10.0f %10.0f\n", "ping-pong", rounds,
+         rtt[rounds / 2], rtt[rounds * 99 / 100], rtt[rounds - 1]);
+
+  free(rtt);
+  spsc_free(&ping);
+  spsc_free(&pong);
+  return sum;
+}
+
+
+
+int main(int argc, char *argv[]) {
+  long n = argc > 1 ? atol(argv[1]) : 10000000;
+  if (n <= 0 || n > 0x7fffffff) return 1;
+
+  printf("%-10s %12s %10s %12s\n", "calls", "elements", "ns/elem", "Melem/s");
+
+  long long sum = 0;
+  sum += bench_throughput("single", n, 0);
+  sum += bench_throughput("batch_16", n, 16);
+  sum += bench_throughput("batch_256", n, 256);
+  sum += bench_latency(BENCH_ROUNDS);
+
+  printf("checksum %lld\n", sum);
+  return 0;
+}
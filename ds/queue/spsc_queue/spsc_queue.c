@@ -0,0 +1,185 @@
+#include "spsc_queue.h"
+
+#define SPSC_MAX_CAPACITY (1 << 30)
+
+
+spsc_queue_t* spsc_init(int capacity) {
+  if (capacity <= 0 || capacity > SPSC_MAX_CAPACITY) return NULL;
+
+  size_t cap = 1;
+  while (cap < (size_t)capacity) cap *= 2;
+
+  // the struct is cache line aligned, so the two sides don't share a line
+  spsc_queue_t *q = aligned_alloc(SPSC_CACHE_LINE, sizeof(spsc_queue_t));
+  if (!q) return NULL;
+
+  q->slots = malloc(cap * sizeof(element_t));
+  if (!q->slots) {
+    free(q);
+    return NULL;
+  }
+
+  atomic_init(&q->tail, 0);
+  atomic_init(&q->head, 0);
+  q->head_cache = 0;
+  q->tail_cache = 0;
+  q->mask = cap - 1;
+  return q;
+}
+
+
+
+/* free slots for the producer, the shared head is read only when the
+   cached one doesn't give the room needed */
+static inline size_t spsc_room(spsc_queue_t *q, size_t tail, size_t need) {
+  size_t cap = q->mask + 1;
+  size_t room = cap - (tail - q->head_cache);
+
+  if (room < need) {
+    q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+    room = cap - (tail - q->head_cache);
+  }
+  return room;
+}
+
+
+
+/* filled slots for the consumer, the shared tail is read only when the
+   cached one doesn't give the elements needed */
+static inline size_t spsc_filled(spsc_queue_t *q, size_t head, size_t need) {
+  size_t filled = q->tail_cache - head;
+
+  if (filled < need) {
+    q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+    filled = q->tail_cache - head;
+  }
+  return filled;
+}
+
+
+
+bool spsc_enqueue(spsc_queue_t *q, etype_t etype, void *val) {
+  if (!q) return false;
+
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  if (spsc_room(q, tail, 1) == 0) return false;
+
+  // the slot is not visible to the consumer till the tail is published
+  if (!el_set(&q->slots[tail & q->mask], etype, val, NULL)) return false;
+
+  atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+  return true;
+}
+
+
+
+bool spsc_dequeue(spsc_queue_t *q, element_t *out) {
+  if (!q || !out) return false;
+
+  size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  if (spsc_filled(q, head, 1) == 0) return false;
+
+  *out = q->slots[head & q->mask];
+
+  // the slot can be reused by the producer after this
+  atomic_store_explicit(&q->head, head + 1, memory_order_release);
+  return true;
+}
+
+
+
+int spsc_enqueue_batch(spsc_queue_t *q, const element_t *src, int n) {
+  if (!q || !src || n <= 0) return 0;
+
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  size_t room = spsc_room(q, tail, (size_t)n);
+  if ((size_t)n > room) n = (int)room;
+
+  // copy in (upto) two runs, the end of the ring and its start
+  size_t idx = tail & q->mask;
+  size_t first = q->mask + 1 - idx;
+  if (first > (size_t)n) first = n;
+
+  memcpy(q->slots + idx, src, first * sizeof(element_t));
+  memcpy(q->slots, src + first, (n - first) * sizeof(element_t));
+
+  // one publish for the whole batch
+  atomic_store_explicit(&q->tail, tail + n, memory_order_release);
+  return n;
+}
+
+
+
+int spsc_dequeue_batch(spsc_queue_t *q, element_t *dst, int n) {
+  if (!q || !dst || n <= 0) return 0;
+
+  size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  size_t filled = spsc_filled(q, head, (size_t)n);
+  if ((size_t)n > filled) n = (int)filled;
+
+  // copy out (upto) two runs, the end of the ring and its start
+  size_t idx = head & q->mask;
+  size_t first = q->mask + 1 - idx;
+  if (first > (size_t)n) first = n;
+
+  memcpy(dst, q->slots + idx, first * sizeof(element_t));
+  memcpy(dst + first, q->slots, (n - first) * sizeof(element_t));
+
+  // one release for the whole batch
+  atomic_store_explicit(&q->head, head + n, memory_order_release);
+  return n;
+}
+
+
+
+const element_t* spsc_peek(spsc_queue_t *q) {
+  if (!q) return NULL;
+
+  size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  if (spsc_filled(q, head, 1) == 0) return NULL;
+
+  return &q->slots[head & q->mask];
+}
+
+
+
+bool spsc_is_empty(spsc_queue_t *q) {
+  return spsc_size(q) == 0;
+}
+
+
+
+bool spsc_is_full(spsc_queue_t *q) {
+  return q && spsc_size(q) == spsc_capacity(q);
+}
+
+
+
+int spsc_size(spsc_queue_t *q) {
+  if (!q) return 0;
+
+  // head first, so the size never reads below 0
+  size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+  return (int)(tail - head);
+}
+
+
+
+int spsc_capacity(spsc_queue_t *q) {
+  return q ? (int)(q->mask + 1) : 0;
+}
+
+
+
+void spsc_free(spsc_queue_t **q) {
+  if (!q || !*q) return;
+
+  // release the strings of the elements left in the queue
+  element_t e;
+  while (spsc_dequeue(*q, &e)) el_clear(&e, NULL);
+
+  free((*q)->slots);
+  free(*q);
+  *q = NULL;
+}
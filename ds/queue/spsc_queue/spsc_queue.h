@@ -0,0 +1,212 @@
+#ifndef __QUEUE_SPSC_HEADER__
+#define __QUEUE_SPSC_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#include "element.h"
+
+#define SPSC_CACHE_LINE  64     // head, tail & the ring are kept on their own lines
+
+/*
+Some Design Notes:
+- single producer / single consumer ring, the circular queue (cqueue_t)
+  made safe for exactly two threads :- one thread only enqueues, the other
+  only dequeues. every call finishes in a bounded no of steps (wait-free),
+  no locks and no CAS
+
+- capacity is given at init and rounded upto a power of 2, so a slot is
+  (counter & mask). head / tail are free running counters, the queue is
+  empty when head == tail and full when tail - head == capacity (no slot is
+  sacrificed, unlike cqueue_t)
+
+- the producer owns tail, the consumer owns head. the slot is written
+  before tail is published with a release store, and read after the tail
+  is seen with an acquire load (and the other way for head), so the
+  element is visible before its index
+
+- head and tail are on separate cache lines, so the two threads don't
+  bounce one line between them. each side also keeps a cached copy of the
+  other side's counter, and reads the shared one only when the cached copy
+  says full / empty
+
+- the elements are stored in the ring by value (no malloc per element). a
+  string is copied by the producer, and owned by the consumer after the
+  dequeue (el_clear it)
+
+- the batch calls move many elements with one publish, the cost of the
+  atomics is paid once per batch
+
+usage :-
+  spsc_queue_t *q = spsc_init(1024);
+
+  // producer thread                 // consumer thread
+  spsc_enqueue(q, INT, &val);         element_t e;
+                                      if (spsc_dequeue(q, &e)) { ...; el_clear(&e, NULL); }
+  ...
+  spsc_free(&q);                      // after both the threads are done
+*/
+
+
+/* struct representation of the spsc queue */
+typedef struct {
+  // producer side
+  _Alignas(SPSC_CACHE_LINE) atomic_size_t tail;   // next slot to write
+  size_t head_cache;                              // head, as last seen by the producer
+
+  // consumer side
+  _Alignas(SPSC_CACHE_LINE) atomic_size_t head;   // next slot to read
+  size_t tail_cache;                              // tail, as last seen by the consumer
+
+  // read only after init
+  _Alignas(SPSC_CACHE_LINE) size_t mask;          // capacity - 1
+  element_t *slots;
+} spsc_queue_t;
+
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Allocate the queue with room for atleast the given no of elements
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(C); C - capacity
+ *
+ * @param int - capacity, rounded upto a power of 2 (> 0)
+ * @return spsc_queue_t* - NULL, if the capacity is invalid or out of memory
+ */
+spsc_queue_t* spsc_init(int);
+
+/**
+ * @brief Push a value into the last of the queue. producer thread only
+ *
+ *        time complexity  - O(1)
+ *                           O(N); if etype is str, N - length of string
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to spsc_queue_t struct
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param void * - void pointer to value, will be typecasted based on enum type
+ * @return true
+ * @return false - queue is full, invalid type or out of memory
+ */
+bool spsc_enqueue(spsc_queue_t *, etype_t, void *);
+
+/**
+ * @brief Removes the first element into the given element. consumer thread only
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to spsc_queue_t struct
+ * @param element_t - ref to element_t, takes the element (and its string)
+ * @return true
+ * @return false - queue is empty
+ */
+bool spsc_dequeue(spsc_queue_t *, element_t *);
+
+/**
+ * @brief Push upto n elements, in order. the pushed elements (and their
+ *        strings) are owned by the queue. producer thread only
+ *
+ *        time complexity  - O(N); N - no of elements
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to spsc_queue_t struct
+ * @param const element_t * - array of elements
+ * @param int - no of elements in the array
+ * @return int - no of elements pushed, from the start of the array (less
+ *               than n, if the queue got full)
+ */
+int spsc_enqueue_batch(spsc_queue_t *, const element_t *, int);
+
+/**
+ * @brief Remove upto n elements, in order. consumer thread only
+ *
+ *        time complexity  - O(N); N - no of elements
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to spsc_queue_t struct
+ * @param element_t * - array for the elements, owned by the caller after
+ * @param int - size of the array
+ * @return int - no of elements removed
+ */
+int spsc_dequeue_batch(spsc_queue_t *, element_t *, int);
+
+/**
+ * @brief Take a peek at the first element in queue. consumer thread only
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to spsc_queue_t struct
+ * @return const element_t* - NULL, if the queue is empty
+ */
+const element_t* spsc_peek(spsc_queue_t *);
+
+/**
+ * @brief Verify if the queue is empty. exact only on the consumer thread
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to spsc_queue_t struct
+ * @return true
+ * @return false
+ */
+bool spsc_is_empty(spsc_queue_t *);
+
+/**
+ * @brief Verify if the queue is full. exact only on the producer thread
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to spsc_queue_t struct
+ * @return true
+ * @return false
+ */
+bool spsc_is_full(spsc_queue_t *);
+
+/**
+ * @brief No of elements in the queue, a snapshot if the other thread is
+ *        running
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to spsc_queue_t struct
+ * @return int
+ */
+int spsc_size(spsc_queue_t *);
+
+/**
+ * @brief Capacity of the queue (a power of 2)
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to spsc_queue_t struct
+ * @return int
+ */
+int spsc_capacity(spsc_queue_t *);
+
+/**
+ * @brief Release the memory of entire queue, and the elements left in it.
+ *        no thread may be using the queue
+ *
+ *        time complexity  - O(N); N - no of elements in queue
+ *        space complexity - O(1)
+ *
+ * @param spsc_queue_t - ref to ref to spsc_queue_t struct
+ */
+void spsc_free(spsc_queue_t **);
+
+#endif   // __QUEUE_SPSC_HEADER__
@@ -0,0 +1,185 @@
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "spsc_queue.h"
+
+// Function prototypes for test cases
+void test_spsc_init();
+void test_spsc_enqueue_dequeue();
+void test_spsc_full();
+void test_spsc_wraparound();
+void test_spsc_batch();
+void test_spsc_string();
+void test_spsc_threads();
+
+int main() {
+  test_spsc_init();
+  test_spsc_enqueue_dequeue();
+  test_spsc_full();
+  test_spsc_wraparound();
+  test_spsc_batch();
+  test_spsc_string();
+  test_spsc_threads();
+
+  printf("\n*** All tests passed!***\n");
+  return 0;
+}
+
+void test_spsc_init() {
+  spsc_queue_t *q = spsc_init(5);
+  assert(q != NULL);
+  assert(spsc_capacity(q) == 8);
+  assert(spsc_is_empty(q) && !spsc_is_full(q));
+  assert(spsc_peek(q) == NULL);
+  spsc_free(&q);
+  assert(q == NULL);
+
+  assert(spsc_init(0) == NULL);
+  assert(spsc_init(-1) == NULL);
+}
+
+void test_spsc_enqueue_dequeue() {
+  spsc_queue_t *q = spsc_init(4);
+  element_t e;
+
+  int a = 10, b = 20;
+  float f = 1.5f;
+  assert(spsc_enqueue(q, INT, &a));
+  assert(spsc_enqueue(q, INT, &b));
+  assert(spsc_enqueue(q, FLO, &f));
+  assert(spsc_size(q) == 3);
+  assert(spsc_peek(q)->value.ival == 10);
+
+  assert(spsc_dequeue(q, &e) && e.etype == INT && e.value.ival == 10);
+  assert(spsc_dequeue(q, &e) && e.etype == INT && e.value.ival == 20);
+  assert(spsc_dequeue(q, &e) && e.etype == FLO && e.value.fval == 1.5f);
+  assert(!spsc_dequeue(q, &e));
+  assert(spsc_is_empty(q));
+
+  spsc_free(&q);
+}
+
+void test_spsc_full() {
+  spsc_queue_t *q = spsc_init(4);
+
+  // every slot is usable, none is kept empty
+  for (int i = 0; i < 4; i++) assert(spsc_enqueue(q, INT, &i));
+  assert(spsc_is_full(q) && spsc_size(q) == 4);
+
+  int extra = 99;
+  assert(!spsc_enqueue(q, INT, &extra));
+
+  element_t e;
+  assert(spsc_dequeue(q, &e) && e.value.ival == 0);
+  assert(spsc_enqueue(q, INT, &extra));
+  assert(spsc_is_full(q));
+
+  spsc_free(&q);
+}
+
+void test_spsc_wraparound() {
+  spsc_queue_t *q = spsc_init(4);
+  element_t e;
+  int next_in = 0, next_out = 0;
+
+  // the counters run many times around the ring
+  for (int round = 0; round < 100; round++) {
+    for (int i = 0; i < 3; i++, next_in++) assert(spsc_enqueue(q, INT, &next_in));
+    for (int i = 0; i < 3; i++, next_out++) {
+      assert(spsc_dequeue(q, &e));
+      assert(e.value.ival == next_out);
+    }
+  }
+  assert(spsc_is_empty(q));
+
+  spsc_free(&q);
+}
+
+void test_spsc_batch() {
+  spsc_queue_t *q = spsc_init(8);
+  element_t in[10], out[10];
+
+  for (int i = 0; i < 10; i++) {
+    int v = i * 3;
+    el_set(&in[i], INT, &v, NULL);
+  }
+
+  // only the room left is taken
+  assert(spsc_enqueue_batch(q, in, 10) == 8);
+  assert(spsc_enqueue_batch(q, in, 1) == 0);
+
+  assert(spsc_dequeue_batch(q, out, 5) == 5);
+  for (int i = 0; i < 5; i++) assert(out[i].value.ival == i * 3);
+
+  // this batch wraps around the end of the ring
+  assert(spsc_enqueue_batch(q, in + 8, 2) == 2);
+  assert(spsc_dequeue_batch(q, out, 10) == 5);
+  for (int i = 0; i < 5; i++) assert(out[i].value.ival == (i + 5) * 3);
+  assert(spsc_dequeue_batch(q, out, 10) == 0);
+
+  spsc_free(&q);
+}
+
+void test_spsc_string() {
+  spsc_queue_t *q = spsc_init(4);
+  element_t e;
+
+  char *s = "hello";
+  char *l = "a string longer than the inline small string";
+  assert(spsc_enqueue(q, STR, s));
+  assert(spsc_enqueue(q, STR, l));
+
+  assert(spsc_dequeue(q, &e) && e.etype == STR);
+  element_t key;
+  assert(el_key(&key, STR, s, NULL) && el_match(&e, &key, NULL));
+  el_clear(&e, NULL);
+
+  // the one left is released by spsc_free
+  spsc_free(&q);
+}
+
+
+#define SPSC_TEST_N  200000
+
+static void* producer(void *arg) {
+  spsc_queue_t *q = arg;
+
+  for (int i = 0; i < SPSC_TEST_N; i++) {
+    while (!spsc_enqueue(q, INT, &i)) sched_yield();
+  }
+  return NULL;
+}
+
+void test_spsc_threads() {
+  // a small ring, so both the full and the empty paths are taken
+  spsc_queue_t *q = spsc_init(64);
+  pthread_t t;
+  int rc = pthread_create(&t, NULL, producer, q);
+  assert(rc == 0);
+  (void)rc;
+
+  element_t batch[16];
+  long long sum = 0;
+  int next = 0;
+
+  while (next < SPSC_TEST_N) {
+    int n = spsc_dequeue_batch(q, batch, 16);
+    if (n == 0) {
+      sched_yield();
+      continue;
+    }
+
+    // in order, none lost or repeated
+    for (int i = 0; i < n; i++, next++) {
+      assert(batch[i].etype == INT && batch[i].value.ival == next);
+      sum += batch[i].value.ival;
+    }
+  }
+
+  pthread_join(t, NULL);
+  assert(spsc_is_empty(q));
+  assert(sum == (long long)SPSC_TEST_N * (SPSC_TEST_N - 1) / 2);
+
+  spsc_free(&q);
+}
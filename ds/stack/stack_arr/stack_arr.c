@@ -61,12 +61,8 @@ void sa_free(stack_arr_t **sa) {
   if (!*sa) return;
 
   while (!sa_is_empty(*sa)) {
-    element_t *e = sa_pop(*sa);
-
-    // if the element has STR, then release the memory of it first
-    if (e->etype == STR) free(e->value.sval);
-
-    free(e);
+    // release the element, with the memory of its STR value
+    el_free(sa_pop(*sa));
   }
 
   // finally free the stack_arr_t struct
@@ -79,36 +75,8 @@ void sa_free(stack_arr_t **sa) {
 /* ---------- UTIL FUNCTIONS ---------- */
 
 element_t* sa_new_element(etype_t etype, void *val) {
-  element_t *new_element = malloc(sizeof(element_t));
-  if (!new_element) return NULL;
-
-  switch (etype) {
-    case INT:
-      // typecast void pointer to int pointer (int *) and then de-reference *
-      new_element->value.ival = *(int *)val;
-      break;
-
-    case FLO: 
-      new_element->value.fval = *(float *)val; 
-      break;
-
-    case STR: {
-      new_element->value.sval = strdup( (char *)val );
-      if (!new_element->value.sval) {
-        free(new_element);
-        return NULL;
-      }
-      break;
-    }
-
-    default:
-      // if we reach here, then invalid etype is passed in
-      // release the memory of new node and return
-      free(new_element);
-      return NULL;
-  }
-  new_element->etype = etype;  // update the value type
-  return new_element;
+  // allocate memory for new element_t, updated with the value
+  return el_new(etype, val);
 }
 
 
@@ -120,11 +88,7 @@ void sa_print(stack_arr_t *sa) {
   for (int i = sa->top; i >= 0; i--) {
     element_t *e = sa->data[sa->top];
 
-    switch(e->etype) {
-      case INT: printf("%d", e->value.ival); break;
-      case FLO: printf("%f", e->value.fval); break;
-      case STR: printf("\"%s\"", e->value.sval); break;
-    }
+    el_print(e);
 
     if (i != 0) printf(", ");
   }
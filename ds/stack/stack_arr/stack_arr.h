@@ -6,6 +6,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "element.h"
+
 #define SIZE  1000
 
 /**
@@ -22,22 +24,6 @@
  */
 
 
-/* specify the type of value in the element */
-typedef enum { INT, FLO, STR } etype_t;
-
-
-/* struct representation of a element */
-typedef struct {
-  etype_t etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
-
-
 /* struct representation of a stack */
 typedef struct {
   int top;                    // points to index of stack top
@@ -41,7 +41,7 @@ void test_stack() {
   // Test peeking
   element_t *top_element = sa_peek(stack);
   if (top_element && top_element->etype == STR) {
-      printf("Peeked top element: %s\n", top_element->value.sval);
+      printf("Peeked top element: %s\n", sstr_cstr(&top_element->value.sval));
   } else {
       printf("Failed to peek top element.\n");
   }
@@ -57,8 +57,8 @@ void test_stack() {
               printf("Popped float: %f\n", popped_element->value.fval);
               break;
           case STR:
-              printf("Popped string: %s\n", popped_element->value.sval);
-              free(popped_element->value.sval); // Free string memory
+              printf("Popped string: %s\n", sstr_cstr(&popped_element->value.sval));
+              sstr_free(&popped_element->value.sval); // Free string memory
               break;
       }
       free(popped_element); // Free the element itself
@@ -1,13 +1,23 @@
 #include "stack_ll.h"
 
 
+static node_t* sll_make_node(pool_t *, etype_t, void *);
+
+
 stack_ll_t* sll_init() {
+  return sll_init_pool(NULL);
+}
+
+
+
+stack_ll_t* sll_init_pool(pool_t *pool) {
   stack_ll_t *sll = malloc(sizeof(stack_ll_t));
   if (!sll) return NULL;
 
   // set the initializer values
   sll->size = 0;
   sll->top = NULL;
+  sll->pool = pool;
   return sll;
 }
 
@@ -17,7 +27,7 @@ bool sll_push(stack_ll_t *sll, etype_t etype, void *val) {
   if (!sll || !val) return false;
 
   // let's create a new node and update it with the value
-  node_t *new_node = sll_new_node(etype, val);
+  node_t *new_node = sll_make_node(sll->pool, etype, val);
   if (!new_node) return false;
 
   new_node->next = sll->top;  // update new first node's next ref to old first node
@@ -35,7 +45,7 @@ node_t* sll_pop(stack_ll_t *sll) {
   sll->top = pop_node->next;     // update the top with the next element in the list
   sll->size--;                   // finally decrement the node count
 
-  return pop_node;   // caller must release the memory of the node
+  return pop_node;   // caller must release the node with sll_recycle_node
 }
 
 
@@ -57,12 +67,8 @@ void sll_free(stack_ll_t **sll) {
   if (!sll || !*sll) return;
 
   while (!sll_is_empty(*sll)) {
-    node_t *todel = sll_pop(*sll);
-
-    // for string data, release memory explicitly
-    if (todel->data.etype == STR) free(todel->data.value.sval);
-
-    free(todel);
+    // string data is released with the node
+    sll_recycle_node(*sll, sll_pop(*sll));
   }
 
   // finallly release the stack 
@@ -74,43 +80,34 @@ void sll_free(stack_ll_t **sll) {
 /* ---------- UTIL FUNCTIONS ---------- */
 
 
-node_t* sll_new_node(etype_t etype, void *val) {
+/* allocate the node from the pool (malloc, if there is no pool) */
+static node_t* sll_make_node(pool_t *pool, etype_t etype, void *val) {
   if (!val) return NULL;
 
   // allocate memory for a Node
-  node_t *new_node = malloc(sizeof(node_t));
+  node_t *new_node = pool_get(pool, sizeof(node_t));
   if (!new_node) return NULL;
 
   new_node->next = NULL;          // initilize next to NULL
 
   // update the element with the value
-  switch (etype) {
-    case INT: new_node->data.value.ival = *(int *)val; break;
-
-    case FLO: new_node->data.value.fval = *(float *)val; break;
-
-    case STR: {
-      new_node->data.value.sval = strdup( (char *)val );
-      if (!new_node->data.value.sval) {
-        free(new_node);
-        return NULL;
-      }
-      break;
-    }
-
-    default: {    // invalid value type
-      free(new_node);
-      return NULL;
-    }
+  if (!el_set(&new_node->data, etype, val, NULL)) {
+    // invalid value type or out of memory
+    pool_put(pool, new_node);
+    return NULL;
   }
 
-  new_node->data.etype = etype;  // update the element type
-
   return new_node;
 }
 
 
 
+node_t* sll_new_node(etype_t etype, void *val) {
+  return sll_make_node(NULL, etype, val);
+}
+
+
+
 void sll_print(stack_ll_t *sll) {
   if (!sll || sll_is_empty(sll)) {
     puts("[]");
@@ -120,15 +117,23 @@ void sll_print(stack_ll_t *sll) {
   printf("\n[");
   node_t *curr = sll->top;
   while (curr) {
-    switch(curr->data.etype) {
-      case INT: printf("%d", curr->data.value.ival); break;
-      case FLO: printf("%f", curr->data.value.fval); break;
-      case STR: printf("\"%s\"", curr->data.value.sval); break;
-    }
+    el_print(&curr->data);
 
     curr = curr->next;
     if (curr) printf(", ");
   }
 
   printf("]\n");
-}
\ No newline at end of file
+}
+
+
+
+void sll_recycle_node(stack_ll_t *sll, node_t *n) {
+  if (!n) return;
+
+  // release the value (a string is freed)
+  el_clear(&n->data, NULL);
+
+  // give the node back to the allocator it came from
+  pool_put(sll ? sll->pool : NULL, n);
+}
@@ -6,21 +6,8 @@
 #include <stdlib.h>
 #include <string.h>
 
-
-/* specify the type of value in the element */
-typedef enum { INT, FLO, STR } etype_t;
-
-
-/* struct representation of a element */
-typedef struct {
-  etype_t etype;
-
-  union {
-    int ival;
-    float fval;
-    char *sval;
-  } value;
-} element_t;
+#include "pool.h"
+#include "element.h"
 
 
 /* struct representation of a node */
@@ -34,6 +21,7 @@ typedef struct node {
 typedef struct {
   int size;       // no of nodes in the stack
   node_t *top;    // head of the linked list, act as the top
+  pool_t *pool;   // allocator for the nodes, NULL to use malloc
 } stack_ll_t;
 
 
@@ -52,6 +40,18 @@ typedef struct {
  */
 stack_ll_t* sll_init();
 
+/**
+ * @brief Same as sll_init, but the nodes are allocated from the pool.
+ *        pool can be shared by many stacks, and must outlive them
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param pool_t* - pool of sizeof(node_t) slots, NULL to use malloc
+ * @return stack_ll_t* 
+ */
+stack_ll_t* sll_init_pool(pool_t *);
+
 /**
  * @brief Push an value into the top of the stack.
  *        here head node is considered at the top of the stack
@@ -75,7 +75,7 @@ bool sll_push(stack_ll_t *, etype_t, void *);
  *        space complexity - O(1) 
  * 
  * @param stack_ll_t - ref to stack_ll_t struct
- * @return node_t* 
+ * @return node_t* - release it with sll_recycle_node
  */
 node_t* sll_pop(stack_ll_t *);
 
@@ -141,4 +141,15 @@ void sll_print(stack_ll_t *);
  */
 node_t* sll_new_node(etype_t, void *);
 
+/**
+ * @brief Free a node of the stack, back to the allocator it came from
+ * 
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ * 
+ * @param stack_ll_t* - ref to stack_ll_t struct the node came from
+ * @param node_t* - pointer to node_t struct
+ */
+void sll_recycle_node(stack_ll_t *, node_t *);
+
 #endif   // __STACK_LINKED_LIST_HEADER__
\ No newline at end of file
@@ -30,7 +30,7 @@ void test_sll_push() {
     assert(sll_push(stack, STR, val3) == true);
     assert(stack->size == 3);
     assert(stack->top->data.etype == STR);
-    assert(strcmp(stack->top->data.value.sval, "Hello") == 0);
+    assert(strcmp(sstr_cstr(&stack->top->data.value.sval), "Hello") == 0);
 
     sll_free(&stack);
 }
@@ -49,8 +49,8 @@ void test_sll_pop() {
   node_t *popped_node = sll_pop(stack);
   assert(popped_node != NULL);
   assert(popped_node->data.etype == STR);
-  assert(strcmp(popped_node->data.value.sval, "Hello") == 0);
-  free(popped_node->data.value.sval);
+  assert(strcmp(sstr_cstr(&popped_node->data.value.sval), "Hello") == 0);
+  sstr_free(&popped_node->data.value.sval);
   free(popped_node);
 
   assert(stack->size == 2);
@@ -145,6 +145,23 @@ void test_sll_print() {
   sll_free(&stack);
 }
 
+// Function to test a stack on the pool allocator
+void test_sll_pool() {
+    pool_t *pool = pool_init(sizeof(node_t), 4);
+    stack_ll_t *stack = sll_init_pool(pool);
+
+    for (int i = 0; i < 100; i++) assert(sll_push(stack, INT, &i) == true);
+    assert(pool_in_use(pool) == 100);
+
+    node_t *node = sll_pop(stack);
+    assert(node->data.value.ival == 99);
+    sll_recycle_node(stack, node);
+
+    sll_free(&stack);
+    assert(pool_in_use(pool) == 0);
+    pool_destroy(pool);
+}
+
 // Main function to run all tests
 int main() {
   test_sll_init();
@@ -154,6 +171,7 @@ int main() {
   test_sll_is_empty();
   test_sll_free();
   test_sll_print();
+  test_sll_pool();
 
   printf("All tests passed successfully!\n");
   return 0;
@@ -0,0 +1,148 @@
+#include "treiber_stack.h"
+#include "stack_ll.h"
+
+#include <time.h>
+#include <pthread.h>
+
+/*
+  Scaling of the lock-free stack (treiber_stack_t) against the linked list
+  stack (stack_ll_t) behind one pthread mutex. every thread does pairs of
+  push and pop on a near empty stack, the worst case for the CAS on top
+  and the best case for the elimination array.
+  usage :- bench_treiber_stack [no of pairs] [max threads]  ; default is 1e6 and 64
+
+  threads   :- 1 2 4 ... upto max threads
+  ns/pair   :- wall time per push + pop
+  Mpair/s   :- pairs per second, by all the threads together
+
+  with more threads than cores, a thread can be preempted holding the
+  mutex (or while its node is in a slot), the numbers from such a run
+  measure the scheduler more than the stack
+*/
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+
+/* stack_ll_t made shareable the usual way, a lock around every call */
+typedef struct {
+  pthread_mutex_t lock;
+  stack_ll_t *sll;
+} locked_sll_t;
+
+
+
+typedef struct {
+  treiber_stack_t *s;
+  locked_sll_t *ls;
+  long n;                 // no of pairs this thread does
+  long long sum;
+} bench_arg_t;
+
+
+
+static void* ts_pairs(void *p) {
+  bench_arg_t *arg = p;
+  element_t e;
+
+  for (long i = 0; i < arg->n; i++) {
+    int v = (int)i;
+    ts_push(arg->s, INT, &v);
+    if (ts_pop(arg->s, &e)) arg->sum += e.value.ival;
+  }
+  return NULL;
+}
+
+
+
+static void* sll_pairs(void *p) {
+  bench_arg_t *arg = p;
+  locked_sll_t *ls = arg->ls;
+
+  for (long i = 0; i < arg->n; i++) {
+    int v = (int)i;
+    pthread_mutex_lock(&ls->lock);
+    sll_push(ls->sll, INT, &v);
+    pthread_mutex_unlock(&ls->lock);
+
+    pthread_mutex_lock(&ls->lock);
+    node_t *node = sll_pop(ls->sll);
+    if (node) {
+      arg->sum += node->data.value.ival;
+      sll_recycle_node(ls->sll, node);
+    }
+    pthread_mutex_unlock(&ls->lock);
+  }
+  return NULL;
+}
+
+
+
+/* run the threads, each doing n / threads pairs */
+static long long run(const char *name, void *(*body)(void *),
+                     treiber_stack_t *s, locked_sll_t *ls, long n, int threads) {
+  pthread_t *tids = malloc(threads * sizeof(pthread_t));
+  bench_arg_t *args = malloc(threads * sizeof(bench_arg_t));
+  if (!tids || !args) return 0;
+
+  long per_thread = n / threads;
+  double start = now_sec();
+
+  for (int i = 0; i < threads; i++) {
+    args[i] = (bench_arg_t){ s, ls, per_thread, 0 };
+    pthread_create(&tids[i], NULL, body, &args[i]);
+  }
+
+  long long sum = 0;
+  for (int i = 0; i < threads; i++) {
+    pthread_join(tids[i], NULL);
+    sum += args[i].sum;
+  }
+
+  double elapsed = now_sec() - start;
+  long pairs = per_thread * threads;
+  printf("%-10s %8d %12ld %10.2f %10.2f\n", name, threads, pairs,
+         elapsed * 1e9 / pairs, pairs / elapsed / 1e6);
+
+  free(tids);
+  free(args);
+  return sum;
+}
+
+
+
+int main(int argc, char *argv[]) {
+  long n = argc > 1 ? atol(argv[1]) : 1000000;
+  int max_threads = argc > 2 ? atoi(argv[2]) : 64;
+  if (n <= 0 || n > 0x7fffffff || max_threads < 1) return 1;
+
+  printf("%-10s %8s %12s %10s %10s\n", "stack", "threads", "pairs", "ns/pair", "Mpair/s");
+
+  long long sum = 0;
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    // a shared pool for each stack's nodes
+    pool_t *tpool = pool_init_shared(sizeof(ts_node_t), 0);
+    pool_t *spool = pool_init_shared(sizeof(node_t), 0);
+
+    treiber_stack_t *s = ts_init_pool(tpool);
+    locked_sll_t ls;
+    ls.sll = sll_init_pool(spool);
+    if (!s || !ls.sll || pthread_mutex_init(&ls.lock, NULL) != 0) return 1;
+
+    sum += run("treiber", ts_pairs, s, NULL, n, threads);
+    sum += run("sll+mutex", sll_pairs, NULL, &ls, n, threads);
+
+    pthread_mutex_destroy(&ls.lock);
+    sll_free(&ls.sll);
+    ts_free(&s);
+    pool_destroy(tpool);
+    pool_destroy(spool);
+  }
+
+  printf("checksum %lld\n", sum);
+  return 0;
+}
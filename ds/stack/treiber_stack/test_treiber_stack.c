@@ -0,0 +1,196 @@
+#include "treiber_stack.h"
+#include "stress.h"
+
+// Function prototypes for test cases
+void test_ts_init();
+void test_ts_push_pop();
+void test_ts_string();
+void test_ts_tag();
+void test_ts_reuse();
+void test_ts_stress();
+void test_ts_pairs();
+
+int main() {
+  test_ts_init();
+  test_ts_push_pop();
+  test_ts_string();
+  test_ts_tag();
+  test_ts_reuse();
+  test_ts_stress();
+  test_ts_pairs();
+
+  printf("\n*** All tests passed!***\n");
+  return 0;
+}
+
+void test_ts_init() {
+  treiber_stack_t *s = ts_init();
+  assert(s != NULL);
+  assert(s->top.node == NULL && s->top.tag == 0);
+  assert(ts_is_empty(s));
+  ts_free(&s);
+  assert(s == NULL);
+}
+
+void test_ts_push_pop() {
+  treiber_stack_t *s = ts_init();
+  element_t e;
+
+  assert(!ts_pop(s, &e));
+
+  int a = 10, b = 20;
+  float f = 1.5f;
+  assert(ts_push(s, INT, &a));
+  assert(ts_push(s, INT, &b));
+  assert(ts_push(s, FLO, &f));
+  assert(!ts_is_empty(s));
+
+  // last in, first out
+  assert(ts_pop(s, &e) && e.etype == FLO && e.value.fval == 1.5f);
+  assert(ts_pop(s, &e) && e.etype == INT && e.value.ival == 20);
+  assert(ts_pop(s, &e) && e.etype == INT && e.value.ival == 10);
+  assert(!ts_pop(s, &e));
+  assert(ts_is_empty(s));
+
+  ts_free(&s);
+}
+
+void test_ts_string() {
+  treiber_stack_t *s = ts_init();
+  element_t e, key;
+
+  char *str = "hello";
+  char *l = "a string longer than the inline small string";
+  assert(ts_push(s, STR, l));
+  assert(ts_push(s, STR, str));
+
+  assert(ts_pop(s, &e) && e.etype == STR);
+  assert(el_key(&key, STR, str, NULL) && el_match(&e, &key, NULL));
+  el_clear(&e, NULL);
+
+  // the one left is released by ts_free
+  ts_free(&s);
+}
+
+void test_ts_tag() {
+  treiber_stack_t *s = ts_init();
+  element_t e;
+  int a = 1, b = 2;
+
+  assert(ts_push(s, INT, &a));
+  assert(ts_push(s, INT, &b));
+
+  // pop B and push again, B's node comes back from the free list
+  ts_top_t stale = s->top;
+  assert(ts_pop(s, &e) && e.value.ival == 2);
+  assert(ts_push(s, INT, &a));
+
+  // same node on top, but a pop holding the stale top would fail its CAS
+  assert(s->top.node == stale.node);
+  assert(s->top.tag != stale.tag);
+
+  ts_free(&s);
+}
+
+void test_ts_reuse() {
+  pool_t *pool = pool_init_shared(sizeof(ts_node_t), 0);
+  treiber_stack_t *s = ts_init_pool(pool);
+  element_t e;
+
+  // the popped nodes are reused, no new node after the first round
+  for (int i = 0; i < 10; i++) assert(ts_push(s, INT, &i));
+  for (int i = 0; i < 10; i++) assert(ts_pop(s, &e));
+  assert(pool_in_use(pool) == 10);
+
+  for (int i = 0; i < 10; i++) assert(ts_push(s, INT, &i));
+  assert(pool_in_use(pool) == 10);
+
+  ts_free(&s);
+  assert(pool_in_use(pool) == 0);
+  pool_destroy(pool);
+}
+
+
+static bool stress_put(void *s, int v) {
+  return ts_push(s, INT, &v);
+}
+
+static bool stress_take(void *s, int *v) {
+  element_t e;
+  if (!ts_pop(s, &e)) return false;
+
+  assert(e.etype == INT);
+  *v = e.value.ival;
+  return true;
+}
+
+void test_ts_stress() {
+  pool_t *pool = pool_init_shared(sizeof(ts_node_t), 0);
+  treiber_stack_t *s = ts_init_pool(pool);
+  assert(s);
+
+  // lifo, the values of a producer don't come out in order
+  stress_t st = { .shared = s, .put = stress_put, .take = stress_take,
+                  .producers = 4, .consumers = 4, .per_thread = 50000, .fifo = false };
+  stress_run(&st);
+  assert(ts_is_empty(s));
+
+  // no node is leaked, the free list included
+  ts_free(&s);
+  assert(pool_in_use(pool) == 0);
+  pool_destroy(pool);
+}
+
+
+#define PAIRS_THREADS  8
+#define PAIRS_ROUNDS   50000
+
+typedef struct {
+  treiber_stack_t *s;
+  int id;
+  long long pushed, popped;
+} pairs_arg_t;
+
+static void* pairs_worker(void *p) {
+  pairs_arg_t *arg = p;
+  element_t e;
+
+  // push / pop pairs on a near empty stack, the CAS on top is contended
+  // and the pops take the nodes from the elimination array too
+  for (int i = 0; i < PAIRS_ROUNDS; i++) {
+    int v = arg->id * PAIRS_ROUNDS + i;
+    assert(ts_push(arg->s, INT, &v));
+    arg->pushed += v;
+
+    // our own push is in, so a pop can't find the stack empty
+    assert(ts_pop(arg->s, &e));
+    arg->popped += e.value.ival;
+  }
+  return NULL;
+}
+
+void test_ts_pairs() {
+  treiber_stack_t *s = ts_init();
+  pthread_t threads[PAIRS_THREADS];
+  pairs_arg_t args[PAIRS_THREADS];
+
+  for (int i = 0; i < PAIRS_THREADS; i++) {
+    args[i] = (pairs_arg_t){ s, i, 0, 0 };
+    int rc = pthread_create(&threads[i], NULL, pairs_worker, &args[i]);
+    assert(rc == 0);
+    (void)rc;
+  }
+
+  long long pushed = 0, popped = 0;
+  for (int i = 0; i < PAIRS_THREADS; i++) {
+    pthread_join(threads[i], NULL);
+    pushed += args[i].pushed;
+    popped += args[i].popped;
+  }
+
+  // the values popped are the values pushed
+  assert(pushed == popped);
+  assert(ts_is_empty(s));
+
+  ts_free(&s);
+}
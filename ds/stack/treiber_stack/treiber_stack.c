@@ -0,0 +1,228 @@
+#include "treiber_stack.h"
+
+#ifndef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+#error "treiber_stack needs a double width CAS, build with -mcx16 on x86-64"
+#endif
+
+/* result of one attempt on a tagged top */
+typedef enum { TS_DONE, TS_LOST, TS_EMPTY } ts_try_t;
+
+/* marks a slot whose node was taken by a pop */
+static ts_node_t ts_taken;
+#define TS_TAKEN  (&ts_taken)
+
+
+static ts_top_t ts_load(ts_top_t *);
+static bool ts_cas(ts_top_t *, ts_top_t, ts_node_t *);
+static ts_try_t ts_try_push(ts_top_t *, ts_node_t *);
+static ts_try_t ts_try_pop(ts_top_t *, ts_node_t **);
+static bool ts_elim_push(treiber_stack_t *, ts_node_t *);
+static ts_node_t* ts_elim_pop(treiber_stack_t *);
+static ts_node_t* ts_alloc_node(treiber_stack_t *);
+static void ts_recycle_node(treiber_stack_t *, ts_node_t *);
+
+
+treiber_stack_t* ts_init() {
+  return ts_init_pool(NULL);
+}
+
+
+
+treiber_stack_t* ts_init_pool(pool_t *pool) {
+  // the struct is cache line aligned, so top and the slots don't share a line
+  treiber_stack_t *s = aligned_alloc(TS_CACHE_LINE, sizeof(treiber_stack_t));
+  if (!s) return NULL;
+
+  s->top.node = NULL;
+  s->top.tag = 0;
+  s->free.node = NULL;
+  s->free.tag = 0;
+  for (int i = 0; i < TS_ELIM_SLOTS; i++) atomic_init(&s->elim[i].node, NULL);
+  s->pool = pool;
+  return s;
+}
+
+
+
+bool ts_push(treiber_stack_t *s, etype_t etype, void *val) {
+  if (!s || !val) return false;
+
+  ts_node_t *node = ts_alloc_node(s);
+  if (!node) return false;
+
+  if (!el_set(&node->data, etype, val, NULL)) {
+    ts_recycle_node(s, node);
+    return false;
+  }
+
+  // on a lost CAS, try to hand the node straight to a pop
+  while (ts_try_push(&s->top, node) == TS_LOST) {
+    if (ts_elim_push(s, node)) break;
+  }
+  return true;
+}
+
+
+
+bool ts_pop(treiber_stack_t *s, element_t *out) {
+  if (!s || !out) return false;
+
+  ts_node_t *node;
+  for (;;) {
+    ts_try_t res = ts_try_pop(&s->top, &node);
+    if (res == TS_EMPTY) return false;
+    if (res == TS_DONE) break;
+
+    // lost the CAS, try to take a node offered by a push
+    if ((node = ts_elim_pop(s))) break;
+  }
+
+  // the node is ours now, its value (and string) goes to the caller
+  *out = node->data;
+  ts_recycle_node(s, node);
+  return true;
+}
+
+
+
+bool ts_is_empty(treiber_stack_t *s) {
+  return !s || ts_load(&s->top).node == NULL;
+}
+
+
+
+void ts_free(treiber_stack_t **s) {
+  if (!s || !*s) return;
+
+  // the nodes on the stack own their values, the free ones don't
+  ts_node_t *curr = (*s)->top.node, *next;
+  for (; curr; curr = next) {
+    next = atomic_load(&curr->next);
+    el_clear(&curr->data, NULL);
+    pool_put((*s)->pool, curr);
+  }
+
+  for (curr = (*s)->free.node; curr; curr = next) {
+    next = atomic_load(&curr->next);
+    pool_put((*s)->pool, curr);
+  }
+
+  free(*s);
+  *s = NULL;
+}
+
+
+/* ---------- UTIL FUNCTIONS ---------- */
+
+/* read a tagged top, two 8 byte loads. the tag is read first, a node from a
+   later change comes with a newer tag, so a torn pair fails its CAS */
+static ts_top_t ts_load(ts_top_t *top) {
+  ts_top_t t;
+  t.tag = __atomic_load_n(&top->tag, __ATOMIC_ACQUIRE);
+  t.node = __atomic_load_n(&top->node, __ATOMIC_ACQUIRE);
+  return t;
+}
+
+
+
+/* swap the top to node if it is still old, bumping the tag */
+static bool ts_cas(ts_top_t *top, ts_top_t old, ts_node_t *node) {
+  ts_top_t next;
+  next.node = node;
+  next.tag = old.tag + 1;
+
+  // double width CAS, a full barrier
+  return __sync_bool_compare_and_swap(&top->raw, old.raw, next.raw);
+}
+
+
+
+static ts_try_t ts_try_push(ts_top_t *top, ts_node_t *node) {
+  ts_top_t old = ts_load(top);
+  atomic_store_explicit(&node->next, old.node, memory_order_relaxed);
+
+  return ts_cas(top, old, node) ? TS_DONE : TS_LOST;
+}
+
+
+
+static ts_try_t ts_try_pop(ts_top_t *top, ts_node_t **out) {
+  ts_top_t old = ts_load(top);
+  if (!old.node) return TS_EMPTY;
+
+  // old.node may be popped and reused meanwhile, then the tag has moved on
+  ts_node_t *next = atomic_load_explicit(&old.node->next, memory_order_relaxed);
+  if (!ts_cas(top, old, next)) return TS_LOST;
+
+  *out = old.node;
+  return TS_DONE;
+}
+
+
+
+/* per thread xorshift, picks the elimination slot */
+static unsigned ts_rand() {
+  static _Thread_local unsigned seed = 0;
+
+  // the address of the thread's seed makes the threads start apart
+  if (!seed) seed = (unsigned)(uintptr_t)&seed | 1;
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+
+
+/* offer the node in a random slot for a while, true if a pop took it */
+static bool ts_elim_push(treiber_stack_t *s, ts_node_t *node) {
+  ts_slot_t *slot = &s->elim[ts_rand() % TS_ELIM_SLOTS];
+
+  ts_node_t *expected = NULL;
+  if (!atomic_compare_exchange_strong(&slot->node, &expected, node)) return false;
+
+  for (int i = 0; i < TS_ELIM_SPINS; i++) {
+    if (atomic_load_explicit(&slot->node, memory_order_acquire) == TS_TAKEN) break;
+  }
+
+  // withdraw the offer, fails only if a pop took the node meanwhile
+  expected = node;
+  if (atomic_compare_exchange_strong(&slot->node, &expected, NULL)) return false;
+
+  // taken, free the slot for the next offer
+  atomic_store_explicit(&slot->node, NULL, memory_order_release);
+  return true;
+}
+
+
+
+/* take a node offered in a random slot, NULL if there is none */
+static ts_node_t* ts_elim_pop(treiber_stack_t *s) {
+  ts_slot_t *slot = &s->elim[ts_rand() % TS_ELIM_SLOTS];
+
+  ts_node_t *node = atomic_load_explicit(&slot->node, memory_order_acquire);
+  if (!node || node == TS_TAKEN) return NULL;
+
+  if (!atomic_compare_exchange_strong(&slot->node, &node, TS_TAKEN)) return NULL;
+  return node;
+}
+
+
+
+/* a node from the free list, or a new one if it is empty */
+static ts_node_t* ts_alloc_node(treiber_stack_t *s) {
+  ts_node_t *node;
+  ts_try_t res;
+
+  while ((res = ts_try_pop(&s->free, &node)) == TS_LOST);
+  if (res == TS_DONE) return node;
+
+  return pool_get(s->pool, sizeof(ts_node_t));
+}
+
+
+
+/* back onto the free list, a thread may still read its next */
+static void ts_recycle_node(treiber_stack_t *s, ts_node_t *node) {
+  while (ts_try_push(&s->free, node) == TS_LOST);
+}
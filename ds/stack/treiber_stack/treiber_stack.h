@@ -0,0 +1,167 @@
+#ifndef __STACK_TREIBER_HEADER__
+#define __STACK_TREIBER_HEADER__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "pool.h"
+#include "element.h"
+
+#define TS_CACHE_LINE   64     // top, the free list & every slot are on their own lines
+#define TS_ELIM_SLOTS   16     // slots of the elimination array
+#define TS_ELIM_SPINS   256    // no of checks a push waits in a slot for a pop
+
+/*
+Some Design Notes:
+- lock-free stack (Treiber), the linked list stack (stack_ll_t) shared by
+  any no of threads :- push links the new node to the top and swings top
+  to it with a CAS, pop swings top to top->next with a CAS
+
+- ABA :- a pop reads top = A and A->next = B, meanwhile A is popped, B
+  popped, and A pushed back. a plain CAS (top == A) would succeed and put
+  the freed B on top. so top is a (node, tag) pair and every change bumps
+  the tag, the pair is swapped with one double width CAS (cmpxchg16b on
+  x86-64, built with -mcx16). a stale pop sees the tag has moved and retries
+
+- a popped node may still be read (its next) by a thread that lost the
+  race, so it can't go back to malloc. the nodes are kept on a second
+  tagged stack (the free list) and reused by the next push, they are
+  released only by ts_free. the memory of the stack is its peak size
+
+- under contention, a thread whose CAS failed tries the elimination array
+  before it retries :- a push offers its node in a random slot and waits
+  a bit, a pop that finds a node in a slot takes it. the push / pop pair
+  cancel out without touching top, so contention spreads over the slots
+  instead of one line (Hendler, Shavit & Yerushalmi)
+
+- no size is kept, a shared counter would be one more contended line
+
+- nodes can come from a shared pool (pool_init_shared) the first time,
+  after that they are recycled through the free list
+
+usage :-
+  treiber_stack_t *s = ts_init();
+
+  // any thread                      // any thread
+  ts_push(s, INT, &val);              element_t e;
+                                      if (ts_pop(s, &e)) { ...; el_clear(&e, NULL); }
+  ...
+  ts_free(&s);                        // after all the threads are done
+*/
+
+
+/* struct representation of a node */
+typedef struct ts_node {
+  element_t data;
+  _Atomic(struct ts_node *) next;
+} ts_node_t;
+
+
+/* top of a stack, the node and its change count, swapped as one */
+typedef union {
+  struct {
+    ts_node_t *node;
+    uintptr_t tag;
+  };
+  unsigned __int128 raw;
+} ts_top_t;
+
+
+/* slot of the elimination array, NULL / an offered node / taken */
+typedef struct {
+  _Alignas(TS_CACHE_LINE) _Atomic(ts_node_t *) node;
+} ts_slot_t;
+
+
+/* struct representation of the stack */
+typedef struct {
+  _Alignas(TS_CACHE_LINE) ts_top_t top;     // top of the stack
+  _Alignas(TS_CACHE_LINE) ts_top_t free;    // popped nodes, reused by the push
+
+  ts_slot_t elim[TS_ELIM_SLOTS];            // elimination array
+  pool_t *pool;                             // allocator for the nodes, NULL to use malloc
+} treiber_stack_t;
+
+
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+/* ---------- FUNCTION PROTOTYPES ---------- */
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/**
+ * @brief Allocate memory for the stack and initialize it as empty
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @return treiber_stack_t*
+ */
+treiber_stack_t* ts_init();
+
+/**
+ * @brief Same as ts_init, but the new nodes are allocated from the pool
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param pool_t* - pool from pool_init_shared, of sizeof(ts_node_t) slots
+ * @return treiber_stack_t*
+ */
+treiber_stack_t* ts_init_pool(pool_t *);
+
+/**
+ * @brief Push a value into the top of the stack. any thread
+ *
+ *        time complexity  - O(1), retried on a lost CAS
+ *                           O(N); if etype is str, N - length of string
+ *        space complexity - O(1)
+ *
+ * @param treiber_stack_t - ref to treiber_stack_t struct
+ * @param etype_t - element type enum (allowed INT, FLO, STR)
+ * @param void * - void pointer to value, will be typecasted based on enum type
+ * @return true
+ * @return false - invalid type or out of memory
+ */
+bool ts_push(treiber_stack_t *, etype_t, void *);
+
+/**
+ * @brief Pops the top element into the given element. any thread
+ *
+ *        time complexity  - O(1), retried on a lost CAS
+ *        space complexity - O(1)
+ *
+ * @param treiber_stack_t - ref to treiber_stack_t struct
+ * @param element_t - ref to element_t, takes the element (and its string)
+ * @return true
+ * @return false - stack is empty
+ */
+bool ts_pop(treiber_stack_t *, element_t *);
+
+/**
+ * @brief Verify if the stack is empty, a snapshot if other threads are running
+ *
+ *        time complexity  - O(1)
+ *        space complexity - O(1)
+ *
+ * @param treiber_stack_t - ref to treiber_stack_t struct
+ * @return true
+ * @return false
+ */
+bool ts_is_empty(treiber_stack_t *);
+
+/**
+ * @brief Release the memory of entire stack, the elements left in it and
+ *        the free list. no thread may be using the stack
+ *
+ *        time complexity  - O(N); N - peak no of elements in stack
+ *        space complexity - O(1)
+ *
+ * @param treiber_stack_t - ref of ref to treiber_stack_t struct
+ */
+void ts_free(treiber_stack_t **);
+
+#endif   // __STACK_TREIBER_HEADER__